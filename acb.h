@@ -52,6 +52,12 @@ void acb_clear(acb_t x);
 acb_ptr _acb_vec_init(slong n);
 void _acb_vec_clear(acb_ptr v, slong n);
 
+ACB_INLINE acb_ptr
+acb_arena_vec(arb_arena_t A, slong n)
+{
+    return (acb_ptr) arb_arena_vec(A, 2 * n);
+}
+
 ACB_INLINE arb_ptr acb_real_ptr(acb_t z) { return acb_realref(z); }
 ACB_INLINE arb_ptr acb_imag_ptr(acb_t z) { return acb_imagref(z); }
 
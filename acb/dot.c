@@ -15,85 +15,6 @@
    safe summation of 30-bit error bounds. */
 #include <stdint.h>
 
-/* The following macros are found in FLINT's longlong.h, but
-   the release version is out of date. */
-
-/* x86 : 64 bit */
-#if (GMP_LIMB_BITS == 64 && defined (__amd64__))
-
-#define add_sssaaaaaa2(sh, sm, sl, ah, am, al, bh, bm, bl)  \
-  __asm__ ("addq %8,%q2\n\tadcq %6,%q1\n\tadcq %4,%q0"     \
-       : "=r" (sh), "=&r" (sm), "=&r" (sl)                  \
-       : "0"  ((mp_limb_t)(ah)), "rme" ((mp_limb_t)(bh)),  \
-         "1"  ((mp_limb_t)(am)), "rme" ((mp_limb_t)(bm)),  \
-         "2"  ((mp_limb_t)(al)), "rme" ((mp_limb_t)(bl)))  \
-
-#define sub_dddmmmsss2(dh, dm, dl, mh, mm, ml, sh, sm, sl)  \
-  __asm__ ("subq %8,%q2\n\tsbbq %6,%q1\n\tsbbq %4,%q0"     \
-       : "=r" (dh), "=&r" (dm), "=&r" (dl)                  \
-       : "0"  ((mp_limb_t)(mh)), "rme" ((mp_limb_t)(sh)),  \
-         "1"  ((mp_limb_t)(mm)), "rme" ((mp_limb_t)(sm)),  \
-"2" ((mp_limb_t)(ml)), "rme" ((mp_limb_t)(sl))) \
-
-#endif /* x86_64 */
-
-/* x86 : 32 bit */
-#if (GMP_LIMB_BITS == 32 && (defined (__i386__) \
-   || defined (__i486__) || defined(__amd64__)))
-
-#define add_sssaaaaaa2(sh, sm, sl, ah, am, al, bh, bm, bl)  \
-  __asm__ ("addl %8,%k2\n\tadcl %6,%k1\n\tadcl %4,%k0"     \
-       : "=r" (sh), "=r" (sm), "=&r" (sl)                  \
-       : "0"  ((mp_limb_t)(ah)), "g" ((mp_limb_t)(bh)),    \
-         "1"  ((mp_limb_t)(am)), "g" ((mp_limb_t)(bm)),    \
-         "2"  ((mp_limb_t)(al)), "g" ((mp_limb_t)(bl)))    \
-
-#define sub_dddmmmsss2(dh, dm, dl, mh, mm, ml, sh, sm, sl)  \
-  __asm__ ("subl %8,%k2\n\tsbbl %6,%k1\n\tsbbl %4,%k0"     \
-       : "=r" (dh), "=r" (dm), "=&r" (dl)                  \
-       : "0"  ((mp_limb_t)(mh)), "g" ((mp_limb_t)(sh)),    \
-         "1"  ((mp_limb_t)(mm)), "g" ((mp_limb_t)(sm)),    \
-         "2"  ((mp_limb_t)(ml)), "g" ((mp_limb_t)(sl)))    \
-
-#endif /* x86 */
-
-
-#if !defined(add_sssaaaaaa2)
-
-#define add_sssaaaaaa2(sh, sm, sl, ah, am, al, bh, bm, bl)           \
-  do {                                                              \
-    mp_limb_t __t, __u;                                             \
-    add_ssaaaa(__t, sl, (mp_limb_t) 0, al, (mp_limb_t) 0, bl);      \
-    add_ssaaaa(__u, sm, (mp_limb_t) 0, am, (mp_limb_t) 0, bm);      \
-    add_ssaaaa(sh, sm, ah + bh, sm, __u, __t);                      \
-} while (0)
-
-#define sub_dddmmmsss2(dh, dm, dl, mh, mm, ml, sh, sm, sl)           \
-  do {                                                              \
-    mp_limb_t __t, __u;                                             \
-    sub_ddmmss(__t, dl, (mp_limb_t) 0, ml, (mp_limb_t) 0, sl);      \
-    sub_ddmmss(__u, dm, (mp_limb_t) 0, mm, (mp_limb_t) 0, sm);      \
-    sub_ddmmss(dh, dm, mh - sh, dm, -__u, -__t);                    \
-  } while (0)
-
-#endif
-
-
-/* Add ((a * b) / 2^MAG_BITS) * 2^exp into srad*2^srad_exp.
-   Assumes that srad_exp >= exp and that overflow cannot occur.  */
-#define RAD_ADDMUL(srad, srad_exp, a, b, exp) \
-    do { \
-        uint64_t __a, __b; \
-        slong __shift; \
-        __a = (a); \
-        __b = (b); \
-        __shift = (srad_exp) - (exp); \
-        if (__shift < MAG_BITS) \
-            (srad) += (((__a) * (__b)) >> (MAG_BITS + __shift)) + 1; \
-        else \
-            (srad) += 1; \
-    } while (0)
-
 void mag_set_ui_2exp_small(mag_t z, ulong x, slong e);
 
 static void
@@ -171,6 +92,12 @@ _arb_dot_add_generic(mp_ptr sum, mp_ptr serr, mp_ptr tmp, mp_size_t sn,
     mp_srcptr xptr, mp_size_t xn,
     int negative, flint_bitcnt_t shift);
 
+void
+_arb_dot_sum(mp_ptr sum, mp_limb_t * serr, uint64_t * srad, mp_ptr tmp,
+    mp_size_t sn, slong sum_exp, slong srad_exp, int flipsign,
+    arb_srcptr x, slong xstep, arb_srcptr y, slong ystep, slong len,
+    const char * skip);
+
 static void
 _arb_dot_output(arb_t res, mp_ptr sum, mp_size_t sn, int negative,
     uint64_t serr, slong sum_exp, uint64_t srad, slong srad_exp, slong prec)
@@ -348,7 +275,7 @@ void
 acb_dot(acb_t res, const acb_t initial, int subtract, acb_srcptr x, slong xstep, acb_srcptr y, slong ystep, slong len, slong prec)
 {
     slong i, j, padding, extend;
-    slong xexp, yexp, exp;
+    slong xexp, yexp;
     slong re_nonzero, im_nonzero;
     slong re_max_exp, re_min_exp, re_sum_exp;
     slong im_max_exp, im_min_exp, im_sum_exp;
@@ -356,14 +283,13 @@ acb_dot(acb_t res, const acb_t initial, int subtract, acb_srcptr x, slong xstep,
     slong im_srad_exp, im_max_rad_exp;
     slong re_prec, im_prec;
     slong xrexp, yrexp;
-    int xnegative, ynegative;
-    mp_size_t xn, yn, re_sn, im_sn, alloc;
+    int xnegative;
+    mp_size_t xn, re_sn, im_sn, alloc;
     flint_bitcnt_t shift;
     arb_srcptr xi, yi;
     arf_srcptr xm, ym;
     mag_srcptr xr, yr;
-    mp_limb_t xtop, ytop;
-    mp_limb_t xrad, yrad;
+    mp_limb_t xrad;
     mp_limb_t re_serr, im_serr;   /* Sum over arithmetic errors */
     uint64_t re_srad, im_srad;    /* Sum over propagated errors */
     mp_ptr tmp, re_sum, im_sum;   /* Workspace */
@@ -674,7 +600,7 @@ acb_dot(acb_t res, const acb_t initial, int subtract, acb_srcptr x, slong xstep,
     If any such terms are found, we mask the ith entry in use_gauss
     so that they will be skipped in the main loop.
     Important: the cutoffs must be such that the fast case
-    (xn <= 2, yn <= 2, sn <= 3) is not hit below and the mask
+    (xn <= 2, yn <= 2, sn <= 3) is not hit in _arb_dot_sum and the mask
     check is done.
 
     The cutoffs below are not optimal in the generic case; also, it
@@ -775,217 +701,9 @@ acb_dot(acb_t res, const acb_t initial, int subtract, acb_srcptr x, slong xstep,
             srad = 0;
             flipsign = (xoff + yoff == 2);
 
-            for (i = 0; i < len; i++)
-            {
-                xi = ((arb_srcptr) x) + 2 * i * xstep + xoff;
-                yi = ((arb_srcptr) y) + 2 * i * ystep + yoff;
-
-                xm = arb_midref(xi);
-                ym = arb_midref(yi);
-                xr = arb_radref(xi);
-                yr = arb_radref(yi);
-
-                /* The midpoints of x[i] and y[i] are both nonzero. */
-                if (!arf_is_special(xm) && !arf_is_special(ym))
-                {
-                    xexp = ARF_EXP(xm);
-                    xn = ARF_SIZE(xm);
-                    xnegative = ARF_SGNBIT(xm);
-
-                    yexp = ARF_EXP(ym);
-                    yn = ARF_SIZE(ym);
-                    ynegative = ARF_SGNBIT(ym);
-
-                    exp = xexp + yexp;
-                    shift = sum_exp - exp;
-
-                    if (shift >= sn * FLINT_BITS)
-                    {
-                        /* We may yet need the top limbs for bounds. */
-                        ARF_GET_TOP_LIMB(xtop, xm);
-                        ARF_GET_TOP_LIMB(ytop, ym);
-                        serr++;
-                    }
-                    else if (xn <= 2 && yn <= 2 && sn <= 3)
-                    {
-                        mp_limb_t x1, x0, y1, y0;
-                        mp_limb_t u3, u2, u1, u0;
-
-                        if (xn == 1 && yn == 1)
-                        {
-                            xtop = ARF_NOPTR_D(xm)[0];
-                            ytop = ARF_NOPTR_D(ym)[0];
-                            umul_ppmm(u3, u2, xtop, ytop);
-                            u1 = u0 = 0;
-                        }
-                        else if (xn == 2 && yn == 2)
-                        {
-                            x0 = ARF_NOPTR_D(xm)[0];
-                            x1 = ARF_NOPTR_D(xm)[1];
-                            y0 = ARF_NOPTR_D(ym)[0];
-                            y1 = ARF_NOPTR_D(ym)[1];
-                            xtop = x1;
-                            ytop = y1;
-                            nn_mul_2x2(u3, u2, u1, u0, x1, x0, y1, y0);
-                        }
-                        else if (xn == 1)
-                        {
-                            x0 = ARF_NOPTR_D(xm)[0];
-                            y0 = ARF_NOPTR_D(ym)[0];
-                            y1 = ARF_NOPTR_D(ym)[1];
-                            xtop = x0;
-                            ytop = y1;
-                            nn_mul_2x1(u3, u2, u1, y1, y0, x0);
-                            u0 = 0;
-                        }
-                        else
-                        {
-                            x0 = ARF_NOPTR_D(xm)[0];
-                            x1 = ARF_NOPTR_D(xm)[1];
-                            y0 = ARF_NOPTR_D(ym)[0];
-                            xtop = x1;
-                            ytop = y0;
-                            nn_mul_2x1(u3, u2, u1, x1, x0, y0);
-                            u0 = 0;
-                        }
-
-                        if (sn == 2)
-                        {
-                            if (shift < FLINT_BITS)
-                            {
-                                serr += ((u2 << (FLINT_BITS - shift)) != 0) || (u1 != 0) || (u0 != 0);
-                                u2 = (u2 >> shift) | (u3 << (FLINT_BITS - shift));
-                                u3 = (u3 >> shift);
-                            }
-                            else if (shift == FLINT_BITS)
-                            {
-                                serr += (u2 != 0) || (u1 != 0) || (u0 != 0);
-                                u2 = u3;
-                                u3 = 0;
-                            }
-                            else /* FLINT_BITS < shift < 2 * FLINT_BITS */
-                            {
-                                serr += ((u3 << (2 * FLINT_BITS - shift)) != 0) || (u2 != 0) || (u1 != 0) || (u0 != 0);
-                                u2 = (u3 >> (shift - FLINT_BITS));
-                                u3 = 0;
-                            }
-
-                            if (xnegative ^ ynegative ^ flipsign)
-                                sub_ddmmss(sum[1], sum[0], sum[1], sum[0], u3, u2);
-                            else
-                                add_ssaaaa(sum[1], sum[0], sum[1], sum[0], u3, u2);
-                        }
-                        else if (sn == 3)
-                        {
-                            if (shift < FLINT_BITS)
-                            {
-                                serr += ((u1 << (FLINT_BITS - shift)) != 0) || (u0 != 0);
-                                u1 = (u1 >> shift) | (u2 << (FLINT_BITS - shift));
-                                u2 = (u2 >> shift) | (u3 << (FLINT_BITS - shift));
-                                u3 = (u3 >> shift);
-                            }
-                            else if (shift == FLINT_BITS)
-                            {
-                                serr += (u1 != 0) || (u0 != 0);
-                                u1 = u2;
-                                u2 = u3;
-                                u3 = 0;
-                            }
-                            else if (shift < 2 * FLINT_BITS)
-                            {
-                                serr += ((u2 << (2 * FLINT_BITS - shift)) != 0) || (u1 != 0) || (u0 != 0);
-                                u1 = (u3 << (2 * FLINT_BITS - shift)) | (u2 >> (shift - FLINT_BITS));
-                                u2 = (u3 >> (shift - FLINT_BITS));
-                                u3 = 0;
-                            }
-                            else if (shift == 2 * FLINT_BITS)
-                            {
-                                serr += (u2 != 0) || (u1 != 0) || (u0 != 0);
-                                u1 = u3;
-                                u2 = 0;
-                                u3 = 0;
-                            }
-                            else  /* 2 * FLINT_BITS < shift < 3 * FLINT_BITS */
-                            {
-                                serr += ((u3 << (3 * FLINT_BITS - shift)) != 0) || (u2 != 0) || (u1 != 0) || (u0 != 0);
-                                u1 = (u3 >> (shift - 2 * FLINT_BITS));
-                                u2 = 0;
-                                u3 = 0;
-                            }
-
-                            if (xnegative ^ ynegative ^ flipsign)
-                                sub_dddmmmsss2(sum[2], sum[1], sum[0], sum[2], sum[1], sum[0], u3, u2, u1);
-                            else
-                                add_sssaaaaaa2(sum[2], sum[1], sum[0], sum[2], sum[1], sum[0], u3, u2, u1);
-                        }
-                    }
-                    else
-                    {
-                        mp_srcptr xptr, yptr;
-
-                        xptr = (xn <= ARF_NOPTR_LIMBS) ? ARF_NOPTR_D(xm) : ARF_PTR_D(xm);
-                        yptr = (yn <= ARF_NOPTR_LIMBS) ? ARF_NOPTR_D(ym) : ARF_PTR_D(ym);
-
-                        xtop = xptr[xn - 1];
-                        ytop = yptr[yn - 1];
-
-                        if (use_gauss == NULL || use_gauss[i] == 0)
-                            _arb_dot_addmul_generic(sum, &serr, tmp, sn, xptr, xn, yptr, yn, xnegative ^ ynegative ^ flipsign, shift);
-                    }
-
-                    xrad = MAG_MAN(xr);
-                    yrad = MAG_MAN(yr);
-
-                    if (xrad != 0 && yrad != 0)
-                    {
-                        xrexp = MAG_EXP(xr);
-                        yrexp = MAG_EXP(yr);
-
-                        RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
-                        RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
-                        RAD_ADDMUL(srad, srad_exp, xrad, yrad, xrexp + yrexp);
-                    }
-                    else if (xrad != 0)
-                    {
-                        xrexp = MAG_EXP(xr);
-                        RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
-                    }
-                    else if (yrad != 0)
-                    {
-                        yrexp = MAG_EXP(yr);
-                        RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
-                    }
-                }
-                else
-                {
-                    xrad = MAG_MAN(xr);
-                    yrad = MAG_MAN(yr);
-
-                    xexp = ARF_EXP(xm);
-                    yexp = ARF_EXP(ym);
-
-                    xrexp = MAG_EXP(xr);
-                    yrexp = MAG_EXP(yr);
-
-                    /* (xm+xr)(ym+yr) = xm ym + [xm yr + ym xr + xr yr] */
-                    if (yrad && !arf_is_special(xm))
-                    {
-                        ARF_GET_TOP_LIMB(xtop, xm);
-                        RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
-                    }
-
-                    if (xrad && !arf_is_special(ym))
-                    {
-                        ARF_GET_TOP_LIMB(ytop, ym);
-                        RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
-                    }
-
-                    if (xrad && yrad)
-                    {
-                        RAD_ADDMUL(srad, srad_exp, xrad, yrad, xrexp + yrexp);
-                    }
-                }
-            }
+            _arb_dot_sum(sum, &serr, &srad, tmp, sn, sum_exp, srad_exp, flipsign,
+                ((arb_srcptr) x) + xoff, 2 * xstep,
+                ((arb_srcptr) y) + yoff, 2 * ystep, len, use_gauss);
 
             if (xoff == yoff)
             {
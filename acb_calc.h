@@ -24,6 +24,9 @@ extern "C" {
 typedef int (*acb_calc_func_t)(acb_ptr out,
     const acb_t inp, void * param, slong order, slong prec);
 
+typedef int (*acb_calc_vec_func_t)(acb_ptr out,
+    const acb_t inp, void * param, slong num, slong order, slong prec);
+
 /* Integration (old) */
 
 void acb_calc_cauchy_bound(arb_t bound, acb_calc_func_t func,
@@ -46,6 +49,7 @@ typedef struct
     slong depth_limit;
     int use_heap;
     int verbose;
+    slong num_threads;
 }
 acb_calc_integrate_opt_struct;
 
@@ -66,6 +70,62 @@ acb_calc_integrate_gl_auto_deg(acb_t res, slong * eval_count,
     const acb_t a, const acb_t b, const mag_t tol,
     slong deg_limit, int verbose, slong prec);
 
+int
+acb_calc_integrate_vec(acb_ptr res, acb_calc_vec_func_t f, void * param,
+    slong num, const acb_t a, const acb_t b,
+    slong goal, const mag_t tol,
+    const acb_calc_integrate_opt_t options,
+    slong prec);
+
+int
+acb_calc_integrate_gl_auto_deg_vec(acb_ptr res, slong * eval_count,
+    acb_calc_vec_func_t f, void * param, slong num,
+    const acb_t a, const acb_t b, mag_srcptr tol,
+    slong deg_limit, int verbose, slong prec);
+
+/* Gauss-Legendre nodes (cached) */
+
+#define ACB_CALC_GL_STEPS 38
+
+/* number of points of the i-th rule (internal) */
+extern const slong _acb_calc_gl_steps[ACB_CALC_GL_STEPS];
+
+void acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec);
+
+ARB_DLL extern int acb_calc_gl_use_shared_cache;
+ARB_DLL extern slong acb_calc_gl_shared_cache_max_bytes;
+
+void acb_calc_gl_shared_cache_prefill(slong max_points, slong prec);
+void acb_calc_gl_shared_cache_clear(void);
+slong acb_calc_gl_shared_cache_allocated_bytes(void);
+
+/* Internal helpers shared by the scalar and vector integration code.
+   A scalar integrand is passed to them as a vector integrand with one
+   component, using _acb_calc_func_as_vec with a pointer to an
+   _acb_calc_func_as_vec_param_struct as parameter. */
+
+typedef struct
+{
+    acb_calc_func_t f;
+    void * param;
+}
+_acb_calc_func_as_vec_param_struct;
+
+int _acb_calc_func_as_vec(acb_ptr out, const acb_t inp, void * param,
+    slong num, slong order, slong prec);
+
+void _acb_calc_quad_simple_vec(acb_ptr res, acb_calc_vec_func_t f, void * param,
+    slong num, const acb_t a, const acb_t b, slong prec);
+
+int _acb_calc_overlaps(acb_t tmp, const acb_t a, const acb_t b, slong prec);
+
+int _acb_calc_vec_is_finite(acb_srcptr vec, slong len);
+
+slong _acb_calc_gl_auto_deg_search(mag_ptr err, mag_t rho, slong * eval_count,
+    acb_calc_vec_func_t f, void * param, slong num,
+    const acb_t mid, const acb_t delta, mag_srcptr tol,
+    slong deg_limit, slong prec);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,21 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+int
+_acb_calc_func_as_vec(acb_ptr out, const acb_t inp, void * param,
+    slong num, slong order, slong prec)
+{
+    _acb_calc_func_as_vec_param_struct * p = param;
+
+    return p->f(out, inp, p->param, order, prec);
+}
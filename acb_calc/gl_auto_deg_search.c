@@ -0,0 +1,140 @@
+/*
+    Copyright (C) 2017 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+/* Returns the index i of the Gauss-Legendre rule with the smallest number
+   n = _acb_calc_gl_steps[i] <= deg_limit of points for which the error
+   bound for the integral over [mid - delta, mid + delta] of every
+   component j of f is smaller than tol[j], or -1 if there is none. On
+   success, sets err[j] to the error bound of component j and rho to the
+   radius of the Bernstein ellipse used for the bound. Adds the number
+   of evaluations of f to eval_count. */
+slong
+_acb_calc_gl_auto_deg_search(mag_ptr err, mag_t rho, slong * eval_count,
+    acb_calc_vec_func_t f, void * param, slong num,
+    const acb_t mid, const acb_t delta, mag_srcptr tol,
+    slong deg_limit, slong prec)
+{
+    acb_t wide;
+    acb_ptr v;
+    mag_ptr M, e;
+    mag_t X, Y, r, t, tmpm;
+    slong i, j, n, best_i, best_n, Xexp;
+    int ok;
+
+    acb_init(wide);
+    mag_init(X);
+    mag_init(Y);
+    mag_init(r);
+    mag_init(t);
+    mag_init(tmpm);
+    v = _acb_vec_init(num);
+    M = _mag_vec_init(num);
+    e = _mag_vec_init(num);
+
+    best_i = best_n = -1;
+
+    for (Xexp = 0; Xexp < prec; Xexp += FLINT_MAX(1, Xexp))
+    {
+        mag_one(X);
+        mag_mul_2exp_si(X, X, Xexp + 1);
+
+        /* r = X + sqrt(X^2 - 1)  (lower bound) */
+        mag_mul_lower(r, X, X);
+        mag_one(t);
+        mag_sub_lower(r, r, t);
+        mag_sqrt_lower(r, r);
+        mag_add_lower(r, r, X);
+
+        /* Y = sqrt(X^2 - 1)  (upper bound) */
+        mag_mul(Y, X, X);
+        mag_one(t);
+        mag_sub(Y, Y, t);
+        mag_sqrt(Y, Y);
+
+        acb_zero(wide);
+        mag_set(arb_radref(acb_realref(wide)), X);
+        mag_set(arb_radref(acb_imagref(wide)), Y);
+
+        /* transform to [a,b] */
+        acb_mul(wide, wide, delta, prec);
+        acb_add(wide, wide, mid, prec);
+
+        f(v, wide, param, num, 1, prec);
+        eval_count[0]++;
+
+        /* no chance */
+        if (!_acb_calc_vec_is_finite(v, num))
+            break;
+
+        /* M_j = (b-a)/2  |f_j| */
+        acb_get_mag(tmpm, delta);
+        for (j = 0; j < num; j++)
+        {
+            acb_get_mag(M + j, v + j);
+            mag_mul(M + j, M + j, tmpm);
+        }
+
+        /* Search for the smallest n that gives e_j < tol_j for all j */
+        for (i = 0; i < ACB_CALC_GL_STEPS && _acb_calc_gl_steps[i] <= deg_limit; i++)
+        {
+            n = _acb_calc_gl_steps[i];
+
+            /* (64/15) M / ((r-1) r^(2n-1)) */
+            mag_pow_ui_lower(t, r, 2 * n - 1);
+            mag_one(tmpm);
+            mag_sub_lower(tmpm, r, tmpm);
+            mag_mul_lower(t, t, tmpm);
+            mag_mul_ui_lower(t, t, 15);
+
+            ok = 1;
+            for (j = 0; j < num && ok; j++)
+            {
+                mag_div(e + j, M + j, t);
+                mag_mul_2exp_si(e + j, e + j, 6);
+                ok = (mag_cmp(e + j, tol + j) < 0);
+            }
+
+            if (ok)
+            {
+                /* The best so far. */
+                if (best_n == -1 || n < best_n)
+                {
+                    for (j = 0; j < num; j++)
+                        mag_set(err + j, e + j);
+                    mag_set(rho, r);
+                    best_i = i;
+                    best_n = n;
+                }
+
+                /* Larger n cannot be better for this r. */
+                break;
+            }
+        }
+
+        /* Best possible n. */
+        if (best_n == 1)
+            break;
+    }
+
+    acb_clear(wide);
+    mag_clear(X);
+    mag_clear(Y);
+    mag_clear(r);
+    mag_clear(t);
+    mag_clear(tmpm);
+    _acb_vec_clear(v, num);
+    _mag_vec_clear(M, num);
+    _mag_vec_clear(e, num);
+
+    return best_i;
+}
@@ -11,42 +11,17 @@
 
 #include "acb_calc.h"
 
+/* Direct evaluation: integral = (b-a) * f([a,b]). */
 static void
 quad_simple(acb_t res, acb_calc_func_t f, void * param,
         const acb_t a, const acb_t b, slong prec)
 {
-    acb_t mid, delta, wide;
-    mag_t tmpm;
+    _acb_calc_func_as_vec_param_struct fv;
 
-    acb_init(mid);
-    acb_init(delta);
-    acb_init(wide);
-    mag_init(tmpm);
+    fv.f = f;
+    fv.param = param;
 
-    /* delta = (b-a)/2 */
-    acb_sub(delta, b, a, prec);
-    acb_mul_2exp_si(delta, delta, -1);
-
-    /* mid = (a+b)/2 */
-    acb_add(mid, a, b, prec);
-    acb_mul_2exp_si(mid, mid, -1);
-
-    /* wide = mid +- [delta] */
-    acb_set(wide, mid);
-    arb_get_mag(tmpm, acb_realref(delta));
-    arb_add_error_mag(acb_realref(wide), tmpm);
-    arb_get_mag(tmpm, acb_imagref(delta));
-    arb_add_error_mag(acb_imagref(wide), tmpm);
-
-    /* Direct evaluation: integral = (b-a) * f([a,b]). */
-    f(res, wide, param, 0, prec);
-    acb_mul(res, res, delta, prec);
-    acb_mul_2exp_si(res, res, 1);
-
-    acb_clear(mid);
-    acb_clear(delta);
-    acb_clear(wide);
-    mag_clear(tmpm);
+    _acb_calc_quad_simple_vec(res, _acb_calc_func_as_vec, &fv, 1, a, b, prec);
 }
 
 static void
@@ -97,11 +72,313 @@ heap_down(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong n)
     }
 }
 
+/* Parallel version: the subintervals are kept in a priority queue
+   ordered by error. In each round, up to num_threads subintervals with
+   the largest errors are taken from the queue and processed
+   simultaneously; the results are then merged back serially in a fixed
+   order, so that the subdivision and the order of summation do not
+   depend on the timing of the threads. */
+
+typedef struct
+{
+    acb_ptr as;
+    acb_ptr bs;
+    acb_ptr vs;
+    mag_ptr ms;
+    acb_ptr as2;
+    acb_ptr bs2;
+    acb_ptr vs2;
+    mag_ptr ms2;
+    acb_ptr us;
+    slong * feval;
+    int * gl_status;
+    acb_calc_func_t f;
+    void * param;
+    mag_srcptr tol;
+    slong deg_limit;
+    int verbose;
+    slong prec;
+}
+integrate_work_t;
+
+static void
+integrate_worker(slong i, void * arg)
+{
+    integrate_work_t * work = (integrate_work_t *) arg;
+    acb_ptr as = work->as, bs = work->bs, vs = work->vs;
+    acb_ptr as2 = work->as2, bs2 = work->bs2, vs2 = work->vs2;
+    slong prec = work->prec;
+
+    work->gl_status[i] = ARB_CALC_NO_CONVERGENCE;
+    work->feval[i] = 0;
+
+    /* Attempt using Gauss-Legendre rule. */
+    if (acb_is_finite(vs + i))
+    {
+        work->gl_status[i] = acb_calc_integrate_gl_auto_deg(work->us + i,
+            work->feval + i, work->f, work->param, as + i, bs + i,
+            work->tol, work->deg_limit, work->verbose > 1, prec);
+
+        if (work->gl_status[i] == ARB_CALC_SUCCESS)
+        {
+            /* We know that the result is real. */
+            if (acb_is_real(vs + i))
+                arb_zero(acb_imagref(work->us + i));
+            return;
+        }
+    }
+
+    /* Bisection: [a, b] becomes [a, mid] and [mid, b]. */
+    acb_set(bs2 + i, bs + i);
+    acb_add(as2 + i, as + i, bs + i, prec);
+    acb_mul_2exp_si(as2 + i, as2 + i, -1);
+    acb_set(bs + i, as2 + i);
+
+    quad_simple(vs + i, work->f, work->param, as + i, bs + i, prec);
+    mag_hypot(work->ms + i, arb_radref(acb_realref(vs + i)), arb_radref(acb_imagref(vs + i)));
+
+    quad_simple(vs2 + i, work->f, work->param, as2 + i, bs2 + i, prec);
+    mag_hypot(work->ms2 + i, arb_radref(acb_realref(vs2 + i)), arb_radref(acb_imagref(vs2 + i)));
+}
+
+/* Inserts the interval at position n (swapping out the given entries). */
+static void
+heap_push(acb_ptr as, acb_ptr bs, acb_ptr vs, mag_ptr ms, slong n,
+    acb_t a, acb_t b, acb_t v, mag_t m)
+{
+    acb_swap(as + n, a);
+    acb_swap(bs + n, b);
+    acb_swap(vs + n, v);
+    mag_swap(ms + n, m);
+    heap_down(as, bs, vs, ms, n + 1);
+}
+
 static int
-_acb_overlaps(acb_t tmp, const acb_t a, const acb_t b, slong prec)
+acb_calc_integrate_parallel(acb_t res, acb_calc_func_t f, void * param,
+    const acb_t a, const acb_t b, slong goal, const mag_t tol,
+    slong depth_limit, slong eval_limit, slong deg_limit,
+    slong num_threads, int verbose, slong prec)
 {
-    acb_sub(tmp, a, b, prec);
-    return acb_contains_zero(tmp);
+    acb_ptr as, bs, vs;
+    mag_ptr ms;
+    acb_t s, u;
+    mag_t tmpm, new_tol;
+    integrate_work_t work;
+    slong depth, depth_max, eval, leaf_interval_count, alloc;
+    slong i, k, num_active, rounds;
+    slong * active;
+    int stopping, status;
+
+    status = ARB_CALC_SUCCESS;
+
+    acb_init(s);
+    acb_init(u);
+    mag_init(tmpm);
+    mag_init(new_tol);
+
+    alloc = 4 + 2 * num_threads;
+    as = _acb_vec_init(alloc);
+    bs = _acb_vec_init(alloc);
+    vs = _acb_vec_init(alloc);
+    ms = _mag_vec_init(alloc);
+
+    work.as = _acb_vec_init(num_threads);
+    work.bs = _acb_vec_init(num_threads);
+    work.vs = _acb_vec_init(num_threads);
+    work.ms = _mag_vec_init(num_threads);
+    work.as2 = _acb_vec_init(num_threads);
+    work.bs2 = _acb_vec_init(num_threads);
+    work.vs2 = _acb_vec_init(num_threads);
+    work.ms2 = _mag_vec_init(num_threads);
+    work.us = _acb_vec_init(num_threads);
+    work.feval = flint_malloc(sizeof(slong) * num_threads);
+    work.gl_status = flint_malloc(sizeof(int) * num_threads);
+    work.f = f;
+    work.param = param;
+    work.tol = new_tol;
+    work.deg_limit = deg_limit;
+    work.verbose = verbose;
+    work.prec = prec;
+
+    active = flint_malloc(sizeof(slong) * num_threads);
+
+    /* Compute initial crude estimate for the whole interval. */
+    acb_set(as, a);
+    acb_set(bs, b);
+    quad_simple(vs, f, param, as, bs, prec);
+    mag_hypot(ms, arb_radref(acb_realref(vs)), arb_radref(acb_imagref(vs)));
+
+    depth = depth_max = 1;
+    eval = 1;
+    stopping = 0;
+    leaf_interval_count = 0;
+    rounds = 0;
+
+    /* Adjust absolute tolerance based on new information. */
+    acb_get_mag_lower(tmpm, vs);
+    mag_mul_2exp_si(tmpm, tmpm, -goal);
+    mag_max(new_tol, tol, tmpm);
+
+    acb_zero(s);
+
+    while (depth >= 1)
+    {
+        if (stopping == 0 && eval >= eval_limit - 1)
+        {
+            if (verbose > 0)
+                flint_printf("stopping at eval_limit %wd\n", eval_limit);
+            status = ARB_CALC_NO_CONVERGENCE;
+            stopping = 1;
+        }
+
+        if (stopping == 0 && depth >= depth_limit - 1)
+        {
+            if (verbose > 0)
+                flint_printf("stopping at depth_limit %wd\n", depth_limit);
+            status = ARB_CALC_NO_CONVERGENCE;
+            stopping = 1;
+        }
+
+        /* Take the intervals with the largest errors from the queue;
+           those that are already accurate enough are done. */
+        num_active = 0;
+
+        for (k = 0; k < num_threads && depth > 0; k++)
+        {
+            depth--;
+            acb_swap(work.as + k, as);
+            acb_swap(work.bs + k, bs);
+            acb_swap(work.vs + k, vs);
+            mag_swap(work.ms + k, ms);
+
+            if (depth > 0)
+            {
+                acb_swap(as, as + depth);
+                acb_swap(bs, bs + depth);
+                acb_swap(vs, vs + depth);
+                mag_swap(ms, ms + depth);
+                heap_up(as, bs, vs, ms, depth);
+            }
+
+            if (mag_cmp(work.ms + k, new_tol) < 0 ||
+                _acb_calc_overlaps(u, work.as + k, work.bs + k, prec) || stopping)
+            {
+                acb_add(s, s, work.vs + k, prec);
+                leaf_interval_count++;
+            }
+            else
+            {
+                active[num_active] = k;
+                num_active++;
+            }
+        }
+
+        if (num_active == 0)
+            continue;
+
+        /* Move the active intervals to the front of the batch. */
+        for (i = 0; i < num_active; i++)
+        {
+            if (active[i] != i)
+            {
+                acb_swap(work.as + i, work.as + active[i]);
+                acb_swap(work.bs + i, work.bs + active[i]);
+                acb_swap(work.vs + i, work.vs + active[i]);
+                mag_swap(work.ms + i, work.ms + active[i]);
+            }
+        }
+
+        flint_parallel_do(integrate_worker, &work, num_active,
+            num_threads, FLINT_PARALLEL_DYNAMIC);
+        rounds++;
+
+        if (depth + 2 * num_active > alloc)
+        {
+            slong new_alloc = FLINT_MAX(2 * alloc, depth + 2 * num_active);
+
+            as = flint_realloc(as, new_alloc * sizeof(acb_struct));
+            bs = flint_realloc(bs, new_alloc * sizeof(acb_struct));
+            vs = flint_realloc(vs, new_alloc * sizeof(acb_struct));
+            ms = flint_realloc(ms, new_alloc * sizeof(mag_struct));
+            for (k = alloc; k < new_alloc; k++)
+            {
+                acb_init(as + k);
+                acb_init(bs + k);
+                acb_init(vs + k);
+                mag_init(ms + k);
+            }
+            alloc = new_alloc;
+        }
+
+        /* Merge the results in a fixed order. */
+        for (i = 0; i < num_active; i++)
+        {
+            eval += work.feval[i];
+
+            if (work.gl_status[i] == ARB_CALC_SUCCESS)
+            {
+                acb_add(s, s, work.us + i, prec);
+                leaf_interval_count++;
+
+                /* Adjust absolute tolerance based on new information. */
+                acb_get_mag_lower(tmpm, work.us + i);
+                mag_mul_2exp_si(tmpm, tmpm, -goal);
+                mag_max(new_tol, new_tol, tmpm);
+            }
+            else
+            {
+                eval += 2;
+
+                acb_get_mag_lower(tmpm, work.vs + i);
+                mag_mul_2exp_si(tmpm, tmpm, -goal);
+                mag_max(new_tol, new_tol, tmpm);
+
+                acb_get_mag_lower(tmpm, work.vs2 + i);
+                mag_mul_2exp_si(tmpm, tmpm, -goal);
+                mag_max(new_tol, new_tol, tmpm);
+
+                heap_push(as, bs, vs, ms, depth, work.as + i, work.bs + i, work.vs + i, work.ms + i);
+                depth++;
+                heap_push(as, bs, vs, ms, depth, work.as2 + i, work.bs2 + i, work.vs2 + i, work.ms2 + i);
+                depth++;
+            }
+        }
+
+        depth_max = FLINT_MAX(depth, depth_max);
+    }
+
+    if (verbose > 0)
+    {
+        flint_printf("depth %wd/%wd, eval %wd/%wd, %wd leaf intervals, %wd rounds\n",
+            depth_max, depth_limit, eval, eval_limit, leaf_interval_count, rounds);
+    }
+
+    acb_set(res, s);
+
+    _acb_vec_clear(as, alloc);
+    _acb_vec_clear(bs, alloc);
+    _acb_vec_clear(vs, alloc);
+    _mag_vec_clear(ms, alloc);
+
+    _acb_vec_clear(work.as, num_threads);
+    _acb_vec_clear(work.bs, num_threads);
+    _acb_vec_clear(work.vs, num_threads);
+    _mag_vec_clear(work.ms, num_threads);
+    _acb_vec_clear(work.as2, num_threads);
+    _acb_vec_clear(work.bs2, num_threads);
+    _acb_vec_clear(work.vs2, num_threads);
+    _mag_vec_clear(work.ms2, num_threads);
+    _acb_vec_clear(work.us, num_threads);
+    flint_free(work.feval);
+    flint_free(work.gl_status);
+    flint_free(active);
+
+    acb_clear(s);
+    acb_clear(u);
+    mag_clear(tmpm);
+    mag_clear(new_tol);
+
+    return status;
 }
 
 int
@@ -155,6 +432,20 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
     verbose = options->verbose;
     use_heap = options->use_heap;
 
+    if (options->num_threads > 1)
+    {
+        acb_clear(s);
+        acb_clear(t);
+        acb_clear(u);
+        mag_clear(tmpm);
+        mag_clear(tmpn);
+        mag_clear(new_tol);
+
+        return acb_calc_integrate_parallel(res, f, param, a, b, goal, tol,
+            depth_limit, eval_limit, deg_limit, options->num_threads,
+            verbose, prec);
+    }
+
     alloc = 4;
     as = _acb_vec_init(alloc);
     bs = _acb_vec_init(alloc);
@@ -197,7 +488,7 @@ acb_calc_integrate(acb_t res, acb_calc_func_t f, void * param,
 
         /* We are done with this subinterval. */
         if (mag_cmp(ms + top, new_tol) < 0 ||
-            _acb_overlaps(u, as + top, bs + top, prec) || stopping)
+            _acb_calc_overlaps(u, as + top, bs + top, prec) || stopping)
         {
             acb_add(s, s, vs + top, prec);
             leaf_interval_count++;
@@ -9,8 +9,10 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <pthread.h>
 #include "arb_hypgeom.h"
 #include "acb_calc.h"
+#include "arb_cache.h"
 
 /*
   Gauss-Legendre quadrature nodes are cached to speed up multiple integrations
@@ -19,9 +21,16 @@
   needed and not 2x more points) but may require more precomputation.
 */
 
-#define GL_STEPS 38
+#define GL_STEPS ACB_CALC_GL_STEPS
 
-const slong gl_steps[GL_STEPS] = {1, 2, 4, 6, 8, 12, 16, 22, 32, 46, 64,
+/* Nodes are computed with this many bits more than requested. The
+   error of the tables is then negligible compared to the final
+   rounding, so the output only depends on the precision, and not on
+   the precision of the table it is rounded from (which depends on what
+   has been cached previously, in this thread or in the shared cache). */
+#define GL_PADDING 64
+
+const slong _acb_calc_gl_steps[GL_STEPS] = {1, 2, 4, 6, 8, 12, 16, 22, 32, 46, 64,
     90, 128, 182, 256, 362, 512, 724, 1024, 1448, 2048, 2896, 4096,
     5792, 8192, 11586, 16384, 23170, 32768, 46340, 65536, 92682,
     131072, 185364, 262144, 370728, 524288, 741456};
@@ -47,8 +56,8 @@ void gl_cleanup()
     {
         if (gl_cache->gl_prec[i] != 0)
         {
-            _arb_vec_clear(gl_cache->gl_nodes[i], (gl_steps[i] + 1) / 2);
-            _arb_vec_clear(gl_cache->gl_weights[i], (gl_steps[i] + 1) / 2);
+            _arb_vec_clear(gl_cache->gl_nodes[i], (_acb_calc_gl_steps[i] + 1) / 2);
+            _arb_vec_clear(gl_cache->gl_weights[i], (_acb_calc_gl_steps[i] + 1) / 2);
         }
     }
 
@@ -62,71 +71,227 @@ void gl_init()
     flint_register_cleanup_function(gl_cleanup);
 }
 
-/* Compute GL node and weight of index k for n = gl_steps[i]. Cached. */
-typedef struct
+/*
+  Process-wide cache, used when acb_calc_gl_use_shared_cache is set.
+
+  For each degree, the cache holds a list of immutable snapshots
+  (nodes and weights computed to some precision), newest first. The
+  precision of a computed snapshot is a power of two (a snapshot loaded
+  from a cache file keeps the precision of the file, capped at that
+  power of two), and each new snapshot has a higher precision than the
+  previous head, so the snapshots for one degree use only a small
+  multiple of the memory of the newest one. Readers load the head with
+  an acquire load and pick the lowest-precision snapshot that is good
+  enough, without locking. A thread needing a
+  higher precision computes a new snapshot under the per-degree lock
+  and publishes it with a release store. The snapshots are freed by
+  acb_calc_gl_shared_cache_clear, which is called when the last thread
+  holding a reference to the shared state drops it (see
+  arb/shared_state.c). The per-degree locks are never destroyed.
+*/
+
+typedef struct gl_snapshot_struct
 {
     arb_ptr nodes;
     arb_ptr weights;
-    slong n;
-    slong wp;
+    slong prec;
+    slong bytes;
+    struct gl_snapshot_struct * prev;
+}
+gl_snapshot_struct;
+
+int acb_calc_gl_use_shared_cache = 0;
+slong acb_calc_gl_shared_cache_max_bytes = 0;
+
+static gl_snapshot_struct * gl_shared[GL_STEPS];
+static pthread_mutex_t gl_shared_locks[GL_STEPS];
+static pthread_once_t gl_shared_locks_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t gl_shared_lock = PTHREAD_MUTEX_INITIALIZER;
+static slong gl_shared_bytes = 0;
+
+void
+acb_calc_gl_shared_cache_clear(void)
+{
+    gl_snapshot_struct * v, * prev;
+    slong i, n;
+
+    for (i = 0; i < GL_STEPS; i++)
+    {
+        n = _acb_calc_gl_steps[i];
+        v = gl_shared[i];
+        _ARB_SHARED_STORE_PTR(gl_shared + i, NULL);
+
+        for ( ; v != NULL; v = prev)
+        {
+            prev = v->prev;
+            _arb_vec_clear(v->nodes, (n + 1) / 2);
+            _arb_vec_clear(v->weights, (n + 1) / 2);
+            flint_free(v);
+        }
+    }
+
+    pthread_mutex_lock(&gl_shared_lock);
+    gl_shared_bytes = 0;
+    pthread_mutex_unlock(&gl_shared_lock);
+}
+
+slong
+acb_calc_gl_shared_cache_allocated_bytes(void)
+{
+    slong bytes;
+
+    pthread_mutex_lock(&gl_shared_lock);
+    bytes = gl_shared_bytes;
+    pthread_mutex_unlock(&gl_shared_lock);
+
+    return bytes;
 }
-nodes_work_t;
 
 static void
-nodes_worker(slong jj, nodes_work_t * work)
+_gl_shared_locks_init(void)
 {
-    arb_hypgeom_legendre_p_ui_root(work->nodes + jj, work->weights + jj, work->n, jj, work->wp);
+    slong i;
+
+    for (i = 0; i < GL_STEPS; i++)
+        pthread_mutex_init(gl_shared_locks + i, NULL);
 }
 
-/* if k >= 0, compute the node and weight of index k */
-/* if k < 0, compute the first (n+1)/2 nodes and weights (the others are given by symmetry) */
-void
-acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
+static pthread_mutex_t *
+_gl_shared_get_lock(slong i)
 {
-    slong n, kk, wp;
-    int all;
+    pthread_once(&gl_shared_locks_once, _gl_shared_locks_init);
+    return gl_shared_locks + i;
+}
 
-    if (i < 0 || i >= GL_STEPS || prec < 2)
-        flint_abort();
+/* The lowest-precision snapshot with at least prec bits, or NULL. */
+static gl_snapshot_struct *
+_gl_shared_find(gl_snapshot_struct * v, slong prec)
+{
+    gl_snapshot_struct * best = NULL;
 
-    if (gl_cache == NULL)
-        gl_init();
+    for ( ; v != NULL && v->prec >= prec; v = v->prev)
+        best = v;
 
-    n = gl_steps[i];
+    return best;
+}
 
-    if (k >= n)
-        flint_abort();
+/* Returns a snapshot for degree index i with at least prec bits,
+   computing it if necessary, or NULL if this would exceed the memory
+   limit of the shared cache. */
+static gl_snapshot_struct *
+_gl_shared_get(slong i, slong prec)
+{
+    gl_snapshot_struct * v, * w;
+    pthread_mutex_t * lock;
+    slong n, wp, file_wp, bytes;
+
+    /* the snapshot stays valid until this thread calls flint_cleanup */
+    _arb_shared_state_hold();
+
+    v = _gl_shared_find(_ARB_SHARED_LOAD_PTR(gl_shared + i), prec);
+
+    if (v != NULL)
+        return v;
+
+    _arb_shared_state_register(acb_calc_gl_shared_cache_clear);
 
-    all = (k < 0);
-    
-    if (gl_cache->gl_prec[i] < prec)
+    lock = _gl_shared_get_lock(i);
+    pthread_mutex_lock(lock);
+
+    /* another thread may have published in the meantime */
+    v = _gl_shared_find(gl_shared[i], prec);
+
+    if (v == NULL)
     {
-        nodes_work_t work;
+        n = _acb_calc_gl_steps[i];
+        wp = WORD(1) << FLINT_CLOG2(FLINT_MAX(prec, 64));
 
-        if (gl_cache->gl_prec[i] == 0)
+        if (acb_calc_gl_shared_cache_max_bytes > 0)
         {
-            gl_cache->gl_nodes[i] = _arb_vec_init((n + 1) / 2);
-            gl_cache->gl_weights[i] = _arb_vec_init((n + 1) / 2);
+            bytes = 2 * _arb_vec_estimate_allocated_bytes((n + 1) / 2, wp)
+                  + sizeof(gl_snapshot_struct);
+
+            pthread_mutex_lock(&gl_shared_lock);
+            bytes += gl_shared_bytes;
+            pthread_mutex_unlock(&gl_shared_lock);
+
+            if (bytes > acb_calc_gl_shared_cache_max_bytes)
+            {
+                pthread_mutex_unlock(lock);
+                return NULL;
+            }
         }
 
-        wp = FLINT_MAX(prec, gl_cache->gl_prec[i] * 2 + 30);
+        w = flint_malloc(sizeof(gl_snapshot_struct));
+        w->nodes = _arb_vec_init((n + 1) / 2);
+        w->weights = _arb_vec_init((n + 1) / 2);
+        w->prev = gl_shared[i];
 
-        work.nodes = gl_cache->gl_nodes[i];
-        work.weights = gl_cache->gl_weights[i];
-        work.n = n;
-        work.wp = wp;
+        /* warm start from the cache file, if loaded; any entry with
+           at least prec bits is usable, and entries with more than wp
+           bits are rounded to wp bits in memory */
+        file_wp = _arb_cache_gl_load(w->nodes, w->weights, n, prec);
 
-        flint_parallel_do((do_func_t) nodes_worker, &work, (n + 1) / 2, -1, FLINT_PARALLEL_STRIDED);
+        if (file_wp != 0)
+        {
+            if (file_wp > wp)
+            {
+                _arb_vec_set_round(w->nodes, w->nodes, (n + 1) / 2, wp);
+                _arb_vec_set_round(w->weights, w->weights, (n + 1) / 2, wp);
+            }
+            else
+            {
+                wp = file_wp;
+            }
+        }
+        else
+        {
+            _arb_hypgeom_legendre_p_ui_roots_vec(w->nodes, w->weights, n, wp);
+        }
 
-        gl_cache->gl_prec[i] = wp;
+        w->prec = wp;
+        w->bytes = _arb_vec_allocated_bytes(w->nodes, (n + 1) / 2)
+                 + _arb_vec_allocated_bytes(w->weights, (n + 1) / 2);
+
+        pthread_mutex_lock(&gl_shared_lock);
+        gl_shared_bytes += w->bytes + sizeof(gl_snapshot_struct);
+        pthread_mutex_unlock(&gl_shared_lock);
+
+        _ARB_SHARED_STORE_PTR(gl_shared + i, w);
+        v = w;
     }
 
-    if (all)
+    pthread_mutex_unlock(lock);
+
+    return v;
+}
+
+void
+acb_calc_gl_shared_cache_prefill(slong max_points, slong prec)
+{
+    slong i;
+
+    for (i = 0; i < GL_STEPS && _acb_calc_gl_steps[i] <= max_points; i++)
+    {
+        if (_gl_shared_get(i, prec + GL_PADDING) == NULL)
+            break;
+    }
+}
+
+/* Rounds node k (or the first half of the nodes if k < 0)
+   from the given table of n nodes. */
+static void
+_gl_node_get(arb_ptr x, arb_ptr w, arb_srcptr nodes, arb_srcptr weights,
+    slong n, slong k, slong prec)
+{
+    slong kk;
+
+    if (k < 0)
     {
         for (k = 0; k < (n + 1) / 2; k++)
         {
-            arb_set_round(x + k, gl_cache->gl_nodes[i] + k, prec);
-            arb_set_round(w + k, gl_cache->gl_weights[i] + k, prec);
+            arb_set_round(x + k, nodes + k, prec);
+            arb_set_round(w + k, weights + k, prec);
         }
     }
     else
@@ -137,14 +302,77 @@ acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
             kk = n - 1 - k;
 
         if (2 * k < n)
-            arb_set_round(x, gl_cache->gl_nodes[i] + kk, prec);
+            arb_set_round(x, nodes + kk, prec);
         else
-            arb_neg_round(x, gl_cache->gl_nodes[i] + kk, prec);
+            arb_neg_round(x, nodes + kk, prec);
 
-        arb_set_round(w, gl_cache->gl_weights[i] + kk, prec);
+        arb_set_round(w, weights + kk, prec);
     }
 }
 
+/* if k >= 0, compute the node and weight of index k */
+/* if k < 0, compute the first (n+1)/2 nodes and weights (the others are given by symmetry) */
+void
+acb_calc_gl_node(arb_ptr x, arb_ptr w, slong i, slong k, slong prec)
+{
+    slong n, wp;
+
+    if (i < 0 || i >= GL_STEPS || prec < 2)
+        flint_abort();
+
+    n = _acb_calc_gl_steps[i];
+
+    if (k >= n)
+        flint_abort();
+
+    if (acb_calc_gl_use_shared_cache)
+    {
+        gl_snapshot_struct * v = _gl_shared_get(i, prec + GL_PADDING);
+
+        if (v != NULL)
+        {
+            _gl_node_get(x, w, v->nodes, v->weights, n, k, prec);
+            return;
+        }
+    }
+
+    if (gl_cache == NULL)
+        gl_init();
+
+    if (gl_cache->gl_prec[i] < prec + GL_PADDING)
+    {
+        slong file_wp;
+
+        if (gl_cache->gl_prec[i] == 0)
+        {
+            gl_cache->gl_nodes[i] = _arb_vec_init((n + 1) / 2);
+            gl_cache->gl_weights[i] = _arb_vec_init((n + 1) / 2);
+        }
+
+        wp = FLINT_MAX(prec + GL_PADDING, gl_cache->gl_prec[i] * 2 + 30);
+
+        /* warm start from the cache file, if loaded */
+        file_wp = 0;
+        if (gl_cache->gl_prec[i] == 0)
+            file_wp = _arb_cache_gl_load(gl_cache->gl_nodes[i],
+                gl_cache->gl_weights[i], n, prec + GL_PADDING);
+
+        if (file_wp != 0)
+        {
+            wp = file_wp;
+        }
+        else
+        {
+            _arb_hypgeom_legendre_p_ui_roots_vec(gl_cache->gl_nodes[i],
+                gl_cache->gl_weights[i], n, wp);
+        }
+
+        gl_cache->gl_prec[i] = wp;
+    }
+
+    _gl_node_get(x, w, gl_cache->gl_nodes[i], gl_cache->gl_weights[i], n, k, prec);
+}
+
 typedef struct
 {
     slong n;
@@ -199,13 +427,14 @@ acb_calc_integrate_gl_auto_deg(acb_t res, slong * eval_count,
     const acb_t a, const acb_t b, const mag_t tol,
     slong deg_limit, int verbose, slong prec)
 {
-    acb_t mid, delta, wide;
+    _acb_calc_func_as_vec_param_struct fv;
+    acb_t mid, delta;
     mag_t tmpm;
     slong status;
-    acb_t s, v;
-    mag_t M, X, Y, rho, err, t, best_rho;
-    slong k, Xexp;
-    slong i, n, best_n;
+    acb_t s;
+    mag_t err, rho;
+    slong k;
+    slong i, best_n;
 
     status = ARB_CALC_NO_CONVERGENCE;
 
@@ -218,7 +447,6 @@ acb_calc_integrate_gl_auto_deg(acb_t res, slong * eval_count,
 
     acb_init(mid);
     acb_init(delta);
-    acb_init(wide);
     mag_init(tmpm);
 
     /* delta = (b-a)/2 */
@@ -230,98 +458,26 @@ acb_calc_integrate_gl_auto_deg(acb_t res, slong * eval_count,
     acb_mul_2exp_si(mid, mid, -1);
 
     acb_init(s);
-    acb_init(v);
-    mag_init(M);
-    mag_init(X);
-    mag_init(Y);
     mag_init(rho);
-    mag_init(t);
     mag_init(err);
-    mag_init(best_rho);
 
-    best_n = -1;
     eval_count[0] = 0;
 
-    mag_inf(err);
-
-    for (Xexp = 0; Xexp < prec /* && Xexp == 0 */; Xexp += FLINT_MAX(1, Xexp))
-    {
-        mag_one(X);
-        mag_mul_2exp_si(X, X, Xexp + 1);
-
-        /* rho = X + sqrt(X^2 - 1)  (lower bound) */
-        mag_mul_lower(rho, X, X);
-        mag_one(t);
-        mag_sub_lower(rho, rho, t);
-        mag_sqrt_lower(rho, rho);
-        mag_add_lower(rho, rho, X);
-
-        /* Y = sqrt(X^2 - 1)  (upper bound) */
-        mag_mul(Y, X, X);
-        mag_one(t);
-        mag_sub(Y, Y, t);
-        mag_sqrt(Y, Y);
-
-        acb_zero(wide);
-        mag_set(arb_radref(acb_realref(wide)), X);
-        mag_set(arb_radref(acb_imagref(wide)), Y);
-
-        /* transform to [a,b] */
-        acb_mul(wide, wide, delta, prec);
-        acb_add(wide, wide, mid, prec);
-
-        f(v, wide, param, 1, prec);
-        eval_count[0]++;
-
-        /* no chance */
-        if (!acb_is_finite(v))
-            break;
-
-        /* M = (b-a)/2  |f| */
-        acb_get_mag(M, v);
-        acb_get_mag(tmpm, delta);
-        mag_mul(M, M, tmpm);
+    fv.f = f;
+    fv.param = param;
 
-        /* Search for the smallest n that gives err < tol (if possible) */
-        for (i = 0; i < GL_STEPS && gl_steps[i] <= deg_limit; i++)
-        {
-            n = gl_steps[i];
-
-            /* (64/15) M / ((rho-1) rho^(2n-1)) */
-            mag_pow_ui_lower(t, rho, 2 * n - 1);
-            mag_one(tmpm);
-            mag_sub_lower(tmpm, rho, tmpm);
-            mag_mul_lower(t, t, tmpm);
-            mag_mul_ui_lower(t, t, 15);
-            mag_div(t, M, t);
-            mag_mul_2exp_si(t, t, 6);
-
-            if (mag_cmp(t, tol) < 0)
-            {
-                status = ARB_CALC_SUCCESS;
-
-                /* The best so far. */
-                if (best_n == -1 || n < best_n)
-                {
-                    mag_set(err, t);
-                    mag_set(best_rho, rho);
-                    best_n = n;
-                }
-
-                /* Best possible n. */
-                if (n == 1)
-                    break;
-            }
-        }
-    }
+    i = _acb_calc_gl_auto_deg_search(err, rho, eval_count,
+        _acb_calc_func_as_vec, &fv, 1, mid, delta, tol, deg_limit, prec);
 
     /* Evaluate best found Gauss-Legendre quadrature rule. */
-    if (status == ARB_CALC_SUCCESS)
+    if (i >= 0)
     {
-        slong nt;
-        arb_t x, w;
-        arb_init(x);
-        arb_init(w);
+        gl_work_t work;
+        acb_ptr vals;
+        arb_ptr x, w;
+
+        status = ARB_CALC_SUCCESS;
+        best_n = _acb_calc_gl_steps[i];
 
         if (verbose)
         {
@@ -330,73 +486,51 @@ acb_calc_integrate_gl_auto_deg(acb_t res, slong * eval_count,
             acb_printn(a, 10, ARB_STR_NO_RADIUS); flint_printf(", ");
             acb_printn(b, 10, ARB_STR_NO_RADIUS);
             flint_printf("], delta "); mag_printd(tmpm, 5);
-            flint_printf(", rho "); mag_printd(best_rho, 5);
+            flint_printf(", rho "); mag_printd(rho, 5);
             flint_printf(", tol "); mag_printd(tol, 3);
             flint_printf("}\n");
         }
 
-        if (best_n == -1)
-            flint_abort();
-
-        for (i = 0; i < GL_STEPS; i++)
-            if (gl_steps[i] == best_n)
-                break;
-
-        nt = flint_get_num_threads();
-
-        if (nt >= 2 && best_n >= 2)
+        vals = _acb_vec_init(best_n);
+        x = _arb_vec_init((best_n + 1) / 2);
+        w = _arb_vec_init((best_n + 1) / 2);
+
+        acb_calc_gl_node(x, w, i, -1, prec);
+
+        work.n = best_n;
+        work.x = x;
+        work.w = w;
+        work.prec = prec;
+        work.delta = delta;
+        work.mid = mid;
+        work.v = vals;
+        work.f = f;
+        work.param = param;
+
+        /* The serial and parallel evaluations do the same operations,
+           so that the result does not depend on the number of threads. */
+        if (flint_get_num_threads() >= 2 && best_n >= 2)
         {
-            gl_work_t work;
-            acb_ptr v;
-            arb_ptr x, w;
-
-            v = _acb_vec_init(best_n);
-            w = _arb_vec_init((best_n + 1) / 2);
-            x = _arb_vec_init((best_n + 1) / 2);
-
-            acb_calc_gl_node(x, w, i, -1, prec);
-
-            work.n = best_n;
-            work.x = x;
-            work.w = w;
-            work.prec = prec;
-            work.delta = delta;
-            work.mid = mid;
-            work.v = v;
-            work.f = f;
-            work.param = param;
-
             flint_parallel_do((do_func_t) gl_worker, &work, best_n, -1, FLINT_PARALLEL_STRIDED);
-
-            acb_add(s, v, v + 1, prec);
-            for (k = 2; k < best_n; k++)
-                acb_add(s, s, v + k, prec);
-
-            _acb_vec_clear(v, best_n);
-            _arb_vec_clear(x, (best_n + 1) / 2);
-            _arb_vec_clear(w, (best_n + 1) / 2);
         }
         else
         {
-            acb_zero(s);
-
             for (k = 0; k < best_n; k++)
-            {
-                acb_calc_gl_node(x, w, i, k, prec);
-                acb_mul_arb(wide, delta, x, prec);
-                acb_add(wide, wide, mid, prec);
-                f(v, wide, param, 0, prec);
-                acb_addmul_arb(s, v, w, prec);
-            }
+                gl_worker(k, &work);
         }
 
+        acb_set(s, vals);
+        for (k = 1; k < best_n; k++)
+            acb_add(s, s, vals + k, prec);
+
         eval_count[0] += best_n;
 
         acb_mul(res, s, delta, prec);
         acb_add_error_mag(res, err);
 
-        arb_clear(x);
-        arb_clear(w);
+        _acb_vec_clear(vals, best_n);
+        _arb_vec_clear(x, (best_n + 1) / 2);
+        _arb_vec_clear(w, (best_n + 1) / 2);
     }
     else
     {
@@ -404,18 +538,11 @@ acb_calc_integrate_gl_auto_deg(acb_t res, slong * eval_count,
     }
 
     acb_clear(s);
-    acb_clear(v);
-    mag_clear(M);
-    mag_clear(X);
-    mag_clear(Y);
     mag_clear(rho);
-    mag_clear(t);
     mag_clear(err);
-    mag_clear(best_rho);
 
     acb_clear(mid);
     acb_clear(delta);
-    acb_clear(wide);
     mag_clear(tmpm);
 
     return status;
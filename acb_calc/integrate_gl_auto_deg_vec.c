@@ -0,0 +1,176 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+typedef struct
+{
+    slong n;
+    slong num;
+    slong prec;
+    arb_srcptr x;
+    arb_srcptr w;
+    acb_srcptr delta;
+    acb_srcptr mid;
+    acb_ptr v;
+    acb_calc_vec_func_t f;
+    void * param;
+}
+gl_vec_work_t;
+
+/* Evaluates all components at node k, multiplied by the weight. */
+static void
+gl_vec_worker(slong k, void * arg)
+{
+    gl_vec_work_t * work = (gl_vec_work_t *) arg;
+    acb_ptr v = work->v + k * work->num;
+    slong j, k2, prec = work->prec;
+    acb_t t;
+
+    acb_init(t);
+
+    if (2 * k < work->n)
+        k2 = k;
+    else
+        k2 = work->n - 1 - k;
+
+    acb_mul_arb(t, work->delta, work->x + k2, prec);
+
+    if (k2 != k)
+        acb_neg(t, t);
+
+    acb_add(t, t, work->mid, prec);
+    work->f(v, t, work->param, work->num, 0, prec);
+
+    for (j = 0; j < work->num; j++)
+        acb_mul_arb(v + j, v + j, work->w + k2, prec);
+
+    acb_clear(t);
+}
+
+int
+acb_calc_integrate_gl_auto_deg_vec(acb_ptr res, slong * eval_count,
+    acb_calc_vec_func_t f, void * param, slong num,
+    const acb_t a, const acb_t b, mag_srcptr tol,
+    slong deg_limit, int verbose, slong prec)
+{
+    acb_t mid, delta;
+    acb_ptr v;
+    mag_ptr err;
+    mag_t rho, tmpm;
+    slong i, k, best_n;
+    int status;
+
+    status = ARB_CALC_NO_CONVERGENCE;
+
+    if (deg_limit <= 0)
+    {
+        _acb_vec_indeterminate(res, num);
+        eval_count[0] = 0;
+        return status;
+    }
+
+    acb_init(mid);
+    acb_init(delta);
+    mag_init(rho);
+    mag_init(tmpm);
+    v = _acb_vec_init(num);
+    err = _mag_vec_init(num);
+
+    /* delta = (b-a)/2 */
+    acb_sub(delta, b, a, prec);
+    acb_mul_2exp_si(delta, delta, -1);
+
+    /* mid = (a+b)/2 */
+    acb_add(mid, a, b, prec);
+    acb_mul_2exp_si(mid, mid, -1);
+
+    eval_count[0] = 0;
+
+    i = _acb_calc_gl_auto_deg_search(err, rho, eval_count,
+        f, param, num, mid, delta, tol, deg_limit, prec);
+
+    /* Evaluate best found Gauss-Legendre quadrature rule. */
+    if (i >= 0)
+    {
+        gl_vec_work_t work;
+        arb_ptr x, w;
+        acb_ptr vals;
+
+        status = ARB_CALC_SUCCESS;
+        best_n = _acb_calc_gl_steps[i];
+
+        if (verbose)
+        {
+            acb_get_mag(tmpm, delta);
+            flint_printf("  {GL deg %wd on [", best_n);
+            acb_printn(a, 10, ARB_STR_NO_RADIUS); flint_printf(", ");
+            acb_printn(b, 10, ARB_STR_NO_RADIUS);
+            flint_printf("], delta "); mag_printd(tmpm, 5);
+            flint_printf(", rho "); mag_printd(rho, 5);
+            flint_printf(", %wd integrals}\n", num);
+        }
+
+        x = _arb_vec_init((best_n + 1) / 2);
+        w = _arb_vec_init((best_n + 1) / 2);
+        vals = _acb_vec_init(best_n * num);
+
+        /* the nodes are shared by all components */
+        acb_calc_gl_node(x, w, i, -1, prec);
+
+        work.n = best_n;
+        work.num = num;
+        work.prec = prec;
+        work.x = x;
+        work.w = w;
+        work.delta = delta;
+        work.mid = mid;
+        work.v = vals;
+        work.f = f;
+        work.param = param;
+
+        if (flint_get_num_threads() >= 2 && best_n >= 2)
+        {
+            flint_parallel_do(gl_vec_worker, &work, best_n, -1, FLINT_PARALLEL_STRIDED);
+        }
+        else
+        {
+            for (k = 0; k < best_n; k++)
+                gl_vec_worker(k, &work);
+        }
+
+        _acb_vec_set(v, vals, num);
+        for (k = 1; k < best_n; k++)
+            _acb_vec_add(v, v, vals + k * num, num, prec);
+
+        eval_count[0] += best_n;
+
+        _acb_vec_scalar_mul(res, v, num, delta, prec);
+        _acb_vec_add_error_mag_vec(res, err, num);
+
+        _arb_vec_clear(x, (best_n + 1) / 2);
+        _arb_vec_clear(w, (best_n + 1) / 2);
+        _acb_vec_clear(vals, best_n * num);
+    }
+    else
+    {
+        _acb_vec_indeterminate(res, num);
+    }
+
+    acb_clear(mid);
+    acb_clear(delta);
+    mag_clear(rho);
+    mag_clear(tmpm);
+    _acb_vec_clear(v, num);
+    _mag_vec_clear(err, num);
+
+    return status;
+}
@@ -0,0 +1,271 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+/* Largest error among the components. */
+static void
+_acb_vec_get_rad_mag(mag_t res, acb_srcptr v, slong num)
+{
+    slong j;
+    mag_t t;
+
+    mag_init(t);
+    mag_zero(res);
+
+    for (j = 0; j < num; j++)
+    {
+        mag_hypot(t, arb_radref(acb_realref(v + j)), arb_radref(acb_imagref(v + j)));
+        mag_max(res, res, t);
+    }
+
+    mag_clear(t);
+}
+
+/* Whether every component meets its tolerance. */
+static int
+_acb_vec_rad_below(acb_srcptr v, mag_srcptr tol, slong num)
+{
+    slong j;
+    mag_t t;
+    int below = 1;
+
+    mag_init(t);
+
+    for (j = 0; j < num && below; j++)
+    {
+        mag_hypot(t, arb_radref(acb_realref(v + j)), arb_radref(acb_imagref(v + j)));
+        below = (mag_cmp(t, tol + j) < 0);
+    }
+
+    mag_clear(t);
+    return below;
+}
+
+/* Adjust absolute tolerances based on new information. */
+static void
+_update_tol(mag_ptr new_tol, acb_srcptr v, slong num, slong goal)
+{
+    slong j;
+    mag_t t;
+
+    mag_init(t);
+
+    for (j = 0; j < num; j++)
+    {
+        acb_get_mag_lower(t, v + j);
+        mag_mul_2exp_si(t, t, -goal);
+        mag_max(new_tol + j, new_tol + j, t);
+    }
+
+    mag_clear(t);
+}
+
+int
+acb_calc_integrate_vec(acb_ptr res, acb_calc_vec_func_t f, void * param,
+    slong num, const acb_t a, const acb_t b,
+    slong goal, const mag_t tol,
+    const acb_calc_integrate_opt_t options,
+    slong prec)
+{
+    acb_ptr as, bs, vs, us, s;
+    mag_ptr new_tol;
+    acb_t u;
+    mag_t m1, m2;
+    slong depth_limit, eval_limit, deg_limit;
+    slong depth, depth_max, eval, feval, top;
+    slong leaf_interval_count;
+    slong alloc, j;
+    int stopping, status, gl_status, verbose;
+
+    if (options == NULL)
+    {
+        acb_calc_integrate_opt_t opt;
+        acb_calc_integrate_opt_init(opt);
+        return acb_calc_integrate_vec(res, f, param, num, a, b, goal, tol, opt, prec);
+    }
+
+    if (num <= 0)
+        return ARB_CALC_SUCCESS;
+
+    status = ARB_CALC_SUCCESS;
+
+    acb_init(u);
+    mag_init(m1);
+    mag_init(m2);
+    s = _acb_vec_init(num);
+    us = _acb_vec_init(num);
+    new_tol = _mag_vec_init(num);
+
+    depth_limit = options->depth_limit;
+    if (depth_limit <= 0)
+        depth_limit = 2 * prec;
+    depth_limit = FLINT_MAX(depth_limit, 1);
+
+    eval_limit = options->eval_limit;
+    if (eval_limit <= 0)
+        eval_limit = 1000 * prec + prec * prec;
+    eval_limit = FLINT_MAX(eval_limit, 1);
+
+    goal = FLINT_MAX(goal, 0);
+    deg_limit = options->deg_limit;
+    if (deg_limit <= 0)
+        deg_limit = 0.5 * FLINT_MIN(goal, prec) + 60;
+
+    verbose = options->verbose;
+
+    /* The subintervals are kept on a stack; interval k has endpoints
+       as[k], bs[k] and crude estimates vs[k * num], ..., vs[k * num + num - 1]. */
+    alloc = 4;
+    as = _acb_vec_init(alloc);
+    bs = _acb_vec_init(alloc);
+    vs = _acb_vec_init(alloc * num);
+
+    /* Compute initial crude estimate for the whole interval. */
+    acb_set(as, a);
+    acb_set(bs, b);
+    _acb_calc_quad_simple_vec(vs, f, param, num, as, bs, prec);
+
+    depth = depth_max = 1;
+    eval = 1;
+    stopping = 0;
+    leaf_interval_count = 0;
+
+    for (j = 0; j < num; j++)
+        mag_set(new_tol + j, tol);
+    _update_tol(new_tol, vs, num, goal);
+
+    _acb_vec_zero(s, num);
+
+    while (depth >= 1)
+    {
+        if (stopping == 0 && eval >= eval_limit - 1)
+        {
+            if (verbose > 0)
+                flint_printf("stopping at eval_limit %wd\n", eval_limit);
+            status = ARB_CALC_NO_CONVERGENCE;
+            stopping = 1;
+            continue;
+        }
+
+        top = depth - 1;
+
+        /* We are done with this subinterval. */
+        if (_acb_vec_rad_below(vs + top * num, new_tol, num) ||
+            _acb_calc_overlaps(u, as + top, bs + top, prec) || stopping)
+        {
+            _acb_vec_add(s, s, vs + top * num, num, prec);
+            leaf_interval_count++;
+            depth--;
+            continue;
+        }
+
+        /* Attempt using Gauss-Legendre rule. */
+        if (_acb_calc_vec_is_finite(vs + top * num, num))
+        {
+            gl_status = acb_calc_integrate_gl_auto_deg_vec(us, &feval, f,
+                param, num, as + top, bs + top, new_tol, deg_limit,
+                verbose > 1, prec);
+            eval += feval;
+
+            /* We are done with this subinterval. */
+            if (gl_status == ARB_CALC_SUCCESS)
+            {
+                /* We know that the result is real. */
+                for (j = 0; j < num; j++)
+                    if (acb_is_real(vs + top * num + j))
+                        arb_zero(acb_imagref(us + j));
+
+                _acb_vec_add(s, s, us, num, prec);
+                leaf_interval_count++;
+                _update_tol(new_tol, us, num, goal);
+
+                depth--;
+                continue;
+            }
+        }
+
+        if (depth >= depth_limit - 1)
+        {
+            if (verbose > 0)
+                flint_printf("stopping at depth_limit %wd\n", depth_limit);
+            status = ARB_CALC_NO_CONVERGENCE;
+            stopping = 1;
+            continue;
+        }
+
+        if (depth >= alloc - 1)
+        {
+            slong k;
+            as = flint_realloc(as, 2 * alloc * sizeof(acb_struct));
+            bs = flint_realloc(bs, 2 * alloc * sizeof(acb_struct));
+            vs = flint_realloc(vs, 2 * alloc * num * sizeof(acb_struct));
+            for (k = alloc; k < 2 * alloc; k++)
+            {
+                acb_init(as + k);
+                acb_init(bs + k);
+            }
+            for (k = alloc * num; k < 2 * alloc * num; k++)
+                acb_init(vs + k);
+            alloc *= 2;
+        }
+
+        /* Bisection. */
+        /* Interval [depth] becomes [mid, b]. */
+        acb_set(bs + depth, bs + top);
+        acb_add(as + depth, as + top, bs + top, prec);
+        acb_mul_2exp_si(as + depth, as + depth, -1);
+
+        /* Interval [top] becomes [a, mid]. */
+        acb_set(bs + top, as + depth);
+
+        /* Evaluate on [a, mid] and [mid, b] */
+        _acb_calc_quad_simple_vec(vs + top * num, f, param, num, as + top, bs + top, prec);
+        _acb_calc_quad_simple_vec(vs + depth * num, f, param, num, as + depth, bs + depth, prec);
+        eval += 2;
+        _update_tol(new_tol, vs + top * num, num, goal);
+        _update_tol(new_tol, vs + depth * num, num, goal);
+
+        /* Make the interval with the larger error the priority. */
+        _acb_vec_get_rad_mag(m1, vs + top * num, num);
+        _acb_vec_get_rad_mag(m2, vs + depth * num, num);
+
+        if (mag_cmp(m1, m2) < 0)
+        {
+            acb_swap(as + top, as + depth);
+            acb_swap(bs + top, bs + depth);
+            _acb_vec_swap(vs + top * num, vs + depth * num, num);
+        }
+
+        depth++;
+        depth_max = FLINT_MAX(depth, depth_max);
+    }
+
+    if (verbose > 0)
+    {
+        flint_printf("depth %wd/%wd, eval %wd/%wd, %wd leaf intervals\n",
+            depth_max, depth_limit, eval, eval_limit, leaf_interval_count);
+    }
+
+    _acb_vec_set(res, s, num);
+
+    _acb_vec_clear(as, alloc);
+    _acb_vec_clear(bs, alloc);
+    _acb_vec_clear(vs, alloc * num);
+    _acb_vec_clear(s, num);
+    _acb_vec_clear(us, num);
+    _mag_vec_clear(new_tol, num);
+    acb_clear(u);
+    mag_clear(m1);
+    mag_clear(m2);
+
+    return status;
+}
@@ -0,0 +1,19 @@
+/*
+    Copyright (C) 2017 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+int
+_acb_calc_overlaps(acb_t tmp, const acb_t a, const acb_t b, slong prec)
+{
+    acb_sub(tmp, a, b, prec);
+    return acb_contains_zero(tmp);
+}
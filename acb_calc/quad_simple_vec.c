@@ -0,0 +1,50 @@
+/*
+    Copyright (C) 2017 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+void
+_acb_calc_quad_simple_vec(acb_ptr res, acb_calc_vec_func_t f, void * param,
+    slong num, const acb_t a, const acb_t b, slong prec)
+{
+    acb_t mid, delta, wide;
+    mag_t tmpm;
+
+    acb_init(mid);
+    acb_init(delta);
+    acb_init(wide);
+    mag_init(tmpm);
+
+    /* delta = (b-a)/2 */
+    acb_sub(delta, b, a, prec);
+    acb_mul_2exp_si(delta, delta, -1);
+
+    /* mid = (a+b)/2 */
+    acb_add(mid, a, b, prec);
+    acb_mul_2exp_si(mid, mid, -1);
+
+    /* wide = mid +- [delta] */
+    acb_set(wide, mid);
+    arb_get_mag(tmpm, acb_realref(delta));
+    arb_add_error_mag(acb_realref(wide), tmpm);
+    arb_get_mag(tmpm, acb_imagref(delta));
+    arb_add_error_mag(acb_imagref(wide), tmpm);
+
+    /* Direct evaluation: integral = (b-a) * f([a,b]). */
+    f(res, wide, param, num, 0, prec);
+    _acb_vec_scalar_mul(res, res, num, delta, prec);
+    _acb_vec_scalar_mul_2exp_si(res, res, num, 1);
+
+    acb_clear(mid);
+    acb_clear(delta);
+    acb_clear(wide);
+    mag_clear(tmpm);
+}
@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+typedef struct
+{
+    arb_ptr x;
+    arb_ptr w;
+    slong i;
+    slong prec;
+}
+work_t;
+
+/* several threads request the same degree at once */
+static void
+worker(slong k, work_t * work)
+{
+    acb_calc_gl_node(work->x + k, work->w + k, work->i, k, work->prec);
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("gl_shared_cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200 * arb_test_multiplier(); iter++)
+    {
+        arb_ptr x1, w1, x2, w2;
+        work_t work;
+        slong i, k, n, prec;
+
+        i = n_randint(state, 12);
+        n = _acb_calc_gl_steps[i];
+        prec = 2 + n_randint(state, 300);
+
+        x1 = _arb_vec_init(n);
+        w1 = _arb_vec_init(n);
+        x2 = _arb_vec_init(n);
+        w2 = _arb_vec_init(n);
+
+        if (n_randint(state, 4) == 0)
+            acb_calc_gl_shared_cache_max_bytes = n_randint(state, 20000);
+        else
+            acb_calc_gl_shared_cache_max_bytes = 0;
+
+        flint_set_num_threads(1 + n_randint(state, 8));
+
+        acb_calc_gl_use_shared_cache = 1;
+
+        work.x = x1;
+        work.w = w1;
+        work.i = i;
+        work.prec = prec;
+
+        flint_parallel_do((do_func_t) worker, &work, n, -1, FLINT_PARALLEL_STRIDED);
+
+        if (n_randint(state, 2))
+            acb_calc_gl_node(x2, w2, i, -1, prec);
+
+        acb_calc_gl_use_shared_cache = 0;
+
+        for (k = 0; k < n; k++)
+            acb_calc_gl_node(x2 + k, w2 + k, i, k, prec);
+
+        for (k = 0; k < n; k++)
+        {
+            if (!arb_overlaps(x1 + k, x2 + k) || !arb_overlaps(w1 + k, w2 + k) ||
+                arb_rel_accuracy_bits(x1 + k) < prec - 10)
+            {
+                flint_printf("FAIL\n\n");
+                flint_printf("n = %wd, k = %wd, prec = %wd\n\n", n, k, prec);
+                flint_printf("x1 = "); arb_printn(x1 + k, 50, 0); flint_printf("\n\n");
+                flint_printf("x2 = "); arb_printn(x2 + k, 50, 0); flint_printf("\n\n");
+                flint_printf("w1 = "); arb_printn(w1 + k, 50, 0); flint_printf("\n\n");
+                flint_printf("w2 = "); arb_printn(w2 + k, 50, 0); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        if (n_randint(state, 4) == 0)
+            acb_calc_gl_shared_cache_clear();
+
+        if (n_randint(state, 20) == 0)
+        {
+            acb_calc_gl_shared_cache_max_bytes = 0;
+            acb_calc_gl_shared_cache_prefill(n, prec);
+
+            if (acb_calc_gl_shared_cache_allocated_bytes() == 0)
+            {
+                flint_printf("FAIL (prefill)\n\n");
+                flint_abort();
+            }
+        }
+
+        _arb_vec_clear(x1, n);
+        _arb_vec_clear(w1, n);
+        _arb_vec_clear(x2, n);
+        _arb_vec_clear(w2, n);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -376,6 +376,9 @@ int main()
 
         opt->use_heap = n_randint(state, 2);
 
+        if (n_randint(state, 4) == 0)
+            opt->num_threads = 2 + n_randint(state, 4);
+
         integral = n_randint(state, 9);
 
         if (integral == 0)
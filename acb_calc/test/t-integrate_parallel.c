@@ -0,0 +1,98 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+/* floor(x) sin(x), which has a jump discontinuity at each integer */
+int
+f_floor_sin(acb_ptr res, const acb_t z, void * param, slong order, slong prec)
+{
+    acb_t s;
+
+    if (order > 1)
+        flint_abort();  /* Would be needed for Taylor method. */
+
+    acb_init(s);
+    acb_sin(s, z, prec);
+    acb_real_floor(res, z, order != 0, prec);
+    acb_mul(res, res, s, prec);
+    acb_clear(s);
+
+    return 0;
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("integrate_parallel....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 30 * arb_test_multiplier(); iter++)
+    {
+        acb_t a, b, r1, r2, r3;
+        acb_calc_integrate_opt_t opt;
+        mag_t tol;
+        slong prec, goal;
+        int s1, s2, s3;
+
+        acb_init(a);
+        acb_init(b);
+        acb_init(r1);
+        acb_init(r2);
+        acb_init(r3);
+        mag_init(tol);
+        acb_calc_integrate_opt_init(opt);
+
+        prec = 2 + n_randint(state, 200);
+        goal = prec;
+        mag_set_ui_2exp_si(tol, 1, -prec);
+        acb_zero(a);
+        acb_set_ui(b, 1 + n_randint(state, 20));
+
+        opt->num_threads = 2 + n_randint(state, 6);
+
+        flint_set_num_threads(1);
+        s1 = acb_calc_integrate(r1, f_floor_sin, NULL, a, b, goal, tol, opt, prec);
+        flint_set_num_threads(1 + n_randint(state, 8));
+        s2 = acb_calc_integrate(r2, f_floor_sin, NULL, a, b, goal, tol, opt, prec);
+
+        opt->num_threads = 0;
+        s3 = acb_calc_integrate(r3, f_floor_sin, NULL, a, b, goal, tol, opt, prec);
+
+        /* the parallel result must not depend on the size of the pool */
+        if (!acb_equal(r1, r2) || s1 != s2 || !acb_overlaps(r1, r3))
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("prec = %wd, status = %d %d %d\n\n", prec, s1, s2, s3);
+            flint_printf("b = "); acb_printd(b, 15); flint_printf("\n\n");
+            flint_printf("r1 = "); acb_printd(r1, 30); flint_printf("\n\n");
+            flint_printf("r2 = "); acb_printd(r2, 30); flint_printf("\n\n");
+            flint_printf("r3 = "); acb_printd(r3, 30); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        acb_clear(a);
+        acb_clear(b);
+        acb_clear(r1);
+        acb_clear(r2);
+        acb_clear(r3);
+        mag_clear(tol);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
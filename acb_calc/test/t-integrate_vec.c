@@ -0,0 +1,154 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+/* f_j(z) = sin((j+1) z) */
+int
+f_sin_vec(acb_ptr res, const acb_t z, void * param, slong num, slong order, slong prec)
+{
+    slong j;
+
+    if (order > 1)
+        flint_abort();  /* Would be needed for Taylor method. */
+
+    for (j = 0; j < num; j++)
+    {
+        acb_mul_ui(res + j, z, j + 1, prec);
+        acb_sin(res + j, res + j, prec);
+    }
+
+    return 0;
+}
+
+/* f_j(z) = |z - j/num| */
+int
+f_abs_vec(acb_ptr res, const acb_t z, void * param, slong num, slong order, slong prec)
+{
+    slong j;
+
+    if (order > 1)
+        flint_abort();  /* Would be needed for Taylor method. */
+
+    for (j = 0; j < num; j++)
+    {
+        acb_set_ui(res + j, j);
+        acb_div_ui(res + j, res + j, num, prec);
+        acb_sub(res + j, z, res + j, prec);
+        acb_real_abs(res + j, res + j, order != 0, prec);
+    }
+
+    return 0;
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("integrate_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 300 * arb_test_multiplier(); iter++)
+    {
+        acb_ptr res, ans;
+        acb_t a, b, t;
+        acb_calc_integrate_opt_t opt;
+        mag_t tol;
+        slong j, num, prec, goal;
+        int integral, status;
+
+        flint_set_num_threads(1 + n_randint(state, 3));
+
+        num = 1 + n_randint(state, 8);
+        prec = 2 + n_randint(state, 200);
+        goal = 2 + n_randint(state, 200);
+
+        res = _acb_vec_init(num);
+        ans = _acb_vec_init(num);
+        acb_init(a);
+        acb_init(b);
+        acb_init(t);
+        mag_init(tol);
+        acb_calc_integrate_opt_init(opt);
+
+        mag_set_ui_2exp_si(tol, n_randint(state, 2), -(slong) n_randint(state, 200));
+
+        if (n_randint(state, 2))
+            opt->eval_limit = n_randint(state, 10000);
+        if (n_randint(state, 2))
+            opt->depth_limit = n_randint(state, 100);
+        if (n_randint(state, 2))
+            opt->deg_limit = n_randint(state, 100);
+
+        integral = n_randint(state, 2);
+
+        if (integral == 0)
+        {
+            acb_randtest(a, state, 1 + n_randint(state, 200), 2);
+            acb_randtest(b, state, 1 + n_randint(state, 200), 2);
+
+            for (j = 0; j < num; j++)
+            {
+                acb_mul_ui(t, a, j + 1, prec);
+                acb_cos(ans + j, t, prec);
+                acb_mul_ui(t, b, j + 1, prec);
+                acb_cos(t, t, prec);
+                acb_sub(ans + j, ans + j, t, prec);
+                acb_div_ui(ans + j, ans + j, j + 1, prec);
+            }
+
+            status = acb_calc_integrate_vec(res, f_sin_vec, NULL, num, a, b, goal, tol, opt, prec);
+        }
+        else
+        {
+            /* int_0^1 |x - c| dx = (c^2 + (1-c)^2) / 2 */
+            acb_zero(a);
+            acb_one(b);
+
+            for (j = 0; j < num; j++)
+            {
+                acb_set_ui(ans + j, j * j + (num - j) * (num - j));
+                acb_div_ui(ans + j, ans + j, 2 * num * num, prec);
+            }
+
+            status = acb_calc_integrate_vec(res, f_abs_vec, NULL, num, a, b, goal, tol, opt, prec);
+        }
+
+        for (j = 0; j < num; j++)
+        {
+            if (!acb_overlaps(res + j, ans + j))
+            {
+                flint_printf("FAIL! (iter = %wd, integral = %d, j = %wd)\n", iter, integral, j);
+                flint_printf("num = %wd, prec = %wd, goal = %wd, status = %d\n", num, prec, goal, status);
+                flint_printf("a = "); acb_printd(a, 15); flint_printf("\n\n");
+                flint_printf("b = "); acb_printd(b, 15); flint_printf("\n\n");
+                flint_printf("res = "); acb_printd(res + j, 15); flint_printf("\n\n");
+                flint_printf("ans = "); acb_printd(ans + j, 15); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        _acb_vec_clear(res, num);
+        _acb_vec_clear(ans, num);
+        acb_clear(a);
+        acb_clear(b);
+        acb_clear(t);
+        mag_clear(tol);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
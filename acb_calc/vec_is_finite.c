@@ -0,0 +1,24 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_calc.h"
+
+int
+_acb_calc_vec_is_finite(acb_srcptr vec, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        if (!acb_is_finite(vec + i))
+            return 0;
+
+    return 1;
+}
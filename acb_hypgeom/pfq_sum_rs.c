@@ -19,6 +19,7 @@ acb_hypgeom_pfq_sum_rs(acb_t res, acb_t term, acb_srcptr a, slong p,
     acb_t s, t, u;
     slong i, j, k, m;
     mag_t B, C;
+    arb_arena_struct * arena;
 
     if (n == 0)
     {
@@ -38,7 +39,17 @@ acb_hypgeom_pfq_sum_rs(acb_t res, acb_t term, acb_srcptr a, slong p,
     acb_init(s);
     acb_init(t);
     acb_init(u);
-    zpow = _acb_vec_init(m + 1);
+    arena = arb_arena_scratch();
+
+    if (arena != NULL)
+    {
+        arb_arena_push(arena);
+        zpow = acb_arena_vec(arena, m + 1);
+    }
+    else
+    {
+        zpow = _acb_vec_init(m + 1);
+    }
 
     _acb_vec_set_powers(zpow, z, m + 1, prec);
 
@@ -111,6 +122,10 @@ acb_hypgeom_pfq_sum_rs(acb_t res, acb_t term, acb_srcptr a, slong p,
     acb_clear(s);
     acb_clear(t);
     acb_clear(u);
-    _acb_vec_clear(zpow, m + 1);
+
+    if (arena != NULL)
+        arb_arena_pop(arena);
+    else
+        _acb_vec_clear(zpow, m + 1);
 }
 
@@ -32,6 +32,7 @@ int main()
         n = n_randint(state, 300);
         prec1 = 2 + n_randint(state, 500);
         prec2 = 2 + n_randint(state, 500);
+        arb_use_arena = n_randint(state, 2);
 
         acb_init(z);
         acb_init(s1);
@@ -77,6 +78,8 @@ int main()
         acb_clear(t2);
     }
 
+    arb_use_arena = 0;
+
     flint_randclear(state);
     flint_cleanup();
     flint_printf("PASS\n");
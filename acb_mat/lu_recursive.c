@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2018 Fredrik Johansson
+    Copyright (C) 2018, 2022 Fredrik Johansson
 
     This file is part of Arb.
 
@@ -11,6 +11,9 @@
 
 #include "acb_mat.h"
 
+/* Minimum size for the multithreaded look-ahead algorithm. */
+#define ACB_MAT_LU_THREADED_CUTOFF 64
+
 static void
 _apply_permutation(slong * AP, acb_mat_t A, slong * P,
     slong n, slong offset)
@@ -35,6 +38,135 @@ _apply_permutation(slong * AP, acb_mat_t A, slong * P,
     }
 }
 
+/* Given the factored panel in rows and columns [c, c + w) of LU, applies
+   the panel to the columns [c0, c1) to the right of it. */
+static void
+_acb_mat_lu_panel_update(acb_mat_t LU, slong c, slong w,
+    slong c0, slong c1, slong prec)
+{
+    acb_mat_t L00, A01, A10, A11, T;
+    slong n = acb_mat_nrows(LU);
+
+    if (c0 >= c1)
+        return;
+
+    acb_mat_window_init(L00, LU, c, c, c + w, c + w);
+    acb_mat_window_init(A01, LU, c, c0, c + w, c1);
+    acb_mat_solve_tril(A01, L00, A01, 1, prec);
+
+    if (c + w < n)
+    {
+        acb_mat_window_init(A10, LU, c + w, c, n, c + w);
+        acb_mat_window_init(A11, LU, c + w, c0, n, c1);
+        acb_mat_init(T, n - c - w, c1 - c0);
+        acb_mat_mul(T, A10, A01, prec);
+        acb_mat_sub(A11, A11, T, prec);
+        acb_mat_clear(T);
+        acb_mat_window_clear(A10);
+        acb_mat_window_clear(A11);
+    }
+
+    acb_mat_window_clear(L00);
+    acb_mat_window_clear(A01);
+}
+
+typedef struct
+{
+    acb_mat_struct * LU;
+    slong c;
+    slong w;
+    slong c0;
+    slong c1;
+    slong prec;
+}
+lu_update_work_t;
+
+static void
+_acb_mat_lu_update_worker(void * _work)
+{
+    lu_update_work_t * work = (lu_update_work_t *) _work;
+
+    _acb_mat_lu_panel_update(work->LU, work->c, work->w,
+        work->c0, work->c1, work->prec);
+}
+
+/* Right-looking LU of a square matrix in place, with panels of
+   geometrically decreasing width (matching the column splitting of the
+   recursive algorithm) and a look-ahead of one panel: while the calling
+   thread updates and factors the next panel, the remaining trailing
+   columns are updated by worker threads. */
+static int
+_acb_mat_lu_recursive_threaded(slong * P, acb_mat_t LU, slong prec)
+{
+    slong i, n, c, w, wnext, c0, rest, num_workers;
+    thread_pool_handle * handles;
+    lu_update_work_t * work;
+    acb_mat_t W;
+    slong * P1;
+    int ok;
+
+    n = acb_mat_nrows(LU);
+
+    for (i = 0; i < n; i++)
+        P[i] = i;
+
+    P1 = flint_malloc(sizeof(slong) * n);
+
+    w = n / 2;
+    acb_mat_window_init(W, LU, 0, 0, n, w);
+    ok = acb_mat_lu(P1, W, W, prec);
+    acb_mat_window_clear(W);
+
+    if (ok)
+        _apply_permutation(P, LU, P1, n, 0);
+
+    for (c = 0; ok && c + w < n; c += w, w = wnext)
+    {
+        c0 = c + w;
+        rest = n - c0;
+        wnext = (rest <= 16) ? rest : rest / 2;
+
+        num_workers = flint_request_threads(&handles,
+            FLINT_MIN(flint_get_num_threads(), (rest - wnext) / 8 + 1));
+        work = flint_malloc(sizeof(lu_update_work_t) * FLINT_MAX(num_workers, 1));
+
+        /* Trailing columns beyond the next panel go to the workers. */
+        for (i = 0; i < num_workers; i++)
+        {
+            work[i].LU = LU;
+            work[i].c = c;
+            work[i].w = w;
+            work[i].c0 = c0 + wnext + ((rest - wnext) * i) / num_workers;
+            work[i].c1 = c0 + wnext + ((rest - wnext) * (i + 1)) / num_workers;
+            work[i].prec = prec;
+            thread_pool_wake(global_thread_pool, handles[i], 0,
+                _acb_mat_lu_update_worker, &work[i]);
+        }
+
+        /* Look-ahead: update and factor the next panel. */
+        _acb_mat_lu_panel_update(LU, c, w, c0, c0 + wnext, prec);
+        acb_mat_window_init(W, LU, c0, c0, n, c0 + wnext);
+        ok = acb_mat_lu(P1, W, W, prec);
+        acb_mat_window_clear(W);
+
+        if (num_workers == 0)
+            _acb_mat_lu_panel_update(LU, c, w, c0 + wnext, n, prec);
+
+        for (i = 0; i < num_workers; i++)
+            thread_pool_wait(global_thread_pool, handles[i]);
+
+        flint_give_back_threads(handles, num_workers);
+        flint_free(work);
+
+        if (ok)
+            _apply_permutation(P, LU, P1, rest, c0);
+    }
+
+    flint_free(P1);
+
+    return ok;
+}
+
 int
 acb_mat_lu_recursive(slong * P, acb_mat_t LU, const acb_mat_t A, slong prec)
 {
@@ -53,6 +185,9 @@ acb_mat_lu_recursive(slong * P, acb_mat_t LU, const acb_mat_t A, slong prec)
     if (LU != A)
         acb_mat_set(LU, A);
 
+    if (m == n && n >= ACB_MAT_LU_THREADED_CUTOFF && flint_get_num_threads() > 1)
+        return _acb_mat_lu_recursive_threaded(P, LU, prec);
+
     n1 = n / 2;
 
     for (i = 0; i < m; i++)
@@ -170,6 +170,77 @@ int main()
         _perm_clear(perm);
     }
 
+    /* Large diagonally dominant matrices, exercising the multithreaded
+       algorithm. */
+    for (iter = 0; iter < 5 * arb_test_multiplier(); iter++)
+    {
+        fmpq_mat_t Q;
+        acb_mat_t A, LU, P, L, U, T;
+        slong i, j, n, qbits, prec, *perm;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        n = 64 + n_randint(state, 40);
+        qbits = 1 + n_randint(state, 20);
+        prec = 128 + n_randint(state, 200);
+
+        fmpq_mat_init(Q, n, n);
+        acb_mat_init(A, n, n);
+        acb_mat_init(LU, n, n);
+        acb_mat_init(P, n, n);
+        acb_mat_init(L, n, n);
+        acb_mat_init(U, n, n);
+        acb_mat_init(T, n, n);
+        perm = _perm_init(n);
+
+        fmpq_mat_randtest(Q, state, qbits);
+        for (i = 0; i < n; i++)
+            fmpq_add_si(fmpq_mat_entry(Q, i, i), fmpq_mat_entry(Q, i, i),
+                2 * n * (WORD(1) << qbits));
+
+        acb_mat_set_fmpq_mat(A, Q, prec);
+
+        if (!acb_mat_lu_recursive(perm, LU, A, prec))
+        {
+            flint_printf("FAIL (threaded, failed to converge)\n");
+            flint_printf("n = %wd, prec = %wd, threads = %d\n",
+                n, prec, flint_get_num_threads());
+            flint_abort();
+        }
+
+        acb_mat_one(L);
+        for (i = 0; i < n; i++)
+            for (j = 0; j < i; j++)
+                acb_set(acb_mat_entry(L, i, j), acb_mat_entry(LU, i, j));
+
+        for (i = 0; i < n; i++)
+            for (j = i; j < n; j++)
+                acb_set(acb_mat_entry(U, i, j), acb_mat_entry(LU, i, j));
+
+        for (i = 0; i < n; i++)
+            acb_one(acb_mat_entry(P, perm[i], i));
+
+        acb_mat_mul(T, P, L, prec);
+        acb_mat_mul(T, T, U, prec);
+
+        if (!acb_mat_contains_fmpq_mat(T, Q))
+        {
+            flint_printf("FAIL (threaded, containment)\n");
+            flint_printf("n = %wd, prec = %wd, threads = %d\n",
+                n, prec, flint_get_num_threads());
+            flint_abort();
+        }
+
+        fmpq_mat_clear(Q);
+        acb_mat_clear(A);
+        acb_mat_clear(LU);
+        acb_mat_clear(P);
+        acb_mat_clear(L);
+        acb_mat_clear(U);
+        acb_mat_clear(T);
+        _perm_clear(perm);
+    }
+
     flint_randclear(state);
     flint_cleanup();
     flint_printf("PASS\n");
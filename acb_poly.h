@@ -524,6 +524,37 @@ void _acb_poly_tree_free(acb_ptr * tree, slong len);
 void
 _acb_poly_tree_build(acb_ptr * tree, acb_srcptr roots, slong len, slong prec);
 
+/* Precomputed points for multipoint evaluation and interpolation */
+
+typedef struct
+{
+    acb_ptr * tree;
+    acb_ptr weights;
+    slong len;
+    slong prec;
+}
+acb_poly_multipoint_struct;
+
+typedef acb_poly_multipoint_struct acb_poly_multipoint_t[1];
+
+void acb_poly_multipoint_init(acb_poly_multipoint_t mp,
+    acb_srcptr xs, slong n, slong prec);
+
+void acb_poly_multipoint_clear(acb_poly_multipoint_t mp);
+
+void acb_poly_multipoint_precompute_weights(acb_poly_multipoint_t mp);
+
+slong acb_poly_multipoint_allocated_bytes(const acb_poly_multipoint_t mp);
+
+void acb_poly_multipoint_evaluate(acb_ptr ys, const acb_poly_multipoint_t mp,
+    const acb_poly_t poly, slong prec);
+
+void acb_poly_multipoint_evaluate_vec(acb_ptr ys, const acb_poly_multipoint_t mp,
+    const acb_poly_struct * polys, slong num, slong prec);
+
+void acb_poly_multipoint_interpolate(acb_poly_t poly, acb_poly_multipoint_t mp,
+    acb_srcptr ys, slong prec);
+
 
 void _acb_poly_root_inclusion(acb_t r, const acb_t m,
     acb_srcptr poly,
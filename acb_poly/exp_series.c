@@ -23,9 +23,20 @@ _acb_poly_exp_series_newton(acb_ptr f, acb_ptr g,
 {
     slong alloc;
     acb_ptr T, U, hprime;
+    arb_arena_struct * arena;
 
     alloc = 3 * len;
-    T = _acb_vec_init(alloc);
+    arena = arb_arena_scratch();
+
+    if (arena != NULL)
+    {
+        arb_arena_push(arena);
+        T = acb_arena_vec(arena, alloc);
+    }
+    else
+    {
+        T = _acb_vec_init(alloc);
+    }
     U = T + len;
     hprime = U + len;
 
@@ -78,7 +89,10 @@ _acb_poly_exp_series_newton(acb_ptr f, acb_ptr g,
 
     NEWTON_END
 
-    _acb_vec_clear(T, alloc);
+    if (arena != NULL)
+        arb_arena_pop(arena);
+    else
+        _acb_vec_clear(T, alloc);
 }
 
 void
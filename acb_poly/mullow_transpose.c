@@ -11,14 +11,39 @@
 
 #include "acb_poly.h"
 
+/* Minimum n * prec for computing the real products in parallel. */
+#define THREADED_CUTOFF 20000
+
+typedef struct
+{
+    arb_ptr z[4];
+    arb_srcptr x[4];
+    arb_srcptr y[4];
+    slong len1;
+    slong len2;
+    slong n;
+    slong prec;
+}
+transpose_work_t;
+
+static void
+_acb_poly_mullow_transpose_worker(slong i, void * arg)
+{
+    transpose_work_t * work = (transpose_work_t *) arg;
+
+    _arb_poly_mullow(work->z[i], work->x[i], work->len1,
+        work->y[i], work->len2, work->n, work->prec);
+}
+
 void
 _acb_poly_mullow_transpose(acb_ptr res,
     acb_srcptr poly1, slong len1,
     acb_srcptr poly2, slong len2, slong n, slong prec)
 {
     arb_ptr a, b, c, d, e, f, w;
-    arb_ptr t;
+    arb_ptr t, u;
     slong i;
+    int squaring;
 
     len1 = FLINT_MIN(len1, n);
     len2 = FLINT_MIN(len2, n);
@@ -52,20 +77,55 @@ _acb_poly_mullow_transpose(acb_ptr res,
         f[i] = *acb_imagref(res + i);
     }
 
-    _arb_poly_mullow(e, a, len1, c, len2, n, prec);
-    _arb_poly_mullow(t, b, len1, d, len2, n, prec);
-    _arb_vec_sub(e, e, t, n, prec);
+    squaring = (poly1 == poly2 && len1 == len2);
 
-    _arb_poly_mullow(f, a, len1, d, len2, n, prec);
-    /* squaring */
-    if (poly1 == poly2 && len1 == len2)
+    /* the real products are independent; when threads are available,
+       compute them in parallel (this gives the same result since each
+       product is computed in the same way as in the serial code) */
+    if (flint_get_num_threads() > 1 && n * FLINT_MAX(prec, FLINT_BITS) >= THREADED_CUTOFF)
     {
-        _arb_vec_scalar_mul_2exp_si(f, f, n, 1);
+        transpose_work_t work;
+
+        u = _arb_vec_init(n);
+
+        work.z[0] = e; work.x[0] = a; work.y[0] = c;
+        work.z[1] = t; work.x[1] = b; work.y[1] = d;
+        work.z[2] = f; work.x[2] = a; work.y[2] = d;
+        work.z[3] = u; work.x[3] = b; work.y[3] = c;
+        work.len1 = len1;
+        work.len2 = len2;
+        work.n = n;
+        work.prec = prec;
+
+        flint_parallel_do(_acb_poly_mullow_transpose_worker, &work,
+            squaring ? 3 : 4, -1, FLINT_PARALLEL_STRIDED);
+
+        _arb_vec_sub(e, e, t, n, prec);
+
+        if (squaring)
+            _arb_vec_scalar_mul_2exp_si(f, f, n, 1);
+        else
+            _arb_vec_add(f, f, u, n, prec);
+
+        _arb_vec_clear(u, n);
     }
     else
     {
-        _arb_poly_mullow(t, b, len1, c, len2, n, prec);
-        _arb_vec_add(f, f, t, n, prec);
+        _arb_poly_mullow(e, a, len1, c, len2, n, prec);
+        _arb_poly_mullow(t, b, len1, d, len2, n, prec);
+        _arb_vec_sub(e, e, t, n, prec);
+
+        _arb_poly_mullow(f, a, len1, d, len2, n, prec);
+
+        if (squaring)
+        {
+            _arb_vec_scalar_mul_2exp_si(f, f, n, 1);
+        }
+        else
+        {
+            _arb_poly_mullow(t, b, len1, c, len2, n, prec);
+            _arb_vec_add(f, f, t, n, prec);
+        }
     }
 
     for (i = 0; i < n; i++)
@@ -0,0 +1,65 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_poly.h"
+
+void
+acb_poly_multipoint_init(acb_poly_multipoint_t mp,
+    acb_srcptr xs, slong n, slong prec)
+{
+    mp->tree = _acb_poly_tree_alloc(n);
+    _acb_poly_tree_build(mp->tree, xs, n, prec);
+    mp->weights = NULL;
+    mp->len = n;
+    mp->prec = prec;
+}
+
+void
+acb_poly_multipoint_clear(acb_poly_multipoint_t mp)
+{
+    _acb_poly_tree_free(mp->tree, mp->len);
+
+    if (mp->weights != NULL)
+        _acb_vec_clear(mp->weights, mp->len);
+}
+
+void
+acb_poly_multipoint_precompute_weights(acb_poly_multipoint_t mp)
+{
+    if (mp->weights == NULL)
+    {
+        mp->weights = _acb_vec_init(mp->len);
+        _acb_poly_interpolation_weights(mp->weights, mp->tree, mp->len, mp->prec);
+    }
+}
+
+slong
+acb_poly_multipoint_allocated_bytes(const acb_poly_multipoint_t mp)
+{
+    slong i, height, len, size;
+
+    len = mp->len;
+    size = 0;
+
+    if (len != 0)
+    {
+        height = FLINT_CLOG2(len);
+        size += (height + 1) * sizeof(acb_ptr);
+
+        for (i = 0; i <= height; i++)
+            size += _acb_vec_allocated_bytes(mp->tree[i], len + (len >> i) + 1);
+    }
+
+    if (mp->weights != NULL)
+        size += _acb_vec_allocated_bytes(mp->weights, len);
+
+    return size;
+}
@@ -0,0 +1,33 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_poly.h"
+
+void
+acb_poly_multipoint_interpolate(acb_poly_t poly, acb_poly_multipoint_t mp,
+    acb_srcptr ys, slong prec)
+{
+    slong n = mp->len;
+
+    if (n == 0)
+    {
+        acb_poly_zero(poly);
+    }
+    else
+    {
+        acb_poly_multipoint_precompute_weights(mp);
+        acb_poly_fit_length(poly, n);
+        _acb_poly_set_length(poly, n);
+        _acb_poly_interpolate_fast_precomp(poly->coeffs, ys, mp->tree,
+            mp->weights, n, prec);
+        _acb_poly_normalise(poly);
+    }
+}
@@ -0,0 +1,86 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_poly.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("evaluate_vec_fast_threaded....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* the threaded and serial versions must give identical results */
+    for (iter = 0; iter < 50 * arb_test_multiplier(); iter++)
+    {
+        slong i, n, prec;
+        acb_poly_t f, g, h;
+        acb_ptr x, y, z;
+
+        n = 1 + n_randint(state, 300);
+        prec = 2 + n_randint(state, 300);
+
+        acb_poly_init(f);
+        acb_poly_init(g);
+        acb_poly_init(h);
+        x = _acb_vec_init(n);
+        y = _acb_vec_init(n);
+        z = _acb_vec_init(n);
+
+        acb_poly_randtest(f, state, 1 + n_randint(state, 400), 1 + n_randint(state, 200), 5);
+        for (i = 0; i < n; i++)
+            acb_randtest(x + i, state, 1 + n_randint(state, 200), 3);
+
+        flint_set_num_threads(1);
+        acb_poly_evaluate_vec_fast(y, f, x, n, prec);
+        acb_poly_interpolate_fast(g, x, y, n, prec);
+
+        flint_set_num_threads(2 + n_randint(state, 7));
+        acb_poly_evaluate_vec_fast(z, f, x, n, prec);
+        acb_poly_interpolate_fast(h, x, y, n, prec);
+
+        for (i = 0; i < n; i++)
+        {
+            if (!acb_equal(y + i, z + i))
+            {
+                flint_printf("FAIL (evaluation, %wd of %wd)\n\n", i, n);
+                flint_printf("f = "); acb_poly_printd(f, 15); flint_printf("\n\n");
+                flint_printf("x = "); acb_printd(x + i, 15); flint_printf("\n\n");
+                flint_printf("y = "); acb_printd(y + i, 15); flint_printf("\n\n");
+                flint_printf("z = "); acb_printd(z + i, 15); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        if (!acb_poly_equal(g, h))
+        {
+            flint_printf("FAIL (interpolation)\n\n");
+            flint_printf("g = "); acb_poly_printd(g, 15); flint_printf("\n\n");
+            flint_printf("h = "); acb_poly_printd(h, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        acb_poly_clear(f);
+        acb_poly_clear(g);
+        acb_poly_clear(h);
+        _acb_vec_clear(x, n);
+        _acb_vec_clear(y, n);
+        _acb_vec_clear(z, n);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -37,6 +37,8 @@ int main()
             acb_poly_newton_exp_cutoff = 5 + n_randint(state, 50);
         }
 
+        arb_use_arena = n_randint(state, 2);
+
         if (n_randint(state, 100) == 0)
         {
             m = 1 + n_randint(state, 100);
@@ -84,6 +86,8 @@ int main()
         acb_poly_clear(d);
     }
 
+    arb_use_arena = 0;
+
     flint_randclear(state);
     flint_cleanup();
     flint_printf("PASS\n");
@@ -0,0 +1,81 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_poly.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("mullow_threaded....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 20 * arb_test_multiplier(); iter++)
+    {
+        acb_poly_t a, b, c, d;
+        slong len, n, prec, bits;
+        int squaring;
+
+        len = 256 + n_randint(state, 1000);
+        n = 1 + n_randint(state, 2 * len);
+        prec = 2 + n_randint(state, 3000);
+        bits = 2 + n_randint(state, 3000);
+        squaring = n_randint(state, 2);
+
+        acb_poly_init(a);
+        acb_poly_init(b);
+        acb_poly_init(c);
+        acb_poly_init(d);
+
+        acb_poly_randtest(a, state, len, bits, 5);
+        acb_poly_randtest(b, state, len - n_randint(state, len / 2), bits, 5);
+
+        if (squaring)
+            acb_poly_set(b, a);
+
+        flint_set_num_threads(1);
+        if (squaring)
+            acb_poly_mullow(c, a, a, n, prec);
+        else
+            acb_poly_mullow(c, a, b, n, prec);
+
+        flint_set_num_threads(2 + n_randint(state, 7));
+        if (squaring)
+            acb_poly_mullow(d, a, a, n, prec);
+        else
+            acb_poly_mullow(d, a, b, n, prec);
+
+        if (!acb_poly_equal(c, d))
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("len = %wd, n = %wd, prec = %wd, squaring = %d\n\n",
+                len, n, prec, squaring);
+            flint_printf("a = "); acb_poly_printd(a, 15); flint_printf("\n\n");
+            flint_printf("b = "); acb_poly_printd(b, 15); flint_printf("\n\n");
+            flint_printf("c = "); acb_poly_printd(c, 15); flint_printf("\n\n");
+            flint_printf("d = "); acb_poly_printd(d, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        acb_poly_clear(a);
+        acb_poly_clear(b);
+        acb_poly_clear(c);
+        acb_poly_clear(d);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
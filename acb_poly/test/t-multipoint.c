@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "acb_poly.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("multipoint....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000 * arb_test_multiplier(); iter++)
+    {
+        acb_poly_multipoint_t mp;
+        acb_poly_struct * polys;
+        acb_poly_t g, h;
+        acb_ptr x, y, z;
+        slong i, j, n, num, prec;
+
+        n = n_randint(state, 40);
+        num = 1 + n_randint(state, 5);
+        prec = 2 + n_randint(state, 200);
+
+        if (n_randint(state, 10) == 0)
+            flint_set_num_threads(1 + n_randint(state, 4));
+        else
+            flint_set_num_threads(1);
+
+        polys = flint_malloc(sizeof(acb_poly_struct) * num);
+        for (j = 0; j < num; j++)
+        {
+            acb_poly_init(polys + j);
+            acb_poly_randtest(polys + j, state, n_randint(state, 50), 1 + n_randint(state, 200), 5);
+        }
+
+        acb_poly_init(g);
+        acb_poly_init(h);
+        x = _acb_vec_init(n);
+        y = _acb_vec_init(n * num);
+        z = _acb_vec_init(n);
+
+        for (i = 0; i < n; i++)
+            acb_randtest(x + i, state, 1 + n_randint(state, 200), 3);
+
+        acb_poly_multipoint_init(mp, x, n, prec);
+
+        if (n != 0 && acb_poly_multipoint_allocated_bytes(mp) <= 0)
+        {
+            flint_printf("FAIL (allocated_bytes)\n\n");
+            flint_abort();
+        }
+
+        acb_poly_multipoint_evaluate_vec(y, mp, polys, num, prec);
+
+        for (j = 0; j < num; j++)
+        {
+            acb_poly_evaluate_vec_fast(z, polys + j, x, n, prec);
+
+            for (i = 0; i < n; i++)
+            {
+                if (!acb_equal(y + j * n + i, z + i))
+                {
+                    flint_printf("FAIL (evaluation)\n\n");
+                    flint_printf("n = %wd, j = %wd, i = %wd\n\n", n, j, i);
+                    flint_printf("y = "); acb_printd(y + j * n + i, 15); flint_printf("\n\n");
+                    flint_printf("z = "); acb_printd(z + i, 15); flint_printf("\n\n");
+                    flint_abort();
+                }
+            }
+        }
+
+        acb_poly_multipoint_interpolate(g, mp, y, prec);
+        acb_poly_interpolate_fast(h, x, y, n, prec);
+
+        if (!acb_poly_equal(g, h))
+        {
+            flint_printf("FAIL (interpolation)\n\n");
+            flint_printf("g = "); acb_poly_printd(g, 15); flint_printf("\n\n");
+            flint_printf("h = "); acb_poly_printd(h, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        /* interpolating the values of a short polynomial recovers it */
+        if (n != 0 && polys[0].length <= n && !acb_poly_contains(g, polys + 0))
+        {
+            flint_printf("FAIL (containment)\n\n");
+            flint_printf("f = "); acb_poly_printd(polys + 0, 15); flint_printf("\n\n");
+            flint_printf("g = "); acb_poly_printd(g, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        acb_poly_multipoint_clear(mp);
+
+        for (j = 0; j < num; j++)
+            acb_poly_clear(polys + j);
+        flint_free(polys);
+
+        acb_poly_clear(g);
+        acb_poly_clear(h);
+        _acb_vec_clear(x, n);
+        _acb_vec_clear(y, n * num);
+        _acb_vec_clear(z, n);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
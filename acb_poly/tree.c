@@ -40,12 +40,64 @@ void _acb_poly_tree_free(acb_ptr * tree, slong len)
     }
 }
 
+/* Minimum number of points for building the levels of the tree
+   with several threads. */
+#define TREE_THREADED_CUTOFF 64
+
+/* Multiplies the two children of node k on level i, writing the
+   result to node k on level i + 1. The nodes on each level are
+   independent. */
+static void
+_acb_poly_tree_build_node(acb_ptr * tree, slong i, slong k, slong len, slong prec)
+{
+    slong pow, left;
+    acb_ptr pa, pb;
+
+    pow = WORD(1) << i;
+    left = len - k * 2 * pow;
+    pa = tree[i] + k * (2 * pow + 2);
+    pb = tree[i + 1] + k * (2 * pow + 1);
+
+    if (left >= 2 * pow)
+        _acb_poly_mul_monic(pb, pa, pow + 1, pa + pow + 1, pow + 1, prec);
+    else if (left > pow)
+        _acb_poly_mul_monic(pb, pa, pow + 1, pa + pow + 1, left - pow + 1, prec);
+    else if (left > 0)
+        _acb_vec_set(pb, pa, left + 1);
+}
+
+typedef struct
+{
+    acb_ptr * tree;
+    slong level;
+    slong len;
+    slong prec;
+    slong num_nodes;
+    slong num_chunks;
+}
+tree_work_t;
+
+static void
+_acb_poly_tree_build_worker(slong j, void * arg)
+{
+    tree_work_t * work = (tree_work_t *) arg;
+    slong k, k1, k2;
+
+    k1 = (j * work->num_nodes) / work->num_chunks;
+    k2 = ((j + 1) * work->num_nodes) / work->num_chunks;
+
+    for (k = k1; k < k2; k++)
+        _acb_poly_tree_build_node(work->tree, work->level, k,
+            work->len, work->prec);
+}
+
 void
 _acb_poly_tree_build(acb_ptr * tree, acb_srcptr roots, slong len, slong prec)
 {
-    slong height, pow, left, i;
-    acb_ptr pa, pb;
+    slong height, pow, i, k, num_nodes, num_threads;
+    acb_ptr pa;
     acb_srcptr a, b;
+    tree_work_t work;
 
     if (len == 0)
         return;
@@ -82,26 +134,29 @@ _acb_poly_tree_build(acb_ptr * tree, acb_srcptr roots, slong len, slong prec)
         }
     }
 
+    num_threads = (len >= TREE_THREADED_CUTOFF) ? flint_get_num_threads() : 1;
+
     for (i = 1; i < height - 1; i++)
     {
-        left = len;
         pow = WORD(1) << i;
-        pa = tree[i];
-        pb = tree[i + 1];
+        num_nodes = (len + 2 * pow - 1) / (2 * pow);
 
-        while (left >= 2 * pow)
+        work.tree = tree;
+        work.level = i;
+        work.len = len;
+        work.prec = prec;
+        work.num_nodes = num_nodes;
+        work.num_chunks = FLINT_MIN(num_threads, num_nodes);
+
+        if (work.num_chunks > 1)
         {
-            _acb_poly_mul_monic(pb, pa, pow + 1, pa + pow + 1, pow + 1, prec);
-            left -= 2 * pow;
-            pa += 2 * pow + 2;
-            pb += 2 * pow + 1;
+            flint_parallel_do(_acb_poly_tree_build_worker, &work,
+                work.num_chunks, -1, FLINT_PARALLEL_STRIDED);
         }
-
-        if (left > pow)
+        else
         {
-            _acb_poly_mul_monic(pb, pa, pow + 1, pa + pow + 1, left - pow + 1, prec);
+            for (k = 0; k < num_nodes; k++)
+                _acb_poly_tree_build_node(tree, i, k, len, prec);
         }
-        else if (left > 0)
-            _acb_vec_set(pb, pa, left + 1);
     }
 }
@@ -67,6 +67,42 @@ void arb_clear(arb_t x);
 arb_ptr _arb_vec_init(slong n);
 void _arb_vec_clear(arb_ptr v, slong n);
 
+/* arenas for temporary vectors */
+
+typedef struct
+{
+    void * data;
+    slong used;
+    slong alloc;
+}
+arb_arena_chunk_struct;
+
+typedef struct arb_arena_struct
+{
+    arb_arena_chunk_struct * vecs;      /* storage for arb_structs */
+    slong vecs_num;
+    slong vecs_cur;
+    arb_arena_chunk_struct * limbs;     /* storage for mantissas */
+    slong limbs_num;
+    slong limbs_cur;
+    slong * marks;                      /* 4 entries per open scope */
+    slong depth;
+    slong marks_alloc;
+    struct arb_arena_struct * prev;     /* enclosing active arena */
+}
+arb_arena_struct;
+
+typedef arb_arena_struct arb_arena_t[1];
+
+ARB_DLL extern int arb_use_arena;
+
+void arb_arena_init(arb_arena_t A);
+void arb_arena_clear(arb_arena_t A);
+void arb_arena_push(arb_arena_t A);
+void arb_arena_pop(arb_arena_t A);
+arb_ptr arb_arena_vec(arb_arena_t A, slong n);
+arb_arena_struct * arb_arena_scratch(void);
+
 ARB_INLINE arf_ptr arb_mid_ptr(arb_t z) { return arb_midref(z); }
 ARB_INLINE mag_ptr arb_rad_ptr(arb_t z) { return arb_radref(z); }
 
@@ -438,6 +474,8 @@ void arb_dot_precise(arb_t res, const arb_t initial, int subtract,
 void arb_dot(arb_t res, const arb_t initial, int subtract,
     arb_srcptr x, slong xstep, arb_srcptr y, slong ystep, slong len, slong prec);
 
+ARB_DLL extern int arb_dot_use_threads;
+
 void arb_approx_dot(arb_t res, const arb_t initial, int subtract,
     arb_srcptr x, slong xstep, arb_srcptr y, slong ystep, slong len, slong prec);
 
@@ -626,9 +664,53 @@ arb_sqr(arb_t res, const arb_t val, slong prec)
     arb_mul(res, val, val, prec);
 }
 
+/* process-wide constant cache, used when arb_use_shared_constants is set */
+
+typedef struct arb_shared_const_struct
+{
+    struct _arb_shared_const_value * head;
+    void * lock;
+    struct arb_shared_const_struct * next;
+    const char * name;
+}
+arb_shared_const_struct;
+
+ARB_DLL extern int arb_use_shared_constants;
+
+void _arb_shared_const_get(arb_t x, arb_shared_const_struct * c,
+    void (*comp_func)(arb_t, slong), slong prec);
+
+void arb_shared_constants_clear(void);
+
+/* ownership of the process-wide caches (see shared_state.c) */
+void _arb_shared_state_hold(void);
+void _arb_shared_state_register(void (*clear_func)(void));
+
+/* publishing immutable data read by other threads without locking:
+   acquire loads and release stores of a pointer or an slong */
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#define _ARB_SHARED_LOAD_PTR(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define _ARB_SHARED_STORE_PTR(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define _ARB_SHARED_LOAD_SI(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define _ARB_SHARED_STORE_SI(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+void * _arb_shared_load_ptr(void * const * p);
+void _arb_shared_store_ptr(void ** p, void * v);
+slong _arb_shared_load_si(const slong * p);
+void _arb_shared_store_si(slong * p, slong v);
+#define _ARB_SHARED_LOAD_PTR(p) _arb_shared_load_ptr((void * const *) (p))
+#define _ARB_SHARED_STORE_PTR(p, v) _arb_shared_store_ptr((void **) (p), (v))
+#define _ARB_SHARED_LOAD_SI(p) _arb_shared_load_si(p)
+#define _ARB_SHARED_STORE_SI(p, v) _arb_shared_store_si((p), (v))
+#endif
+
+/* warm start from a cache file loaded with arb_cache_load (see arb_cache.h) */
+slong _arb_cache_const_lookup(arb_t res, const char * name, slong prec);
+
 #define ARB_DEF_CACHED_CONSTANT(name, comp_func) \
     TLS_PREFIX slong name ## _cached_prec = 0; \
     TLS_PREFIX arb_t name ## _cached_value; \
+    arb_shared_const_struct name ## _shared = { NULL, NULL, NULL, #name }; \
     void name ## _cleanup(void) \
     { \
         arb_clear(name ## _cached_value); \
@@ -636,6 +718,11 @@ arb_sqr(arb_t res, const arb_t val, slong prec)
     } \
     void name(arb_t x, slong prec) \
     { \
+        if (arb_use_shared_constants) \
+        { \
+            _arb_shared_const_get(x, &name ## _shared, comp_func, prec); \
+            return; \
+        } \
         if (name ## _cached_prec < prec) \
         { \
             if (name ## _cached_prec == 0) \
@@ -643,8 +730,13 @@ arb_sqr(arb_t res, const arb_t val, slong prec)
                 arb_init(name ## _cached_value); \
                 flint_register_cleanup_function(name ## _cleanup); \
             } \
-            comp_func(name ## _cached_value, prec + 32); \
-            name ## _cached_prec = prec; \
+            name ## _cached_prec = _arb_cache_const_lookup( \
+                name ## _cached_value, #name, prec); \
+            if (name ## _cached_prec == 0) \
+            { \
+                comp_func(name ## _cached_value, prec + 32); \
+                name ## _cached_prec = prec; \
+            } \
         } \
         arb_set_round(x, name ## _cached_value, prec); \
     }
@@ -816,6 +908,14 @@ _arb_vec_bits(arb_srcptr x, slong len)
 
 void _arb_vec_set_powers(arb_ptr xs, const arb_t x, slong len, slong prec);
 
+slong _arb_vec_elementary_block_size(slong len, slong prec);
+void _arb_vec_elementary(arb_ptr res1, arb_ptr res2, arb_srcptr x, slong len,
+    void (*func1)(arb_t, const arb_t, slong),
+    void (*func2)(arb_t, arb_t, const arb_t, slong), slong prec);
+void _arb_vec_exp(arb_ptr res, arb_srcptr x, slong len, slong prec);
+void _arb_vec_log(arb_ptr res, arb_srcptr x, slong len, slong prec);
+void _arb_vec_sin_cos(arb_ptr s, arb_ptr c, arb_srcptr x, slong len, slong prec);
+
 ARB_INLINE void
 _arb_vec_add_error_arf_vec(arb_ptr res, arf_srcptr err, slong len)
 {
@@ -1016,6 +1116,32 @@ void _arb_atan_sum_bs_powtab(fmpz_t T, fmpz_t Q, flint_bitcnt_t * Qexp,
 
 void arb_atan_arf_bb(arb_t z, const arf_t x, slong prec);
 
+/* runtime-generated tables for ARB_*_TAB2_PREC < prec <= ARB_EXT_TAB_PREC */
+
+#define ARB_EXT_TAB_PREC 32768
+#define ARB_EXT_TAB_MIN_PREC 8192
+
+#define ARB_EXT_TAB1_BITS 5
+#define ARB_EXT_TAB2_BITS 5
+
+#define ARB_EXT_TAB_EXP1 0
+#define ARB_EXT_TAB_EXP2 1
+#define ARB_EXT_TAB_SIN_COS1 2
+#define ARB_EXT_TAB_SIN_COS2 3
+#define ARB_EXT_TAB_ATAN1 4
+#define ARB_EXT_TAB_ATAN2 5
+#define ARB_EXT_TAB_NUM 6
+
+ARB_DLL extern int arb_use_extended_tables;
+
+mp_srcptr _arb_ext_tab(slong * limbs, int which, slong prec);
+void _arb_ext_tab_get(arb_t res, mp_srcptr tab, slong limbs, slong i, slong prec);
+void arb_extended_tables_clear(void);
+
+void arb_exp_arf_ext(arb_t z, const arf_t x, slong prec, int minus_one);
+void arb_sin_cos_arf_ext(arb_t res_sin, arb_t res_cos, const arf_t x, slong prec);
+void arb_atan_arf_ext(arb_t z, const arf_t x, slong prec);
+
 ARB_INLINE slong
 arb_allocated_bytes(const arb_t x)
 {
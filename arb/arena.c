@@ -0,0 +1,326 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+/*
+  Vectors and mantissas are bump-allocated from two lists of chunks.
+  Chunks after the current one are always empty, and are reused (or
+  replaced by larger ones) when the current chunk fills up. Each open
+  scope stores the positions (current chunk, used entries) of both lists
+  so that pop can rewind them.
+
+  Only entries created in the innermost scope of the innermost active
+  arena of the thread get mantissas from the arena; this guarantees that
+  the limbs are not released before the entries themselves. Everything
+  else falls back to the ordinary allocator, and such mantissas are freed
+  by arb_clear when the scope is popped.
+*/
+
+#define ARB_ARENA_MIN_VECS 64
+#define ARB_ARENA_MIN_LIMBS 1024
+#define ARB_ARENA_MAX_KEEP (WORD(1) << 24)
+
+int arb_use_arena = 0;
+
+static FLINT_TLS_PREFIX arb_arena_struct * arb_arena_active = NULL;
+
+static FLINT_TLS_PREFIX arb_arena_t arb_arena_thread;
+static FLINT_TLS_PREFIX int arb_arena_thread_init = 0;
+
+void
+arb_arena_init(arb_arena_t A)
+{
+    A->vecs = NULL;
+    A->vecs_num = 0;
+    A->vecs_cur = 0;
+    A->limbs = NULL;
+    A->limbs_num = 0;
+    A->limbs_cur = 0;
+    A->marks = NULL;
+    A->depth = 0;
+    A->marks_alloc = 0;
+    A->prev = NULL;
+}
+
+static void
+_arb_arena_chunks_free(arb_arena_chunk_struct ** chunks, slong * num, slong * cur)
+{
+    slong i;
+
+    for (i = 0; i < *num; i++)
+        flint_free((*chunks)[i].data);
+
+    flint_free(*chunks);
+    *chunks = NULL;
+    *num = 0;
+    *cur = 0;
+}
+
+void
+arb_arena_clear(arb_arena_t A)
+{
+    if (A->depth != 0)
+    {
+        flint_printf("arb_arena_clear: scope still open\n");
+        flint_abort();
+    }
+
+    _arb_arena_chunks_free(&A->vecs, &A->vecs_num, &A->vecs_cur);
+    _arb_arena_chunks_free(&A->limbs, &A->limbs_num, &A->limbs_cur);
+    flint_free(A->marks);
+}
+
+static void *
+_arb_arena_bump(arb_arena_chunk_struct ** chunks, slong * num, slong * cur,
+    slong n, size_t size, slong min_alloc)
+{
+    arb_arena_chunk_struct * c;
+    slong alloc;
+
+    if (*num != 0)
+    {
+        c = *chunks + *cur;
+
+        if (c->alloc - c->used >= n)
+        {
+            c->used += n;
+            return (char *) c->data + (c->used - n) * size;
+        }
+
+        (*cur)++;
+    }
+
+    if (*cur == *num)
+    {
+        *chunks = flint_realloc(*chunks, (*num + 1) * sizeof(arb_arena_chunk_struct));
+        c = *chunks + *num;
+        c->data = NULL;
+        c->used = 0;
+        c->alloc = 0;
+        (*num)++;
+    }
+
+    c = *chunks + *cur;
+
+    /* the chunk is empty, so it can be replaced */
+    if (c->alloc < n)
+    {
+        alloc = FLINT_MAX(n, min_alloc);
+        if (*cur > 0)
+            alloc = FLINT_MAX(alloc, 2 * (*chunks)[*cur - 1].alloc);
+
+        flint_free(c->data);
+        c->data = flint_malloc(alloc * size);
+        c->alloc = alloc;
+    }
+
+    c->used = n;
+    return c->data;
+}
+
+static void
+_arb_arena_rewind(arb_arena_chunk_struct * chunks, slong num, slong * cur,
+    slong mark_cur, slong mark_used)
+{
+    slong i;
+
+    if (num == 0)
+        return;
+
+    for (i = mark_cur + 1; i <= *cur; i++)
+        chunks[i].used = 0;
+
+    *cur = mark_cur;
+    chunks[mark_cur].used = mark_used;
+}
+
+/* replaces several chunks by a single one, or frees everything if
+   too much memory is held */
+static void
+_arb_arena_chunks_trim(arb_arena_chunk_struct ** chunks, slong * num,
+    slong * cur, size_t size)
+{
+    slong i, total;
+
+    total = 0;
+    for (i = 0; i < *num; i++)
+        total += (*chunks)[i].alloc;
+
+    if (*num > 1 || total * size > ARB_ARENA_MAX_KEEP)
+    {
+        _arb_arena_chunks_free(chunks, num, cur);
+
+        if (total * size <= ARB_ARENA_MAX_KEEP)
+        {
+            *chunks = flint_malloc(sizeof(arb_arena_chunk_struct));
+            (*chunks)->data = flint_malloc(total * size);
+            (*chunks)->used = 0;
+            (*chunks)->alloc = total;
+            *num = 1;
+        }
+    }
+}
+
+static mp_ptr
+_arb_arena_alloc_limbs(const arf_struct * x, mp_size_t * n)
+{
+    arb_arena_struct * A = arb_arena_active;
+    arb_arena_chunk_struct * c;
+    const char * lo;
+    const char * hi;
+    slong * mark;
+    slong i;
+
+    if (A == NULL || A->depth == 0 || A->vecs_num == 0)
+        return NULL;
+
+    mark = A->marks + 4 * (A->depth - 1);
+
+    for (i = mark[0]; i <= A->vecs_cur; i++)
+    {
+        c = A->vecs + i;
+        lo = (const char *) ((arb_ptr) c->data + ((i == mark[0]) ? mark[1] : 0));
+        hi = (const char *) ((arb_ptr) c->data + c->used);
+
+        if ((const char *) x >= lo && (const char *) x < hi)
+        {
+            *n = (*n + 3) & ~WORD(3);
+            return _arb_arena_bump(&A->limbs, &A->limbs_num, &A->limbs_cur,
+                *n, sizeof(mp_limb_t), ARB_ARENA_MIN_LIMBS);
+        }
+    }
+
+    return NULL;
+}
+
+void
+arb_arena_push(arb_arena_t A)
+{
+    slong * mark;
+
+    if (A->depth == A->marks_alloc)
+    {
+        A->marks_alloc = FLINT_MAX(4, 2 * A->marks_alloc);
+        A->marks = flint_realloc(A->marks, 4 * A->marks_alloc * sizeof(slong));
+    }
+
+    mark = A->marks + 4 * A->depth;
+    mark[0] = A->vecs_cur;
+    mark[1] = (A->vecs_num == 0) ? 0 : A->vecs[A->vecs_cur].used;
+    mark[2] = A->limbs_cur;
+    mark[3] = (A->limbs_num == 0) ? 0 : A->limbs[A->limbs_cur].used;
+
+    if (A->depth == 0)
+    {
+        A->prev = arb_arena_active;
+        arb_arena_active = A;
+        _arf_arena_alloc = _arb_arena_alloc_limbs;
+    }
+
+    A->depth++;
+}
+
+void
+arb_arena_pop(arb_arena_t A)
+{
+    slong i, j, start;
+    slong * mark;
+    arb_ptr v;
+
+    if (A->depth == 0)
+    {
+        flint_printf("arb_arena_pop: no open scope\n");
+        flint_abort();
+    }
+
+    mark = A->marks + 4 * (A->depth - 1);
+
+    /* release exponents and mantissas not owned by the arena */
+    for (i = mark[0]; i <= A->vecs_cur && i < A->vecs_num; i++)
+    {
+        v = A->vecs[i].data;
+        start = (i == mark[0]) ? mark[1] : 0;
+
+        for (j = start; j < A->vecs[i].used; j++)
+            arb_clear(v + j);
+    }
+
+    _arb_arena_rewind(A->vecs, A->vecs_num, &A->vecs_cur, mark[0], mark[1]);
+    _arb_arena_rewind(A->limbs, A->limbs_num, &A->limbs_cur, mark[2], mark[3]);
+
+    A->depth--;
+
+    if (A->depth == 0)
+    {
+        if (arb_arena_active == A)
+        {
+            arb_arena_active = A->prev;
+            if (arb_arena_active == NULL)
+                _arf_arena_alloc = NULL;
+        }
+
+        A->prev = NULL;
+
+        _arb_arena_chunks_trim(&A->vecs, &A->vecs_num, &A->vecs_cur, sizeof(arb_struct));
+        _arb_arena_chunks_trim(&A->limbs, &A->limbs_num, &A->limbs_cur, sizeof(mp_limb_t));
+    }
+}
+
+arb_ptr
+arb_arena_vec(arb_arena_t A, slong n)
+{
+    arb_ptr v;
+    slong i;
+
+    if (A->depth == 0)
+    {
+        flint_printf("arb_arena_vec: no open scope\n");
+        flint_abort();
+    }
+
+    if (n == 0)
+        return NULL;
+
+    v = _arb_arena_bump(&A->vecs, &A->vecs_num, &A->vecs_cur,
+        n, sizeof(arb_struct), ARB_ARENA_MIN_VECS);
+
+    for (i = 0; i < n; i++)
+        arb_init(v + i);
+
+    return v;
+}
+
+static void
+_arb_arena_thread_cleanup(void)
+{
+    if (arb_arena_thread_init)
+    {
+        arb_arena_clear(arb_arena_thread);
+        arb_arena_thread_init = 0;
+    }
+}
+
+arb_arena_struct *
+arb_arena_scratch(void)
+{
+    if (!arb_use_arena)
+        return NULL;
+
+    if (!arb_arena_thread_init)
+    {
+        arb_arena_init(arb_arena_thread);
+        flint_register_cleanup_function(_arb_arena_thread_cleanup);
+        arb_arena_thread_init = 1;
+    }
+
+    return arb_arena_thread;
+}
@@ -124,7 +124,12 @@ arb_atan_arf(arb_t z, const arf_t x, slong prec)
         /* Too high precision to use table */
         if (wp > ARB_ATAN_TAB2_PREC)
         {
-            arb_atan_arf_bb(z, x, prec);
+            if (arb_use_extended_tables && wp <= ARB_EXT_TAB_PREC &&
+                exp > -ARB_EXT_TAB1_BITS - ARB_EXT_TAB2_BITS &&
+                exp <= ARB_EXT_TAB1_BITS + ARB_EXT_TAB2_BITS)
+                arb_atan_arf_ext(z, x, prec);
+            else
+                arb_atan_arf_bb(z, x, prec);
             return;
         }
 
@@ -0,0 +1,127 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+/* Sets p = floor(x 2^bits) clamped to [0, 2^5 - 1] and replaces x by
+   atan(x) - atan(p / 2^bits) = atan((x - a) / (1 + a x)), a = p / 2^bits. */
+static slong
+_arb_atan_ext_reduce(arb_t x, slong bits, slong prec)
+{
+    arb_t a, t;
+    fmpz_t q;
+    slong p;
+
+    fmpz_init(q);
+
+    arf_mul_2exp_si(arb_midref(x), arb_midref(x), bits);
+    arf_get_fmpz(q, arb_midref(x), ARF_RND_FLOOR);
+    arf_mul_2exp_si(arb_midref(x), arb_midref(x), -bits);
+
+    p = fmpz_get_si(q);
+    p = FLINT_MAX(p, 0);
+    p = FLINT_MIN(p, (WORD(1) << ARB_EXT_TAB1_BITS) - 1);
+
+    if (p != 0)
+    {
+        arb_init(a);
+        arb_init(t);
+
+        arb_set_si(a, p);
+        arb_mul_2exp_si(a, a, -bits);
+
+        arb_mul(t, a, x, prec);
+        arb_add_ui(t, t, 1, prec);
+        arb_sub(x, x, a, prec);
+        arb_div(x, x, t, prec);
+
+        arb_clear(a);
+        arb_clear(t);
+    }
+
+    fmpz_clear(q);
+
+    return p;
+}
+
+/*
+  Computes atan(x) using the extended tables. We use
+  atan(x) = atan(a1) + atan(a2) + atan(r) with a1 = p1 / 2^5 and
+  a2 = p2 / 2^10, where |r| < 2^-10 (approximately) is obtained
+  by two steps of the formula atan(x) - atan(a) = atan((x-a)/(1+ax)),
+  and atan(r) is computed using the bit-burst algorithm, which then
+  needs no square root argument reductions. For |x| > 1 we use
+  atan(x) = pi/2 - atan(1/x). Requires a finite x with |x| != 1
+  and moderate exponent.
+*/
+void
+arb_atan_arf_ext(arb_t z, const arf_t x, slong prec)
+{
+    arb_t t, u;
+    mp_srcptr tab1, tab2;
+    slong limbs1, limbs2, mag, wp, p1, p2;
+    int negative, reciprocal;
+
+    negative = ARF_SGNBIT(x);
+    mag = arf_abs_bound_lt_2exp_si(x);
+    reciprocal = (mag > 0);
+
+    wp = prec + 10 + FLINT_BIT_COUNT(prec);
+    if (mag < 0)
+        wp += (-mag);
+
+    arb_init(t);
+    arb_init(u);
+
+    arb_set_arf(t, x);
+    arb_abs(t, t);
+
+    if (reciprocal)
+        arb_ui_div(t, 1, t, wp);
+
+    p1 = _arb_atan_ext_reduce(t, ARB_EXT_TAB1_BITS, wp);
+    p2 = _arb_atan_ext_reduce(t, ARB_EXT_TAB1_BITS + ARB_EXT_TAB2_BITS, wp);
+
+    /* |atan'| <= 1, so the radius carries over */
+    arb_atan_arf_bb(u, arb_midref(t), wp);
+    mag_add(arb_radref(u), arb_radref(u), arb_radref(t));
+
+    if (p1 != 0)
+    {
+        tab1 = _arb_ext_tab(&limbs1, ARB_EXT_TAB_ATAN1, wp);
+        _arb_ext_tab_get(t, tab1, limbs1, p1, wp);
+        arb_add(u, u, t, wp);
+    }
+
+    if (p2 != 0)
+    {
+        tab2 = _arb_ext_tab(&limbs2, ARB_EXT_TAB_ATAN2, wp);
+        _arb_ext_tab_get(t, tab2, limbs2, p2, wp);
+        arb_add(u, u, t, wp);
+    }
+
+    if (reciprocal)
+    {
+        arb_const_pi(t, wp);
+        arb_mul_2exp_si(t, t, -1);
+        arb_sub(u, t, u, wp);
+    }
+
+    if (negative)
+        arb_neg(z, u);
+    else
+        arb_swap(z, u);
+
+    arb_set_round(z, z, prec);
+
+    arb_clear(t);
+    arb_clear(u);
+}
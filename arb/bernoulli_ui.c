@@ -15,7 +15,8 @@
 void
 arb_bernoulli_ui(arb_t b, ulong n, slong prec)
 {
-    if (n < bernoulli_cache_num)
+    if (n < bernoulli_cache_num &&
+        bernoulli_cache_generation == _BERNOULLI_SHARED_GENERATION())
     {
         arb_set_fmpq(b, bernoulli_cache + n, prec);
     }
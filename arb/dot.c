@@ -442,20 +442,441 @@ _arb_dot_add_generic(mp_ptr sum, mp_ptr serr, mp_ptr tmp, mp_size_t sn,
     }
 }
 
+/* Number of independent sums used for long dot products (must be a power
+   of two). Consecutive terms go to different sums, so that their carry
+   chains do not depend on each other. */
+#define DOT_NUM_SUMS 4
+#define DOT_MULTI_SUM_CUTOFF 64
+
+/* Software prefetching of upcoming terms. The structs are touched at
+   twice the distance of the limbs, so that reading the limb pointers
+   usually does not stall. */
+#define DOT_PREFETCH_DISTANCE 8
+
+#if defined(__GNUC__)
+#define DOT_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define DOT_PREFETCH(addr)
+#endif
+
+/* Minimum number of terms per thread. */
+#define DOT_THREAD_CUTOFF 4096
+
+int arb_dot_use_threads = 0;
+
+/* Adds the terms of x[i] * y[i] (negated if flipsign is set) to the
+   nsums fixed-point sums stored consecutively in sums (each with
+   sn + 1 limbs), and the error terms to serr and srad. Terms with
+   skip[i] set only contribute to the propagated error. */
+static void
+_arb_dot_sum_range(mp_ptr sums, slong nsums, mp_limb_t * serr_out,
+    uint64_t * srad_out, mp_ptr tmp, mp_size_t sn, slong sum_exp,
+    slong srad_exp, int flipsign, arb_srcptr x, slong xstep,
+    arb_srcptr y, slong ystep, slong len, const char * skip)
+{
+    slong i, xexp, yexp, exp, xrexp, yrexp;
+    int xnegative, ynegative, prefetch;
+    mp_size_t xn, yn;
+    flint_bitcnt_t shift;
+    arb_srcptr xi, yi;
+    arf_srcptr xm, ym;
+    mag_srcptr xr, yr;
+    mp_limb_t xtop, ytop;
+    mp_limb_t xrad, yrad;
+    mp_limb_t serr;
+    uint64_t srad;
+    mp_ptr sum;
+
+    serr = 0;
+    srad = 0;
+    prefetch = (len >= DOT_MULTI_SUM_CUTOFF);
+
+    for (i = 0; i < len; i++)
+    {
+        if (prefetch && i + 2 * DOT_PREFETCH_DISTANCE < len)
+        {
+            DOT_PREFETCH(x + (i + 2 * DOT_PREFETCH_DISTANCE) * xstep);
+            DOT_PREFETCH(y + (i + 2 * DOT_PREFETCH_DISTANCE) * ystep);
+
+            xi = x + (i + DOT_PREFETCH_DISTANCE) * xstep;
+            yi = y + (i + DOT_PREFETCH_DISTANCE) * ystep;
+
+            if (ARF_HAS_PTR(arb_midref(xi)))
+                DOT_PREFETCH(ARF_PTR_D(arb_midref(xi)));
+            if (ARF_HAS_PTR(arb_midref(yi)))
+                DOT_PREFETCH(ARF_PTR_D(arb_midref(yi)));
+        }
+
+        /* Cycle through the accumulators. */
+        sum = sums + (i & (nsums - 1)) * (sn + 1);
+
+        xi = x + i * xstep;
+        yi = y + i * ystep;
+
+        xm = arb_midref(xi);
+        ym = arb_midref(yi);
+        xr = arb_radref(xi);
+        yr = arb_radref(yi);
+
+        /* The midpoints of x[i] and y[i] are both nonzero. */
+        if (!arf_is_special(xm) && !arf_is_special(ym))
+        {
+            xexp = ARF_EXP(xm);
+            xn = ARF_SIZE(xm);
+            xnegative = ARF_SGNBIT(xm);
+
+            yexp = ARF_EXP(ym);
+            yn = ARF_SIZE(ym);
+            ynegative = ARF_SGNBIT(ym);
+
+            exp = xexp + yexp;
+            shift = sum_exp - exp;
+
+            if (shift >= sn * FLINT_BITS)
+            {
+                /* We may yet need the top limbs for bounds. */
+                ARF_GET_TOP_LIMB(xtop, xm);
+                ARF_GET_TOP_LIMB(ytop, ym);
+                serr++;
+            }
+            else if (xn <= 2 && yn <= 2 && sn <= 3)
+            {
+                mp_limb_t x1, x0, y1, y0;
+                mp_limb_t u3, u2, u1, u0;
+
+                if (xn == 1 && yn == 1)
+                {
+                    xtop = ARF_NOPTR_D(xm)[0];
+                    ytop = ARF_NOPTR_D(ym)[0];
+                    umul_ppmm(u3, u2, xtop, ytop);
+                    u1 = u0 = 0;
+                }
+                else if (xn == 2 && yn == 2)
+                {
+                    x0 = ARF_NOPTR_D(xm)[0];
+                    x1 = ARF_NOPTR_D(xm)[1];
+                    y0 = ARF_NOPTR_D(ym)[0];
+                    y1 = ARF_NOPTR_D(ym)[1];
+                    xtop = x1;
+                    ytop = y1;
+                    nn_mul_2x2(u3, u2, u1, u0, x1, x0, y1, y0);
+                }
+                else if (xn == 1)
+                {
+                    x0 = ARF_NOPTR_D(xm)[0];
+                    y0 = ARF_NOPTR_D(ym)[0];
+                    y1 = ARF_NOPTR_D(ym)[1];
+                    xtop = x0;
+                    ytop = y1;
+                    nn_mul_2x1(u3, u2, u1, y1, y0, x0);
+                    u0 = 0;
+                }
+                else
+                {
+                    x0 = ARF_NOPTR_D(xm)[0];
+                    x1 = ARF_NOPTR_D(xm)[1];
+                    y0 = ARF_NOPTR_D(ym)[0];
+                    xtop = x1;
+                    ytop = y0;
+                    nn_mul_2x1(u3, u2, u1, x1, x0, y0);
+                    u0 = 0;
+                }
+
+                if (sn == 2)
+                {
+                    if (shift < FLINT_BITS)
+                    {
+                        serr += ((u2 << (FLINT_BITS - shift)) != 0) || (u1 != 0) || (u0 != 0);
+                        u2 = (u2 >> shift) | (u3 << (FLINT_BITS - shift));
+                        u3 = (u3 >> shift);
+                    }
+                    else if (shift == FLINT_BITS)
+                    {
+                        serr += (u2 != 0) || (u1 != 0) || (u0 != 0);
+                        u2 = u3;
+                        u3 = 0;
+                    }
+                    else /* FLINT_BITS < shift < 2 * FLINT_BITS */
+                    {
+                        serr += ((u3 << (2 * FLINT_BITS - shift)) != 0) || (u2 != 0) || (u1 != 0) || (u0 != 0);
+                        u2 = (u3 >> (shift - FLINT_BITS));
+                        u3 = 0;
+                    }
+
+                    if (xnegative ^ ynegative ^ flipsign)
+                        sub_ddmmss(sum[1], sum[0], sum[1], sum[0], u3, u2);
+                    else
+                        add_ssaaaa(sum[1], sum[0], sum[1], sum[0], u3, u2);
+                }
+                else if (sn == 3)
+                {
+                    if (shift < FLINT_BITS)
+                    {
+                        serr += ((u1 << (FLINT_BITS - shift)) != 0) || (u0 != 0);
+                        u1 = (u1 >> shift) | (u2 << (FLINT_BITS - shift));
+                        u2 = (u2 >> shift) | (u3 << (FLINT_BITS - shift));
+                        u3 = (u3 >> shift);
+                    }
+                    else if (shift == FLINT_BITS)
+                    {
+                        serr += (u1 != 0) || (u0 != 0);
+                        u1 = u2;
+                        u2 = u3;
+                        u3 = 0;
+                    }
+                    else if (shift < 2 * FLINT_BITS)
+                    {
+                        serr += ((u2 << (2 * FLINT_BITS - shift)) != 0) || (u1 != 0) || (u0 != 0);
+                        u1 = (u3 << (2 * FLINT_BITS - shift)) | (u2 >> (shift - FLINT_BITS));
+                        u2 = (u3 >> (shift - FLINT_BITS));
+                        u3 = 0;
+                    }
+                    else if (shift == 2 * FLINT_BITS)
+                    {
+                        serr += (u2 != 0) || (u1 != 0) || (u0 != 0);
+                        u1 = u3;
+                        u2 = 0;
+                        u3 = 0;
+                    }
+                    else  /* 2 * FLINT_BITS < shift < 3 * FLINT_BITS */
+                    {
+                        serr += ((u3 << (3 * FLINT_BITS - shift)) != 0) || (u2 != 0) || (u1 != 0) || (u0 != 0);
+                        u1 = (u3 >> (shift - 2 * FLINT_BITS));
+                        u2 = 0;
+                        u3 = 0;
+                    }
+
+                    if (xnegative ^ ynegative ^ flipsign)
+                        sub_dddmmmsss2(sum[2], sum[1], sum[0], sum[2], sum[1], sum[0], u3, u2, u1);
+                    else
+                        add_sssaaaaaa2(sum[2], sum[1], sum[0], sum[2], sum[1], sum[0], u3, u2, u1);
+                }
+            }
+            else
+            {
+                mp_srcptr xptr, yptr;
+
+                xptr = (xn <= ARF_NOPTR_LIMBS) ? ARF_NOPTR_D(xm) : ARF_PTR_D(xm);
+                yptr = (yn <= ARF_NOPTR_LIMBS) ? ARF_NOPTR_D(ym) : ARF_PTR_D(ym);
+
+                xtop = xptr[xn - 1];
+                ytop = yptr[yn - 1];
+
+                if (skip == NULL || skip[i] == 0)
+                    _arb_dot_addmul_generic(sum, &serr, tmp, sn, xptr, xn, yptr, yn, xnegative ^ ynegative ^ flipsign, shift);
+            }
+
+            xrad = MAG_MAN(xr);
+            yrad = MAG_MAN(yr);
+
+            if (xrad != 0 && yrad != 0)
+            {
+                xrexp = MAG_EXP(xr);
+                yrexp = MAG_EXP(yr);
+
+                RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
+                RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
+                RAD_ADDMUL(srad, srad_exp, xrad, yrad, xrexp + yrexp);
+            }
+            else if (xrad != 0)
+            {
+                xrexp = MAG_EXP(xr);
+                RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
+            }
+            else if (yrad != 0)
+            {
+                yrexp = MAG_EXP(yr);
+                RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
+            }
+        }
+        else
+        {
+            xrad = MAG_MAN(xr);
+            yrad = MAG_MAN(yr);
+
+            xexp = ARF_EXP(xm);
+            yexp = ARF_EXP(ym);
+
+            xrexp = MAG_EXP(xr);
+            yrexp = MAG_EXP(yr);
+
+            /* (xm+xr)(ym+yr) = xm ym + [xm yr + ym xr + xr yr] */
+            if (yrad && !arf_is_special(xm))
+            {
+                ARF_GET_TOP_LIMB(xtop, xm);
+                RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
+            }
+
+            if (xrad && !arf_is_special(ym))
+            {
+                ARF_GET_TOP_LIMB(ytop, ym);
+                RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
+            }
+
+            if (xrad && yrad)
+            {
+                RAD_ADDMUL(srad, srad_exp, xrad, yrad, xrexp + yrexp);
+            }
+        }
+    }
+
+    *serr_out += serr;
+    *srad_out += srad;
+}
+
+/* Adds sums 1, ..., nsums - 1 to sum 0. The sums are exact
+   (modulo 2^(sn * FLINT_BITS)), so the result does not depend on
+   how the terms were distributed. */
+static void
+_arb_dot_merge_sums(mp_ptr sums, slong nsums, mp_size_t sn)
+{
+    slong k;
+
+    for (k = 1; k < nsums; k++)
+        mpn_add_n(sums, sums, sums + k * (sn + 1), sn);
+}
+
+typedef struct
+{
+    mp_ptr sums;
+    mp_limb_t * serr;
+    uint64_t * srad;
+    mp_size_t sn;
+    slong sum_exp;
+    slong srad_exp;
+    int flipsign;
+    arb_srcptr x;
+    slong xstep;
+    arb_srcptr y;
+    slong ystep;
+    slong len;
+    slong chunk;
+    const char * skip;
+}
+dot_work_t;
+
+static void
+_arb_dot_sum_worker(slong k, void * arg)
+{
+    dot_work_t * work = (dot_work_t *) arg;
+    mp_size_t sn = work->sn;
+    slong a, b, j;
+    mp_ptr sums, tmp;
+
+    a = k * work->chunk;
+    b = FLINT_MIN(a + work->chunk, work->len);
+
+    /* the sums for this chunk followed by workspace */
+    sums = work->sums + k * DOT_NUM_SUMS * (sn + 1);
+    tmp = flint_malloc(sizeof(mp_limb_t) * (2 * (sn + 2) + 1));
+
+    for (j = 0; j < DOT_NUM_SUMS * (sn + 1); j++)
+        sums[j] = 0;
+
+    work->serr[k] = 0;
+    work->srad[k] = 0;
+
+    _arb_dot_sum_range(sums, DOT_NUM_SUMS, work->serr + k, work->srad + k,
+        tmp, sn, work->sum_exp, work->srad_exp, work->flipsign,
+        work->x + a * work->xstep, work->xstep,
+        work->y + a * work->ystep, work->ystep,
+        b - a, (work->skip == NULL) ? NULL : work->skip + a);
+
+    _arb_dot_merge_sums(sums, DOT_NUM_SUMS, sn);
+
+    flint_free(tmp);
+}
+
+void
+_arb_dot_sum(mp_ptr sum, mp_limb_t * serr, uint64_t * srad, mp_ptr tmp,
+    mp_size_t sn, slong sum_exp, slong srad_exp, int flipsign,
+    arb_srcptr x, slong xstep, arb_srcptr y, slong ystep, slong len,
+    const char * skip)
+{
+    slong j, k, num_chunks;
+    mp_ptr sums;
+
+    if (len < DOT_MULTI_SUM_CUTOFF)
+    {
+        _arb_dot_sum_range(sum, 1, serr, srad, tmp, sn, sum_exp, srad_exp,
+            flipsign, x, xstep, y, ystep, len, skip);
+        return;
+    }
+
+    num_chunks = 1;
+    if (arb_dot_use_threads && len >= 2 * DOT_THREAD_CUTOFF)
+        num_chunks = FLINT_MIN(flint_get_num_threads(), len / DOT_THREAD_CUTOFF);
+
+    if (num_chunks <= 1)
+    {
+        /* The first sum continues the output sum. */
+        sums = flint_malloc(sizeof(mp_limb_t) * DOT_NUM_SUMS * (sn + 1));
+
+        for (j = 0; j < sn + 1; j++)
+            sums[j] = sum[j];
+        for ( ; j < DOT_NUM_SUMS * (sn + 1); j++)
+            sums[j] = 0;
+
+        _arb_dot_sum_range(sums, DOT_NUM_SUMS, serr, srad, tmp, sn, sum_exp,
+            srad_exp, flipsign, x, xstep, y, ystep, len, skip);
+
+        _arb_dot_merge_sums(sums, DOT_NUM_SUMS, sn);
+
+        for (j = 0; j < sn + 1; j++)
+            sum[j] = sums[j];
+
+        flint_free(sums);
+    }
+    else
+    {
+        dot_work_t work;
+
+        work.sums = flint_malloc(sizeof(mp_limb_t) * num_chunks * DOT_NUM_SUMS * (sn + 1));
+        work.serr = flint_malloc(sizeof(mp_limb_t) * num_chunks);
+        work.srad = flint_malloc(sizeof(uint64_t) * num_chunks);
+        work.sn = sn;
+        work.sum_exp = sum_exp;
+        work.srad_exp = srad_exp;
+        work.flipsign = flipsign;
+        work.x = x;
+        work.xstep = xstep;
+        work.y = y;
+        work.ystep = ystep;
+        work.len = len;
+        work.chunk = (len + num_chunks - 1) / num_chunks;
+        work.skip = skip;
+
+        num_chunks = (len + work.chunk - 1) / work.chunk;
+
+        flint_parallel_do(_arb_dot_sum_worker, &work, num_chunks, -1, FLINT_PARALLEL_STRIDED);
+
+        /* Combine in a fixed order. */
+        for (k = 0; k < num_chunks; k++)
+        {
+            mpn_add_n(sum, sum, work.sums + k * DOT_NUM_SUMS * (sn + 1), sn);
+            *serr += work.serr[k];
+            *srad += work.srad[k];
+        }
+
+        flint_free(work.sums);
+        flint_free(work.serr);
+        flint_free(work.srad);
+    }
+}
+
 void
 arb_dot(arb_t res, const arb_t initial, int subtract, arb_srcptr x, slong xstep, arb_srcptr y, slong ystep, slong len, slong prec)
 {
     slong i, j, nonzero, padding, extend;
     slong xexp, yexp, exp, max_exp, min_exp, sum_exp;
     slong xrexp, yrexp, srad_exp, max_rad_exp;
-    int xnegative, ynegative, inexact;
-    mp_size_t xn, yn, sn, alloc;
+    int xnegative, inexact;
+    mp_size_t xn, sn, alloc;
     flint_bitcnt_t shift;
     arb_srcptr xi, yi;
     arf_srcptr xm, ym;
     mag_srcptr xr, yr;
-    mp_limb_t xtop, ytop;
-    mp_limb_t xrad, yrad;
+    mp_limb_t xrad;
     mp_limb_t serr;   /* Sum over arithmetic errors */
     uint64_t srad;    /* Sum over propagated errors */
     mp_ptr tmp, sum;  /* Workspace */
@@ -711,273 +1132,8 @@ arb_dot(arb_t res, const arb_t initial, int subtract, arb_srcptr x, slong xstep,
         }
     }
 
-    for (i = 0; i < len; i++)
-    {
-        xi = x + i * xstep;
-        yi = y + i * ystep;
-        xm = arb_midref(xi);
-        ym = arb_midref(yi);
-        xr = arb_radref(xi);
-        yr = arb_radref(yi);
-
-        /* The midpoints of x[i] and y[i] are both nonzero. */
-        if (!arf_is_special(xm) && !arf_is_special(ym))
-        {
-            xexp = ARF_EXP(xm);
-            xn = ARF_SIZE(xm);
-            xnegative = ARF_SGNBIT(xm);
-
-            yexp = ARF_EXP(ym);
-            yn = ARF_SIZE(ym);
-            ynegative = ARF_SGNBIT(ym);
-
-            exp = xexp + yexp;
-            shift = sum_exp - exp;
-
-            if (shift >= sn * FLINT_BITS)
-            {
-                /* We may yet need the top limbs for bounds. */
-                ARF_GET_TOP_LIMB(xtop, xm);
-                ARF_GET_TOP_LIMB(ytop, ym);
-                serr++;
-            }
-#if 0
-            else if (xn == 1 && yn == 1 && sn == 2 && shift < FLINT_BITS)  /* Fastest path. */
-            {
-                mp_limb_t hi, lo, out;
-
-                xtop = ARF_NOPTR_D(xm)[0];
-                ytop = ARF_NOPTR_D(ym)[0];
-
-                umul_ppmm(hi, lo, xtop, ytop);
-
-                out = lo << (FLINT_BITS - shift);
-                lo = (lo >> shift) | (hi << (FLINT_BITS - shift));
-                hi = (hi >> shift);
-                serr += (out != 0);
-
-                if (xnegative ^ ynegative)
-                    sub_ddmmss(sum[1], sum[0], sum[1], sum[0], hi, lo);
-                else
-                    add_ssaaaa(sum[1], sum[0], sum[1], sum[0], hi, lo);
-            }
-            else if (xn == 2 && yn == 2 && shift < FLINT_BITS && sn <= 3)
-            {
-                mp_limb_t x1, x0, y1, y0;
-                mp_limb_t u3, u2, u1, u0;
-
-                x0 = ARF_NOPTR_D(xm)[0];
-                x1 = ARF_NOPTR_D(xm)[1];
-                y0 = ARF_NOPTR_D(ym)[0];
-                y1 = ARF_NOPTR_D(ym)[1];
-
-                xtop = x1;
-                ytop = y1;
-
-                nn_mul_2x2(u3, u2, u1, u0, x1, x0, y1, y0);
-
-                u0 = (u0 != 0) || ((u1 << (FLINT_BITS - shift)) != 0);
-                u1 = (u1 >> shift) | (u2 << (FLINT_BITS - shift));
-                u2 = (u2 >> shift) | (u3 << (FLINT_BITS - shift));
-                u3 = (u3 >> shift);
-
-                if (sn == 2)
-                {
-                    serr += (u0 || (u1 != 0));
-                    if (xnegative ^ ynegative)
-                        sub_ddmmss(sum[1], sum[0], sum[1], sum[0], u3, u2);
-                    else
-                        add_ssaaaa(sum[1], sum[0], sum[1], sum[0], u3, u2);
-                }
-                else
-                {
-                    serr += u0;
-                    if (xnegative ^ ynegative)
-                        sub_dddmmmsss2(sum[2], sum[1], sum[0], sum[2], sum[1], sum[0], u3, u2, u1);
-                    else
-                        add_sssaaaaaa2(sum[2], sum[1], sum[0], sum[2], sum[1], sum[0], u3, u2, u1);
-                }
-            }
-#endif
-            else if (xn <= 2 && yn <= 2 && sn <= 3)
-            {
-                mp_limb_t x1, x0, y1, y0;
-                mp_limb_t u3, u2, u1, u0;
-
-                if (xn == 1 && yn == 1)
-                {
-                    xtop = ARF_NOPTR_D(xm)[0];
-                    ytop = ARF_NOPTR_D(ym)[0];
-                    umul_ppmm(u3, u2, xtop, ytop);
-                    u1 = u0 = 0;
-                }
-                else if (xn == 2 && yn == 2)
-                {
-                    x0 = ARF_NOPTR_D(xm)[0];
-                    x1 = ARF_NOPTR_D(xm)[1];
-                    y0 = ARF_NOPTR_D(ym)[0];
-                    y1 = ARF_NOPTR_D(ym)[1];
-                    xtop = x1;
-                    ytop = y1;
-                    nn_mul_2x2(u3, u2, u1, u0, x1, x0, y1, y0);
-                }
-                else if (xn == 1)
-                {
-                    x0 = ARF_NOPTR_D(xm)[0];
-                    y0 = ARF_NOPTR_D(ym)[0];
-                    y1 = ARF_NOPTR_D(ym)[1];
-                    xtop = x0;
-                    ytop = y1;
-                    nn_mul_2x1(u3, u2, u1, y1, y0, x0);
-                    u0 = 0;
-                }
-                else
-                {
-                    x0 = ARF_NOPTR_D(xm)[0];
-                    x1 = ARF_NOPTR_D(xm)[1];
-                    y0 = ARF_NOPTR_D(ym)[0];
-                    xtop = x1;
-                    ytop = y0;
-                    nn_mul_2x1(u3, u2, u1, x1, x0, y0);
-                    u0 = 0;
-                }
-
-                if (sn == 2)
-                {
-                    if (shift < FLINT_BITS)
-                    {
-                        serr += ((u2 << (FLINT_BITS - shift)) != 0) || (u1 != 0) || (u0 != 0);
-                        u2 = (u2 >> shift) | (u3 << (FLINT_BITS - shift));
-                        u3 = (u3 >> shift);
-                    }
-                    else if (shift == FLINT_BITS)
-                    {
-                        serr += (u2 != 0) || (u1 != 0) || (u0 != 0);
-                        u2 = u3;
-                        u3 = 0;
-                    }
-                    else /* FLINT_BITS < shift < 2 * FLINT_BITS */
-                    {
-                        serr += ((u3 << (2 * FLINT_BITS - shift)) != 0) || (u2 != 0) || (u1 != 0) || (u0 != 0);
-                        u2 = (u3 >> (shift - FLINT_BITS));
-                        u3 = 0;
-                    }
-
-                    if (xnegative ^ ynegative)
-                        sub_ddmmss(sum[1], sum[0], sum[1], sum[0], u3, u2);
-                    else
-                        add_ssaaaa(sum[1], sum[0], sum[1], sum[0], u3, u2);
-                }
-                else if (sn == 3)
-                {
-                    if (shift < FLINT_BITS)
-                    {
-                        serr += ((u1 << (FLINT_BITS - shift)) != 0) || (u0 != 0);
-                        u1 = (u1 >> shift) | (u2 << (FLINT_BITS - shift));
-                        u2 = (u2 >> shift) | (u3 << (FLINT_BITS - shift));
-                        u3 = (u3 >> shift);
-                    }
-                    else if (shift == FLINT_BITS)
-                    {
-                        serr += (u1 != 0) || (u0 != 0);
-                        u1 = u2;
-                        u2 = u3;
-                        u3 = 0;
-                    }
-                    else if (shift < 2 * FLINT_BITS)
-                    {
-                        serr += ((u2 << (2 * FLINT_BITS - shift)) != 0) || (u1 != 0) || (u0 != 0);
-                        u1 = (u3 << (2 * FLINT_BITS - shift)) | (u2 >> (shift - FLINT_BITS));
-                        u2 = (u3 >> (shift - FLINT_BITS));
-                        u3 = 0;
-                    }
-                    else if (shift == 2 * FLINT_BITS)
-                    {
-                        serr += (u2 != 0) || (u1 != 0) || (u0 != 0);
-                        u1 = u3;
-                        u2 = 0;
-                        u3 = 0;
-                    }
-                    else  /* 2 * FLINT_BITS < shift < 3 * FLINT_BITS */
-                    {
-                        serr += ((u3 << (3 * FLINT_BITS - shift)) != 0) || (u2 != 0) || (u1 != 0) || (u0 != 0);
-                        u1 = (u3 >> (shift - 2 * FLINT_BITS));
-                        u2 = 0;
-                        u3 = 0;
-                    }
-
-                    if (xnegative ^ ynegative)
-                        sub_dddmmmsss2(sum[2], sum[1], sum[0], sum[2], sum[1], sum[0], u3, u2, u1);
-                    else
-                        add_sssaaaaaa2(sum[2], sum[1], sum[0], sum[2], sum[1], sum[0], u3, u2, u1);
-                }
-            }
-            else
-            {
-                mp_srcptr xptr, yptr;
-
-                xptr = (xn <= ARF_NOPTR_LIMBS) ? ARF_NOPTR_D(xm) : ARF_PTR_D(xm);
-                yptr = (yn <= ARF_NOPTR_LIMBS) ? ARF_NOPTR_D(ym) : ARF_PTR_D(ym);
-
-                xtop = xptr[xn - 1];
-                ytop = yptr[yn - 1];
-
-                _arb_dot_addmul_generic(sum, &serr, tmp, sn, xptr, xn, yptr, yn, xnegative ^ ynegative, shift);
-            }
-
-            xrad = MAG_MAN(xr);
-            yrad = MAG_MAN(yr);
-
-            if (xrad != 0 && yrad != 0)
-            {
-                xrexp = MAG_EXP(xr);
-                yrexp = MAG_EXP(yr);
-
-                RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
-                RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
-                RAD_ADDMUL(srad, srad_exp, xrad, yrad, xrexp + yrexp);
-            }
-            else if (xrad != 0)
-            {
-                xrexp = MAG_EXP(xr);
-                RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
-            }
-            else if (yrad != 0)
-            {
-                yrexp = MAG_EXP(yr);
-                RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
-            }
-        }
-        else
-        {
-            xrad = MAG_MAN(xr);
-            yrad = MAG_MAN(yr);
-
-            xexp = ARF_EXP(xm);
-            yexp = ARF_EXP(ym);
-
-            xrexp = MAG_EXP(xr);
-            yrexp = MAG_EXP(yr);
-
-            /* (xm+xr)(ym+yr) = xm ym + [xm yr + ym xr + xr yr] */
-            if (yrad && !arf_is_special(xm))
-            {
-                ARF_GET_TOP_LIMB(xtop, xm);
-                RAD_ADDMUL(srad, srad_exp, (xtop >> (FLINT_BITS - MAG_BITS)) + 1, yrad, xexp + yrexp);
-            }
-
-            if (xrad && !arf_is_special(ym))
-            {
-                ARF_GET_TOP_LIMB(ytop, ym);
-                RAD_ADDMUL(srad, srad_exp, (ytop >> (FLINT_BITS - MAG_BITS)) + 1, xrad, yexp + xrexp);
-            }
-
-            if (xrad && yrad)
-            {
-                RAD_ADDMUL(srad, srad_exp, xrad, yrad, xrexp + yrexp);
-            }
-        }
-    }
+    _arb_dot_sum(sum, &serr, &srad, tmp, sn, sum_exp, srad_exp, 0,
+        x, xstep, y, ystep, len, NULL);
 
     xnegative = 0;
     if (sum[sn - 1] >= LIMB_TOP)
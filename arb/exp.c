@@ -190,7 +190,10 @@ arb_exp_arf(arb_t z, const arf_t x, slong prec, int minus_one, slong maglim)
         /* Too high precision to use table -- use generic algorithm */
         if (wp > ARB_EXP_TAB2_PREC)
         {
-            arb_exp_arf_fallback(z, x, exp, prec, minus_one);
+            if (arb_use_extended_tables && wp <= ARB_EXT_TAB_PREC && exp <= 8)
+                arb_exp_arf_ext(z, x, prec, minus_one);
+            else
+                arb_exp_arf_fallback(z, x, exp, prec, minus_one);
             return;
         }
 
@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+/* Evaluates the exponential of a reduced argument |x| < 2^-9 or so,
+   including the propagated error for the radius. */
+static void
+_arb_exp_reduced(arb_t res, const arb_t x, slong prec)
+{
+    mag_t err, t;
+
+    if (prec < 19000)
+        arb_exp_arf_rs_generic(res, arb_midref(x), prec, 0);
+    else
+        arb_exp_arf_bb(res, arb_midref(x), prec, 0);
+
+    if (!mag_is_zero(arb_radref(x)))
+    {
+        mag_init(err);
+        mag_init(t);
+        mag_expm1(err, arb_radref(x));
+        arb_get_mag(t, res);
+        mag_mul(err, err, t);
+        arb_add_error_mag(res, err);
+        mag_clear(err);
+        mag_clear(t);
+    }
+}
+
+/*
+  Computes exp(x) (or exp(x)-1) using the extended tables.
+  We write x = n log(2) + p1 / 2^5 + p2 / 2^10 + r with 0 <= r < 2^-10
+  (approximately), compute exp(r) using the generic algorithm, which
+  now needs 10 fewer squarings, and multiply by the table values.
+  Requires a finite x with |x| < 2^8.
+*/
+void
+arb_exp_arf_ext(arb_t z, const arf_t x, slong prec, int minus_one)
+{
+    arb_t t, u, ln2;
+    mp_srcptr tab1, tab2;
+    slong limbs1, limbs2, mag, wp, n, p, p1, p2;
+    fmpz_t q;
+
+    mag = arf_abs_bound_lt_2exp_si(x);
+
+    wp = prec + 10 + FLINT_BIT_COUNT(prec);
+    if (minus_one && mag < 0)
+        wp += (-mag);
+
+    arb_init(t);
+    arb_init(u);
+    arb_init(ln2);
+    fmpz_init(q);
+
+    /* reduce modulo log(2) */
+    arb_set_arf(t, x);
+    n = 0;
+
+    if (arf_sgn(x) < 0 || mag >= 0)
+    {
+        arb_const_log2(ln2, wp + FLINT_MAX(mag, 0) + 2);
+        arb_div(u, t, ln2, 32);
+        arf_get_fmpz(q, arb_midref(u), ARF_RND_FLOOR);
+        n = fmpz_get_si(q);
+        arb_submul_si(t, ln2, n, wp + FLINT_MAX(mag, 0) + 2);
+    }
+
+    /* table indices; the clamping only matters if the reduction was
+       slightly off, in which case r is still small */
+    arf_mul_2exp_si(arb_midref(u), arb_midref(t),
+        ARB_EXT_TAB1_BITS + ARB_EXT_TAB2_BITS);
+    arf_get_fmpz(q, arb_midref(u), ARF_RND_FLOOR);
+    p = fmpz_get_si(q);
+    p = FLINT_MAX(p, 0);
+    p = FLINT_MIN(p, (ARB_EXP_TAB21_NUM << ARB_EXT_TAB2_BITS) - 1);
+    p1 = p >> ARB_EXT_TAB2_BITS;
+    p2 = p & ((WORD(1) << ARB_EXT_TAB2_BITS) - 1);
+
+    /* r = t - p / 2^10 */
+    arf_set_si_2exp_si(arb_midref(u), p, -(ARB_EXT_TAB1_BITS + ARB_EXT_TAB2_BITS));
+    mag_zero(arb_radref(u));
+    arb_sub(t, t, u, wp);
+
+    _arb_exp_reduced(t, t, wp);
+
+    if (p1 != 0)
+    {
+        tab1 = _arb_ext_tab(&limbs1, ARB_EXT_TAB_EXP1, wp);
+        _arb_ext_tab_get(u, tab1, limbs1, p1, wp);
+        arb_mul(t, t, u, wp);
+    }
+
+    if (p2 != 0)
+    {
+        tab2 = _arb_ext_tab(&limbs2, ARB_EXT_TAB_EXP2, wp);
+        _arb_ext_tab_get(u, tab2, limbs2, p2, wp);
+        arb_mul(t, t, u, wp);
+    }
+
+    arb_mul_2exp_si(t, t, n);
+
+    if (minus_one)
+        arb_sub_ui(z, t, 1, prec);
+    else
+        arb_set_round(z, t, prec);
+
+    arb_clear(t);
+    arb_clear(u);
+    arb_clear(ln2);
+    fmpz_clear(q);
+}
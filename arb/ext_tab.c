@@ -0,0 +1,243 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include "arb.h"
+
+/*
+  Tables of exp(a), sin(a), cos(a) and atan(a) for a = p / 2^5 and
+  a = p / 2^10, used for argument reduction at precisions where the
+  static tables (exp_tab.c, sin_cos_tab.c, atan_tab.c) are too short.
+
+  As in the static tables, each entry is a fixed-point number with
+  limbs fractional limbs. To keep every entry below 1, the stored value
+  is half the function value. The entries are rounded to nearest, so
+  truncating an entry to its top wn limbs gives an error smaller than
+  2 ulp at wn limbs.
+
+  A table is computed lazily with the precision rounded up to a power
+  of two (at least ARB_EXT_TAB_MIN_PREC bits), and is published as an
+  immutable snapshot shared by all threads. A table replaced by one with
+  higher precision may still be in use by readers, so it is kept on a
+  list and only freed by arb_extended_tables_clear, which is called when
+  the last thread holding a reference to the shared state drops it
+  (see shared_state.c).
+*/
+
+struct _arb_ext_tab_struct
+{
+    mp_ptr data;
+    slong limbs;
+    struct _arb_ext_tab_struct * prev;
+};
+
+typedef struct _arb_ext_tab_struct arb_ext_tab_struct;
+
+int arb_use_extended_tables = 0;
+
+static arb_ext_tab_struct * ext_tabs[ARB_EXT_TAB_NUM] = { NULL };
+static pthread_mutex_t ext_tab_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void
+arb_extended_tables_clear(void)
+{
+    arb_ext_tab_struct * t, * prev;
+    int i;
+
+    pthread_mutex_lock(&ext_tab_lock);
+
+    for (i = 0; i < ARB_EXT_TAB_NUM; i++)
+    {
+        for (t = ext_tabs[i]; t != NULL; t = prev)
+        {
+            prev = t->prev;
+            flint_free(t->data);
+            flint_free(t);
+        }
+
+        _ARB_SHARED_STORE_PTR(&ext_tabs[i], NULL);
+    }
+
+    pthread_mutex_unlock(&ext_tab_lock);
+}
+
+static slong
+_ext_tab_len(int which)
+{
+    switch (which)
+    {
+        case ARB_EXT_TAB_EXP1:
+            return ARB_EXP_TAB21_NUM;
+        case ARB_EXT_TAB_EXP2:
+            return WORD(1) << ARB_EXT_TAB2_BITS;
+        case ARB_EXT_TAB_SIN_COS1:
+            return WORD(2) << ARB_EXT_TAB1_BITS;
+        case ARB_EXT_TAB_SIN_COS2:
+            return WORD(2) << ARB_EXT_TAB2_BITS;
+        case ARB_EXT_TAB_ATAN1:
+            return WORD(1) << ARB_EXT_TAB1_BITS;
+        default:
+            return WORD(1) << ARB_EXT_TAB2_BITS;
+    }
+}
+
+/* Sets y to half the function value for entry i. The generic algorithms
+   are called directly since the main functions may use these tables. */
+static void
+_ext_tab_entry(arb_t y, int which, slong i, slong prec)
+{
+    arf_t a;
+    slong p, bits;
+
+    if (which == ARB_EXT_TAB_SIN_COS1 || which == ARB_EXT_TAB_SIN_COS2)
+        p = i / 2;
+    else
+        p = i;
+
+    if (which == ARB_EXT_TAB_EXP1 || which == ARB_EXT_TAB_SIN_COS1 ||
+        which == ARB_EXT_TAB_ATAN1)
+        bits = ARB_EXT_TAB1_BITS;
+    else
+        bits = ARB_EXT_TAB1_BITS + ARB_EXT_TAB2_BITS;
+
+    arf_init(a);
+    arf_set_si_2exp_si(a, p, -bits);
+
+    if (p == 0)
+    {
+        if (which == ARB_EXT_TAB_EXP1 || which == ARB_EXT_TAB_EXP2 ||
+            ((which == ARB_EXT_TAB_SIN_COS1 || which == ARB_EXT_TAB_SIN_COS2) && i == 1))
+            arb_one(y);
+        else
+            arb_zero(y);
+    }
+    else if (which == ARB_EXT_TAB_EXP1 || which == ARB_EXT_TAB_EXP2)
+    {
+        arb_exp_arf_bb(y, a, prec, 0);
+    }
+    else if (which == ARB_EXT_TAB_SIN_COS1 || which == ARB_EXT_TAB_SIN_COS2)
+    {
+        if (i % 2 == 0)
+            arb_sin_cos_arf_bb(y, NULL, a, prec);
+        else
+            arb_sin_cos_arf_bb(NULL, y, a, prec);
+    }
+    else
+    {
+        arb_atan_arf_bb(y, a, prec);
+    }
+
+    arb_mul_2exp_si(y, y, -1);
+    arf_clear(a);
+}
+
+static arb_ext_tab_struct *
+_ext_tab_compute(int which, slong limbs)
+{
+    arb_ext_tab_struct * t;
+    slong i, j, len, n;
+    arb_t y;
+    fmpz_t f;
+
+    len = _ext_tab_len(which);
+
+    t = flint_malloc(sizeof(arb_ext_tab_struct));
+    t->data = flint_malloc(sizeof(mp_limb_t) * len * limbs);
+    t->limbs = limbs;
+    t->prev = NULL;
+
+    arb_init(y);
+    fmpz_init(f);
+
+    for (i = 0; i < len; i++)
+    {
+        mp_ptr d = t->data + i * limbs;
+
+        _ext_tab_entry(y, which, i, limbs * FLINT_BITS + 64);
+        arf_mul_2exp_si(arb_midref(y), arb_midref(y), limbs * FLINT_BITS);
+        arf_get_fmpz(f, arb_midref(y), ARF_RND_NEAR);
+
+        flint_mpn_zero(d, limbs);
+
+        if (!COEFF_IS_MPZ(*f))
+        {
+            d[0] = *f;
+        }
+        else
+        {
+            __mpz_struct * z = COEFF_TO_PTR(*f);
+            n = FLINT_MIN(z->_mp_size, limbs);
+            for (j = 0; j < n; j++)
+                d[j] = z->_mp_d[j];
+        }
+    }
+
+    arb_clear(y);
+    fmpz_clear(f);
+
+    return t;
+}
+
+mp_srcptr
+_arb_ext_tab(slong * limbs, int which, slong prec)
+{
+    arb_ext_tab_struct * t, * u;
+    slong bits;
+
+    /* the returned table stays valid until this thread calls flint_cleanup */
+    _arb_shared_state_hold();
+
+    t = _ARB_SHARED_LOAD_PTR(&ext_tabs[which]);
+
+    if (t == NULL || t->limbs * FLINT_BITS < prec)
+    {
+        _arb_shared_state_register(arb_extended_tables_clear);
+
+        pthread_mutex_lock(&ext_tab_lock);
+
+        /* another thread may have published in the meantime */
+        t = ext_tabs[which];
+
+        if (t == NULL || t->limbs * FLINT_BITS < prec)
+        {
+            bits = ARB_EXT_TAB_MIN_PREC;
+            while (bits < prec)
+                bits *= 2;
+
+            u = _ext_tab_compute(which, bits / FLINT_BITS);
+            u->prev = t;
+            _ARB_SHARED_STORE_PTR(&ext_tabs[which], u);
+            t = u;
+        }
+
+        pthread_mutex_unlock(&ext_tab_lock);
+    }
+
+    *limbs = t->limbs;
+    return t->data;
+}
+
+/* Sets res to entry i of the table, read to about prec bits. */
+void
+_arb_ext_tab_get(arb_t res, mp_srcptr tab, slong limbs, slong i, slong prec)
+{
+    slong wn;
+
+    wn = (prec + FLINT_BITS - 1) / FLINT_BITS + 1;
+    wn = FLINT_MIN(wn, limbs);
+
+    _arf_set_mpn_fixed(arb_midref(res), tab + i * limbs + limbs - wn,
+        wn, wn, 0, wn * FLINT_BITS, ARF_RND_DOWN);
+    mag_set_ui_2exp_si(arb_radref(res), 1, 1 - wn * FLINT_BITS);
+
+    /* the stored value is halved */
+    arb_mul_2exp_si(res, res, 1);
+}
@@ -0,0 +1,125 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+#include "flint/profiler.h"
+
+/* Compares the time per call of the elementary functions with and
+   without the extended tables (arb_use_extended_tables), to locate the
+   precisions where the tables pay off. The tables are computed before
+   timing. arb_log_arf does not use the tables and is included as a
+   reference. */
+
+#define FUNC_EXP 0
+#define FUNC_LOG 1
+#define FUNC_SIN_COS 2
+#define FUNC_ATAN 3
+
+static const char * func_names[] = { "exp", "log_arf", "sin_cos", "atan_arf" };
+
+static void
+eval(int func, arb_t y, arb_t z, const arb_t x, slong prec)
+{
+    if (func == FUNC_EXP)
+        arb_exp(y, x, prec);
+    else if (func == FUNC_LOG)
+        arb_log_arf(y, arb_midref(x), prec);
+    else if (func == FUNC_SIN_COS)
+        arb_sin_cos(y, z, x, prec);
+    else
+        arb_atan_arf(y, arb_midref(x), prec);
+}
+
+/* seconds per call */
+static double
+time_func(int func, const arb_t x, slong prec)
+{
+    arb_t y, z;
+    timeit_t timer;
+    slong i, reps;
+    double t;
+
+    arb_init(y);
+    arb_init(z);
+
+    /* compute tables and constants */
+    eval(func, y, z, x, prec);
+
+    for (reps = 1; ; reps *= 2)
+    {
+        timeit_start(timer);
+        for (i = 0; i < reps; i++)
+            eval(func, y, z, x, prec);
+        timeit_stop(timer);
+
+        if (timer->wall >= 100)
+            break;
+    }
+
+    t = timer->wall * 0.001 / reps;
+
+    arb_clear(y);
+    arb_clear(z);
+
+    return t;
+}
+
+int main()
+{
+    slong precs[] = { 4096, 5120, 6144, 8192, 12288, 16384, 24576, 32768 };
+    slong i, prec;
+    double t1, t2;
+    flint_rand_t state;
+    arb_t x;
+    int func, large;
+
+    flint_randinit(state);
+    arb_init(x);
+
+    printf("%10s %8s %8s %12s %12s %8s\n",
+        "function", "|x|", "prec", "generic (s)", "tables (s)", "speedup");
+
+    for (func = 0; func < 4; func++)
+    {
+        for (large = 0; large <= 1; large++)
+        {
+            for (i = 0; i < sizeof(precs) / sizeof(slong); i++)
+            {
+                prec = precs[i];
+
+                /* a full-precision argument in (0, 1) or (1, 8) */
+                arb_urandom(x, state, prec);
+                if (large)
+                {
+                    arb_mul_2exp_si(x, x, 3);
+                    arb_add_ui(x, x, 1, prec);
+                    arb_set_round(x, x, prec);
+                }
+                mag_zero(arb_radref(x));
+
+                arb_use_extended_tables = 0;
+                t1 = time_func(func, x, prec);
+                arb_use_extended_tables = 1;
+                t2 = time_func(func, x, prec);
+
+                flint_printf("%10s %8s %8wd ", func_names[func],
+                    large ? "(1,8)" : "(0,1)", prec);
+                printf("%12.3e %12.3e %8.3f\n", t1, t2, t1 / t2);
+            }
+        }
+    }
+
+    arb_use_extended_tables = 0;
+    arb_clear(x);
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include "arb.h"
+
+/*
+  Process-wide cache for constants defined with ARB_DEF_CACHED_CONSTANT.
+
+  Each constant holds a pointer to an immutable snapshot (value and
+  precision). Readers load the pointer and round the snapshot down to
+  the requested precision without locking. A thread needing a higher
+  precision takes the per-constant lock, computes a new snapshot and
+  publishes it with a release store. Snapshots that have been replaced
+  may still be in use by readers, so they are kept on a list and only
+  freed by arb_shared_constants_clear, which is called when the last
+  thread holding a reference to the shared state drops it (see
+  shared_state.c). Since every new snapshot has at least twice the
+  precision of the previous one, the retired snapshots use less memory
+  than the current one.
+
+  Each constant has its own lock since the computation of one constant
+  may call another cached constant.
+*/
+
+struct _arb_shared_const_value
+{
+    arb_struct value;
+    slong prec;
+    struct _arb_shared_const_value * prev;
+};
+
+typedef struct _arb_shared_const_value arb_shared_const_value;
+
+int arb_use_shared_constants = 0;
+
+static pthread_mutex_t shared_const_lock = PTHREAD_MUTEX_INITIALIZER;
+static arb_shared_const_struct * shared_const_list = NULL;
+
+void
+arb_shared_constants_clear(void)
+{
+    arb_shared_const_struct * c;
+    arb_shared_const_value * v, * prev;
+
+    pthread_mutex_lock(&shared_const_lock);
+
+    for (c = shared_const_list; c != NULL; c = c->next)
+    {
+        for (v = c->head; v != NULL; v = prev)
+        {
+            prev = v->prev;
+            arb_clear(&v->value);
+            flint_free(v);
+        }
+
+        _ARB_SHARED_STORE_PTR(&c->head, NULL);
+    }
+
+    pthread_mutex_unlock(&shared_const_lock);
+}
+
+/* Returns the lock of c, creating it and registering c on first use. */
+static pthread_mutex_t *
+_shared_const_get_lock(arb_shared_const_struct * c)
+{
+    pthread_mutex_t * lock;
+
+    pthread_mutex_lock(&shared_const_lock);
+
+    if (c->lock == NULL)
+    {
+        lock = flint_malloc(sizeof(pthread_mutex_t));
+        pthread_mutex_init(lock, NULL);
+        c->lock = lock;
+        c->next = shared_const_list;
+        shared_const_list = c;
+    }
+
+    lock = c->lock;
+
+    pthread_mutex_unlock(&shared_const_lock);
+
+    return lock;
+}
+
+void
+_arb_shared_const_get(arb_t x, arb_shared_const_struct * c,
+    void (*comp_func)(arb_t, slong), slong prec)
+{
+    arb_shared_const_value * v, * w;
+    pthread_mutex_t * lock;
+    slong wp;
+
+    _arb_shared_state_hold();
+
+    v = _ARB_SHARED_LOAD_PTR(&c->head);
+
+    if (v == NULL || v->prec < prec)
+    {
+        _arb_shared_state_register(arb_shared_constants_clear);
+
+        lock = _shared_const_get_lock(c);
+        pthread_mutex_lock(lock);
+
+        /* another thread may have published in the meantime */
+        v = c->head;
+
+        if (v == NULL || v->prec < prec)
+        {
+            w = flint_malloc(sizeof(arb_shared_const_value));
+            arb_init(&w->value);
+            w->prec = (v == NULL) ? prec : FLINT_MAX(prec, 2 * v->prec);
+            w->prev = v;
+
+            /* warm start from the cache file, if loaded */
+            wp = _arb_cache_const_lookup(&w->value, c->name, w->prec);
+            if (wp != 0)
+                w->prec = wp;
+            else
+                comp_func(&w->value, w->prec + 32);
+
+            _ARB_SHARED_STORE_PTR(&c->head, w);
+            v = w;
+        }
+
+        pthread_mutex_unlock(lock);
+    }
+
+    arb_set_round(x, &v->value, prec);
+}
@@ -0,0 +1,140 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include "arb.h"
+
+/*
+  Ownership of the process-wide caches (shared constants, extended
+  tables, shared Bernoulli and Gauss-Legendre caches).
+
+  These caches are read without locking, so they may only be freed
+  when no thread can be reading them. Functions registered with
+  flint_register_cleanup_function are called by the flint_cleanup()
+  of the registering thread only, and pool threads call flint_cleanup()
+  when they exit, so the caches must not be freed by a registered
+  function directly. Instead, each thread that reads a shared cache
+  holds a reference, which is dropped by the flint_cleanup() of that
+  thread. The caches are freed when the last reference is dropped
+  (normally by flint_cleanup_master(), after the pool threads have
+  exited).
+
+  Without atomic builtins, the acquire loads and release stores used to
+  publish the caches (see arb.h) are done under a lock instead.
+*/
+
+#define SHARED_STATE_MAX_CLEAR 8
+
+static pthread_mutex_t shared_state_lock = PTHREAD_MUTEX_INITIALIZER;
+static slong shared_state_refcount = 0;
+static void (*shared_state_clear[SHARED_STATE_MAX_CLEAR])(void);
+static int shared_state_num_clear = 0;
+static TLS_PREFIX int shared_state_held = 0;
+
+static void
+_arb_shared_state_release(void)
+{
+    int i;
+
+    pthread_mutex_lock(&shared_state_lock);
+
+    shared_state_held = 0;
+    shared_state_refcount--;
+
+    if (shared_state_refcount == 0)
+    {
+        for (i = 0; i < shared_state_num_clear; i++)
+            shared_state_clear[i]();
+    }
+
+    pthread_mutex_unlock(&shared_state_lock);
+}
+
+void
+_arb_shared_state_hold(void)
+{
+    if (shared_state_held)
+        return;
+
+    pthread_mutex_lock(&shared_state_lock);
+    shared_state_refcount++;
+    shared_state_held = 1;
+    pthread_mutex_unlock(&shared_state_lock);
+
+    flint_register_cleanup_function(_arb_shared_state_release);
+}
+
+void
+_arb_shared_state_register(void (*clear_func)(void))
+{
+    int i;
+
+    pthread_mutex_lock(&shared_state_lock);
+
+    for (i = 0; i < shared_state_num_clear; i++)
+        if (shared_state_clear[i] == clear_func)
+            break;
+
+    if (i == shared_state_num_clear)
+    {
+        if (i == SHARED_STATE_MAX_CLEAR)
+        {
+            flint_printf("_arb_shared_state_register: too many caches\n");
+            flint_abort();
+        }
+
+        shared_state_clear[shared_state_num_clear++] = clear_func;
+    }
+
+    pthread_mutex_unlock(&shared_state_lock);
+}
+
+#if !(defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+
+static pthread_mutex_t shared_publish_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void *
+_arb_shared_load_ptr(void * const * p)
+{
+    void * v;
+    pthread_mutex_lock(&shared_publish_lock);
+    v = *p;
+    pthread_mutex_unlock(&shared_publish_lock);
+    return v;
+}
+
+void
+_arb_shared_store_ptr(void ** p, void * v)
+{
+    pthread_mutex_lock(&shared_publish_lock);
+    *p = v;
+    pthread_mutex_unlock(&shared_publish_lock);
+}
+
+slong
+_arb_shared_load_si(const slong * p)
+{
+    slong v;
+    pthread_mutex_lock(&shared_publish_lock);
+    v = *p;
+    pthread_mutex_unlock(&shared_publish_lock);
+    return v;
+}
+
+void
+_arb_shared_store_si(slong * p, slong v)
+{
+    pthread_mutex_lock(&shared_publish_lock);
+    *p = v;
+    pthread_mutex_unlock(&shared_publish_lock);
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+/*
+  Computes sin(x) and cos(x) using the extended tables. We write
+  |x| = a + r with a = p1 / 2^5 + p2 / 2^10 and 0 <= r < 2^-10 (exactly),
+  compute sin(r) and cos(r) using the generic algorithm, and
+  combine them with the table values using the addition formulas.
+  Requires |x| < 1.
+*/
+void
+arb_sin_cos_arf_ext(arb_t res_sin, arb_t res_cos, const arf_t x, slong prec)
+{
+    arb_t s, c, sa, ca, s1, c1, t;
+    mp_srcptr tab1, tab2;
+    slong limbs1, limbs2, wp, p, p1, p2;
+    arf_t r, y;
+    fmpz_t q;
+    int negative;
+
+    negative = ARF_SGNBIT(x);
+
+    /* sin(x) >= 2^-12 when the tables are used by arb_sin_cos_arf_generic */
+    wp = prec + 20 + FLINT_BIT_COUNT(prec);
+
+    arb_init(s);
+    arb_init(c);
+    arb_init(sa);
+    arb_init(ca);
+    arb_init(s1);
+    arb_init(c1);
+    arb_init(t);
+    arf_init(r);
+    arf_init(y);
+    fmpz_init(q);
+
+    /* p = floor(|x| 2^10) and r = |x| - p / 2^10, both exact */
+    arf_abs(y, x);
+    arf_mul_2exp_si(y, y, ARB_EXT_TAB1_BITS + ARB_EXT_TAB2_BITS);
+    arf_get_fmpz(q, y, ARF_RND_FLOOR);
+    p = fmpz_get_si(q);
+    arf_sub_fmpz(r, y, q, ARF_PREC_EXACT, ARF_RND_DOWN);
+    arf_mul_2exp_si(r, r, -(ARB_EXT_TAB1_BITS + ARB_EXT_TAB2_BITS));
+
+    p1 = p >> ARB_EXT_TAB2_BITS;
+    p2 = p & ((WORD(1) << ARB_EXT_TAB2_BITS) - 1);
+
+    arb_sin_cos_arf_rs_generic(s, c, r, wp);
+
+    /* sin(a), cos(a) for a = p1 / 2^5 + p2 / 2^10 */
+    tab1 = _arb_ext_tab(&limbs1, ARB_EXT_TAB_SIN_COS1, wp);
+    tab2 = _arb_ext_tab(&limbs2, ARB_EXT_TAB_SIN_COS2, wp);
+
+    _arb_ext_tab_get(s1, tab1, limbs1, 2 * p1, wp);
+    _arb_ext_tab_get(c1, tab1, limbs1, 2 * p1 + 1, wp);
+
+    if (p2 == 0)
+    {
+        arb_swap(sa, s1);
+        arb_swap(ca, c1);
+    }
+    else
+    {
+        arb_t s2, c2;
+
+        arb_init(s2);
+        arb_init(c2);
+
+        _arb_ext_tab_get(s2, tab2, limbs2, 2 * p2, wp);
+        _arb_ext_tab_get(c2, tab2, limbs2, 2 * p2 + 1, wp);
+
+        arb_mul(sa, s1, c2, wp);
+        arb_addmul(sa, c1, s2, wp);
+        arb_mul(ca, c1, c2, wp);
+        arb_submul(ca, s1, s2, wp);
+
+        arb_clear(s2);
+        arb_clear(c2);
+    }
+
+    /* sin(a + r) = sin(a) cos(r) + cos(a) sin(r) */
+    if (res_sin != NULL)
+    {
+        arb_mul(t, sa, c, wp);
+        arb_addmul(t, ca, s, wp);
+        arb_set_round(res_sin, t, prec);
+        if (negative)
+            arb_neg(res_sin, res_sin);
+    }
+
+    /* cos(a + r) = cos(a) cos(r) - sin(a) sin(r) */
+    if (res_cos != NULL)
+    {
+        arb_mul(t, ca, c, wp);
+        arb_submul(t, sa, s, wp);
+        arb_set_round(res_cos, t, prec);
+    }
+
+    arb_clear(s);
+    arb_clear(c);
+    arb_clear(sa);
+    arb_clear(ca);
+    arb_clear(s1);
+    arb_clear(c1);
+    arb_clear(t);
+    arf_clear(r);
+    arf_clear(y);
+    fmpz_clear(q);
+}
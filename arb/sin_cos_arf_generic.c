@@ -269,7 +269,10 @@ arb_sin_cos_arf_generic(arb_t res_sin, arb_t res_cos, const arf_t x, slong prec)
     }
     else if (mag <= 0)  /* todo: compare with pi/4-eps instead? */
     {
-        if (prec < 90000 || mag < -prec / 16 ||
+        if (arb_use_extended_tables && mag > -ARB_EXT_TAB1_BITS - ARB_EXT_TAB2_BITS &&
+            prec > ARB_SIN_COS_TAB2_PREC && prec <= ARB_EXT_TAB_PREC)
+            arb_sin_cos_arf_ext(res_sin, res_cos, x, prec);
+        else if (prec < 90000 || mag < -prec / 16 ||
             /* rs is faster for even smaller prec/N than this but has high memory usage */
             (prec < 100000000 && mag < -prec / 128))
             arb_sin_cos_arf_rs_generic(res_sin, res_cos, x, prec);
@@ -0,0 +1,142 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+typedef struct
+{
+    arb_ptr v;
+    arb_srcptr x;
+    slong prec;
+}
+work_t;
+
+static void
+worker(slong i, void * arg)
+{
+    work_t * work = (work_t *) arg;
+    arb_mul(work->v + i, work->x + i, work->x + i, work->prec);
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("arena....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000 * arb_test_multiplier(); iter++)
+    {
+        arb_arena_t A;
+        arb_ptr x, y1, v, w;
+        work_t work;
+        slong i, n, m, prec;
+
+        n = n_randint(state, 100);
+        m = n_randint(state, 100);
+        prec = 2 + n_randint(state, 1000);
+
+        x = _arb_vec_init(n);
+        y1 = _arb_vec_init(n);
+
+        for (i = 0; i < n; i++)
+            arb_randtest(x + i, state, 2 + n_randint(state, 1000), 10);
+
+        for (i = 0; i < n; i++)
+        {
+            arb_mul(y1 + i, x + i, x + i, prec);
+            arb_add(y1 + i, y1 + i, x + i, prec);
+        }
+
+        arb_arena_init(A);
+        arb_arena_push(A);
+
+        v = arb_arena_vec(A, n);
+
+        for (i = 0; i < n; i++)
+        {
+            if (!arb_is_zero(v + i))
+            {
+                flint_printf("FAIL (zero)\n\n");
+                flint_abort();
+            }
+        }
+
+        for (i = 0; i < n; i++)
+            arb_mul(v + i, x + i, x + i, prec);
+
+        /* a nested scope; entries of the outer scope are also
+           written while it is open */
+        arb_arena_push(A);
+        w = arb_arena_vec(A, m);
+
+        for (i = 0; i < m; i++)
+            arb_randtest(w + i, state, 2 + n_randint(state, 2000), 10);
+
+        for (i = 0; i < n; i++)
+            arb_add(v + i, v + i, x + i, prec);
+
+        for (i = 0; i < FLINT_MIN(n, m); i++)
+            arb_swap(w + i, v + i);
+        for (i = 0; i < FLINT_MIN(n, m); i++)
+            arb_swap(w + i, v + i);
+
+        arb_arena_pop(A);
+
+        w = arb_arena_vec(A, m);
+        for (i = 0; i < m; i++)
+            arb_randtest(w + i, state, 2 + n_randint(state, 2000), 10);
+
+        for (i = 0; i < n; i++)
+        {
+            if (!arb_equal(v + i, y1 + i))
+            {
+                flint_printf("FAIL\n\n");
+                flint_printf("x = "); arb_printd(x + i, 30); flint_printf("\n\n");
+                flint_printf("y1 = "); arb_printd(y1 + i, 30); flint_printf("\n\n");
+                flint_printf("v = "); arb_printd(v + i, 30); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        /* writes from other threads use the ordinary allocator */
+        flint_set_num_threads(1 + n_randint(state, 4));
+        work.v = arb_arena_vec(A, n);
+        work.x = x;
+        work.prec = prec;
+        flint_parallel_do(worker, &work, n, -1, FLINT_PARALLEL_STRIDED);
+
+        for (i = 0; i < n; i++)
+        {
+            arb_add(work.v + i, work.v + i, x + i, prec);
+
+            if (!arb_equal(work.v + i, y1 + i))
+            {
+                flint_printf("FAIL (threads)\n\n");
+                flint_abort();
+            }
+        }
+
+        arb_arena_pop(A);
+        arb_arena_clear(A);
+
+        _arb_vec_clear(x, n);
+        _arb_vec_clear(y1, n);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("dot_threads....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 20 * arb_test_multiplier(); iter++)
+    {
+        arb_ptr x, y;
+        arb_t s1, s2, s3;
+        slong i, len, prec;
+        int subtract;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        len = 8192 + n_randint(state, 10000);
+        prec = 2 + n_randint(state, 300);
+        subtract = n_randint(state, 2);
+
+        x = _arb_vec_init(len);
+        y = _arb_vec_init(len);
+        arb_init(s1);
+        arb_init(s2);
+        arb_init(s3);
+
+        for (i = 0; i < len; i++)
+        {
+            arb_randtest(x + i, state, 2 + n_randint(state, 300), 2 + n_randint(state, 10));
+            arb_randtest(y + i, state, 2 + n_randint(state, 300), 2 + n_randint(state, 10));
+        }
+
+        arb_randtest(s1, state, 2 + n_randint(state, 300), 10);
+        arb_set(s2, s1);
+        arb_set(s3, s1);
+
+        arb_dot_use_threads = 0;
+        arb_dot(s1, s1, subtract, x, 1, y, 1, len, prec);
+        arb_dot_use_threads = 1;
+        arb_dot(s2, s2, subtract, x, 1, y, 1, len, prec);
+        arb_dot_use_threads = 0;
+        arb_dot_simple(s3, s3, subtract, x, 1, y, 1, len, prec);
+
+        if (!arb_equal(s1, s2) || !arb_overlaps(s1, s3))
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("len = %wd, prec = %wd\n\n", len, prec);
+            flint_printf("s1 = "); arb_printd(s1, 30); flint_printf("\n\n");
+            flint_printf("s2 = "); arb_printd(s2, 30); flint_printf("\n\n");
+            flint_printf("s3 = "); arb_printd(s3, 30); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        _arb_vec_clear(x, len);
+        _arb_vec_clear(y, len);
+        arb_clear(s1);
+        arb_clear(s2);
+        arb_clear(s3);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+static void
+check(const char * name, const arb_t x, const arb_t y1, const arb_t y2, slong prec)
+{
+    if (!arb_overlaps(y1, y2) ||
+        (arb_is_exact(x) && arb_rel_accuracy_bits(y2) <
+            FLINT_MIN(arb_rel_accuracy_bits(y1), prec) - 8))
+    {
+        flint_printf("FAIL: %s\n\n", name);
+        flint_printf("prec = %wd\n\n", prec);
+        flint_printf("x = "); arb_printd(x, 30); flint_printf("\n\n");
+        flint_printf("y1 = "); arb_printd(y1, 30); flint_printf("\n\n");
+        flint_printf("y2 = "); arb_printd(y2, 30); flint_printf("\n\n");
+        flint_printf("acc = %wd\n\n", arb_rel_accuracy_bits(y2));
+        flint_abort();
+    }
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("ext_tab....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 300 * arb_test_multiplier(); iter++)
+    {
+        arb_t x, s1, s2, c1, c2;
+        slong prec;
+
+        arb_init(x);
+        arb_init(s1);
+        arb_init(s2);
+        arb_init(c1);
+        arb_init(c2);
+
+        prec = ARB_EXP_TAB2_PREC - 100 + n_randint(state, 8000);
+
+        if (n_randint(state, 2))
+        {
+            arb_urandom(x, state, prec + 100);
+            arb_mul_2exp_si(x, x, n_randint(state, 14) - 10);
+        }
+        else
+        {
+            arb_randtest(x, state, prec + 100, 4);
+        }
+
+        if (n_randint(state, 2))
+            arb_neg(x, x);
+
+        if (n_randint(state, 4) == 0)
+            mag_set_ui_2exp_si(arb_radref(x), 1, -prec - n_randint(state, 100));
+
+        arb_use_extended_tables = 0;
+        arb_exp(s1, x, prec);
+        arb_use_extended_tables = 1;
+        arb_exp(s2, x, prec);
+        check("exp", x, s1, s2, prec);
+
+        arb_use_extended_tables = 0;
+        arb_expm1(s1, x, prec);
+        arb_use_extended_tables = 1;
+        arb_expm1(s2, x, prec);
+        check("expm1", x, s1, s2, prec);
+
+        arb_use_extended_tables = 0;
+        arb_sin_cos(s1, c1, x, prec);
+        arb_use_extended_tables = 1;
+        arb_sin_cos(s2, c2, x, prec);
+        check("sin", x, s1, s2, prec);
+        check("cos", x, c1, c2, prec);
+
+        arb_use_extended_tables = 1;
+        arb_sin(s2, x, prec);
+        check("sin (2)", x, s1, s2, prec);
+        arb_cos(c2, x, prec);
+        check("cos (2)", x, c1, c2, prec);
+
+        arb_use_extended_tables = 0;
+        arb_atan(s1, x, prec);
+        arb_use_extended_tables = 1;
+        arb_atan(s2, x, prec);
+        check("atan", x, s1, s2, prec);
+
+        arb_use_extended_tables = 0;
+
+        arb_clear(x);
+        arb_clear(s1);
+        arb_clear(s2);
+        arb_clear(c1);
+        arb_clear(c2);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
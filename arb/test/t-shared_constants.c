@@ -0,0 +1,110 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+#define NUM_CONST 4
+#define MAX_PREC 4000
+
+typedef void (*const_func)(arb_t, slong);
+
+static const const_func funcs[NUM_CONST] = {
+    arb_const_e, arb_const_euler, arb_const_catalan, arb_const_log_sqrt2pi };
+
+typedef struct
+{
+    arb_srcptr ref;
+    slong * precs;
+    int * fail;
+}
+work_t;
+
+static void
+worker(slong i, void * _work)
+{
+    work_t * work = (work_t *) _work;
+    slong prec = work->precs[i];
+    arb_t x;
+
+    arb_init(x);
+
+    funcs[i % NUM_CONST](x, prec);
+
+    if (!arb_overlaps(x, work->ref + (i % NUM_CONST)) ||
+        arb_rel_accuracy_bits(x) < prec - 4)
+        work->fail[i] = 1;
+
+    arb_clear(x);
+}
+
+int main()
+{
+    slong iter, i, n;
+    flint_rand_t state;
+    arb_ptr ref;
+
+    flint_printf("shared_constants....");
+    fflush(stdout);
+    flint_randinit(state);
+
+    ref = _arb_vec_init(NUM_CONST);
+    for (i = 0; i < NUM_CONST; i++)
+        funcs[i](ref + i, MAX_PREC + 100);
+
+    arb_use_shared_constants = 1;
+
+    for (iter = 0; iter < 100 * arb_test_multiplier(); iter++)
+    {
+        work_t work;
+        slong * precs;
+        int * fail;
+
+        flint_set_num_threads(1 + n_randint(state, 8));
+
+        if (n_randint(state, 4) == 0)
+            arb_shared_constants_clear();
+
+        n = 1 + n_randint(state, 64);
+        precs = flint_malloc(sizeof(slong) * n);
+        fail = flint_calloc(n, sizeof(int));
+
+        for (i = 0; i < n; i++)
+            precs[i] = 2 + n_randint(state, 1 + n_randint(state, MAX_PREC));
+
+        work.ref = ref;
+        work.precs = precs;
+        work.fail = fail;
+
+        flint_parallel_do(worker, &work, n, -1, FLINT_PARALLEL_DYNAMIC);
+
+        for (i = 0; i < n; i++)
+        {
+            if (fail[i])
+            {
+                flint_printf("FAIL\n\n");
+                flint_printf("i = %wd, prec = %wd\n\n", i, precs[i]);
+                flint_abort();
+            }
+        }
+
+        flint_free(precs);
+        flint_free(fail);
+    }
+
+    arb_use_shared_constants = 0;
+
+    _arb_vec_clear(ref, NUM_CONST);
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
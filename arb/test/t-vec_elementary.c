@@ -0,0 +1,137 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("vec_elementary....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100 * arb_test_multiplier(); iter++)
+    {
+        arb_ptr x, y, s, c;
+        arb_t t, u;
+        slong i, len, prec;
+
+        flint_set_num_threads(1 + n_randint(state, 5));
+
+        if (n_randint(state, 4) == 0)
+        {
+            len = n_randint(state, 30);
+            prec = 2 + n_randint(state, 5000);
+        }
+        else
+        {
+            len = n_randint(state, 3000);
+            prec = 2 + n_randint(state, 200);
+        }
+
+        x = _arb_vec_init(len);
+        y = _arb_vec_init(len);
+        s = _arb_vec_init(len);
+        c = _arb_vec_init(len);
+        arb_init(t);
+        arb_init(u);
+
+        for (i = 0; i < len; i++)
+            arb_randtest_special(x + i, state, 2 + n_randint(state, 2 * prec), 1 + n_randint(state, 12));
+
+        _arb_vec_exp(y, x, len, prec);
+
+        for (i = 0; i < len; i++)
+        {
+            arb_exp(t, x + i, prec);
+
+            if (!arb_overlaps(t, y + i))
+            {
+                flint_printf("FAIL: exp\n\n");
+                flint_printf("threads = %d, len = %wd, prec = %wd, i = %wd\n",
+                    flint_get_num_threads(), len, prec, i);
+                flint_printf("x = "); arb_printd(x + i, 30); flint_printf("\n\n");
+                flint_printf("y = "); arb_printd(y + i, 30); flint_printf("\n\n");
+                flint_printf("t = "); arb_printd(t, 30); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        _arb_vec_sin_cos(s, c, x, len, prec);
+
+        for (i = 0; i < len; i++)
+        {
+            arb_sin_cos(t, u, x + i, prec);
+
+            if (!arb_overlaps(t, s + i) || !arb_overlaps(u, c + i))
+            {
+                flint_printf("FAIL: sin_cos\n\n");
+                flint_printf("threads = %d, len = %wd, prec = %wd, i = %wd\n",
+                    flint_get_num_threads(), len, prec, i);
+                flint_printf("x = "); arb_printd(x + i, 30); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        /* only one of sin and cos */
+        _arb_vec_zero(s, len);
+        _arb_vec_sin_cos(s, NULL, x, len, prec);
+        _arb_vec_sin_cos(NULL, y, x, len, prec);
+
+        for (i = 0; i < len; i++)
+        {
+            arb_sin(t, x + i, prec);
+            arb_cos(u, x + i, prec);
+
+            if (!arb_overlaps(t, s + i) || !arb_overlaps(u, y + i))
+            {
+                flint_printf("FAIL: sin or cos\n\n");
+                flint_printf("threads = %d, len = %wd, prec = %wd, i = %wd\n",
+                    flint_get_num_threads(), len, prec, i);
+                flint_printf("x = "); arb_printd(x + i, 30); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        /* aliasing */
+        _arb_vec_set(y, x, len);
+        _arb_vec_log(y, y, len, prec);
+
+        for (i = 0; i < len; i++)
+        {
+            arb_log(t, x + i, prec);
+
+            if (!arb_overlaps(t, y + i))
+            {
+                flint_printf("FAIL: log\n\n");
+                flint_printf("threads = %d, len = %wd, prec = %wd, i = %wd\n",
+                    flint_get_num_threads(), len, prec, i);
+                flint_printf("x = "); arb_printd(x + i, 30); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        _arb_vec_clear(x, len);
+        _arb_vec_clear(y, len);
+        _arb_vec_clear(s, len);
+        _arb_vec_clear(c, len);
+        arb_clear(t);
+        arb_clear(u);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+typedef struct
+{
+    arb_ptr res1;
+    arb_ptr res2;
+    arb_srcptr x;
+    void (*func1)(arb_t, const arb_t, slong);
+    void (*func2)(arb_t, arb_t, const arb_t, slong);
+    slong len;
+    slong block_size;
+    slong prec;
+}
+work_chunk_t;
+
+static void
+_arb_vec_elementary_range(const work_chunk_t * work, slong a, slong b)
+{
+    if (work->func2 != NULL)
+    {
+        for ( ; a < b; a++)
+            work->func2(work->res1 + a, work->res2 + a, work->x + a, work->prec);
+    }
+    else
+    {
+        for ( ; a < b; a++)
+            work->func1(work->res1 + a, work->x + a, work->prec);
+    }
+}
+
+static void
+worker(slong i, void * _work)
+{
+    work_chunk_t * work = (work_chunk_t *) _work;
+    slong a, b;
+
+    a = i * work->block_size;
+    b = FLINT_MIN(a + work->block_size, work->len);
+
+    _arb_vec_elementary_range(work, a, b);
+}
+
+void
+_arb_vec_elementary(arb_ptr res1, arb_ptr res2, arb_srcptr x, slong len,
+    void (*func1)(arb_t, const arb_t, slong),
+    void (*func2)(arb_t, arb_t, const arb_t, slong), slong prec)
+{
+    slong num_blocks;
+    work_chunk_t work;
+
+    work.res1 = res1;
+    work.res2 = res2;
+    work.x = x;
+    work.func1 = func1;
+    work.func2 = func2;
+    work.len = len;
+    work.block_size = _arb_vec_elementary_block_size(len, prec);
+    work.prec = prec;
+
+    if (work.block_size >= len)
+    {
+        _arb_vec_elementary_range(&work, 0, len);
+        return;
+    }
+
+    num_blocks = (len + work.block_size - 1) / work.block_size;
+
+    flint_parallel_do(worker, &work, num_blocks, -1, FLINT_PARALLEL_DYNAMIC);
+}
@@ -0,0 +1,40 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+/* Rough cost of evaluating one elementary function, in units of
+   about a nanosecond. */
+#define ELEMENTARY_COST(prec) (FLINT_MAX(prec, 64) * 4)
+
+/* Below this amount of work per block, thread dispatch overhead
+   dominates. */
+#define MIN_BLOCK_COST 50000
+
+/* Returns the number of consecutive entries each thread should
+   evaluate at a time, or len if the evaluation should be done in
+   the calling thread. Several blocks are used per thread since the
+   cost of each entry depends on the magnitude of the input. */
+slong
+_arb_vec_elementary_block_size(slong len, slong prec)
+{
+    slong num_threads, block_size, min_block;
+
+    num_threads = flint_get_num_threads();
+
+    if (num_threads <= 1 || len < 2)
+        return len;
+
+    min_block = (MIN_BLOCK_COST + ELEMENTARY_COST(prec) - 1) / ELEMENTARY_COST(prec);
+    block_size = FLINT_MAX(min_block, len / (8 * num_threads));
+
+    return FLINT_MIN(block_size, len);
+}
@@ -0,0 +1,18 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+void
+_arb_vec_log(arb_ptr res, arb_srcptr x, slong len, slong prec)
+{
+    _arb_vec_elementary(res, NULL, x, len, arb_log, NULL, prec);
+}
@@ -0,0 +1,26 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb.h"
+
+void
+_arb_vec_sin_cos(arb_ptr s, arb_ptr c, arb_srcptr x, slong len, slong prec)
+{
+    if (s == NULL && c == NULL)
+        return;
+
+    if (s == NULL)
+        _arb_vec_elementary(c, NULL, x, len, arb_cos, NULL, prec);
+    else if (c == NULL)
+        _arb_vec_elementary(s, NULL, x, len, arb_sin, NULL, prec);
+    else
+        _arb_vec_elementary(s, c, x, len, NULL, arb_sin_cos, prec);
+}
@@ -0,0 +1,80 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ARB_BINARY_H
+#define ARB_BINARY_H
+
+#include "arb_mat.h"
+#include "acb_mat.h"
+#include "arb_poly.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARB_BINARY_MAGIC UWORD(0x41524242)
+#define ARB_BINARY_VERSION 1
+#define ARB_BINARY_BYTE_ORDER UWORD(0x01020304)
+
+#define ARB_BINARY_HEADER_WORDS 9
+#define ARB_BINARY_RECORD_WORDS 5
+
+#define ARB_BINARY_ARB_VEC 1
+#define ARB_BINARY_ACB_VEC 2
+#define ARB_BINARY_ARB_MAT 3
+#define ARB_BINARY_ACB_MAT 4
+#define ARB_BINARY_ARB_POLY 5
+
+/* Writing */
+
+int _arb_binary_write(const char * filename, arb_srcptr vec, slong len,
+    int kind, slong rows, slong cols);
+
+int arb_binary_write_arb_vec(const char * filename, arb_srcptr vec, slong len);
+int arb_binary_write_acb_vec(const char * filename, acb_srcptr vec, slong len);
+int arb_binary_write_arb_mat(const char * filename, const arb_mat_t A);
+int arb_binary_write_acb_mat(const char * filename, const acb_mat_t A);
+int arb_binary_write_arb_poly(const char * filename, const arb_poly_t poly);
+
+/* Zero-copy views */
+
+typedef struct
+{
+    void * alloc;
+    size_t bytes;
+    int mapped;
+    int kind;
+    slong rows;
+    slong cols;
+    arb_ptr arb_entries;
+    acb_ptr acb_entries;
+}
+arb_binary_view_struct;
+
+typedef arb_binary_view_struct arb_binary_view_t[1];
+
+int arb_binary_view_init(arb_binary_view_t view, const char * filename);
+
+void arb_binary_view_clear(arb_binary_view_t view);
+
+/* Reading (deep copies) */
+
+int arb_binary_read_arb_vec(arb_ptr * res, slong * len, const char * filename);
+int arb_binary_read_acb_vec(acb_ptr * res, slong * len, const char * filename);
+int arb_binary_read_arb_mat(arb_mat_t A, const char * filename);
+int arb_binary_read_acb_mat(acb_mat_t A, const char * filename);
+int arb_binary_read_arb_poly(arb_poly_t poly, const char * filename);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
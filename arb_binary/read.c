@@ -0,0 +1,149 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_binary.h"
+
+static int
+_arb_binary_is_complex(int kind)
+{
+    return kind == ARB_BINARY_ACB_VEC || kind == ARB_BINARY_ACB_MAT;
+}
+
+int
+arb_binary_read_arb_vec(arb_ptr * res, slong * len, const char * filename)
+{
+    arb_binary_view_t view;
+    slong n;
+
+    if (arb_binary_view_init(view, filename) != 0)
+        return 1;
+
+    if (_arb_binary_is_complex(view->kind))
+    {
+        arb_binary_view_clear(view);
+        return 1;
+    }
+
+    n = view->rows * view->cols;
+    *res = _arb_vec_init(n);
+    _arb_vec_set(*res, view->arb_entries, n);
+    *len = n;
+
+    arb_binary_view_clear(view);
+    return 0;
+}
+
+int
+arb_binary_read_acb_vec(acb_ptr * res, slong * len, const char * filename)
+{
+    arb_binary_view_t view;
+    slong n;
+
+    if (arb_binary_view_init(view, filename) != 0)
+        return 1;
+
+    if (!_arb_binary_is_complex(view->kind))
+    {
+        arb_binary_view_clear(view);
+        return 1;
+    }
+
+    n = view->rows * view->cols;
+    *res = _acb_vec_init(n);
+    _acb_vec_set(*res, view->acb_entries, n);
+    *len = n;
+
+    arb_binary_view_clear(view);
+    return 0;
+}
+
+int
+arb_binary_read_arb_mat(arb_mat_t A, const char * filename)
+{
+    arb_binary_view_t view;
+    slong i, j, r, c;
+
+    if (arb_binary_view_init(view, filename) != 0)
+        return 1;
+
+    if (view->kind != ARB_BINARY_ARB_MAT)
+    {
+        arb_binary_view_clear(view);
+        return 1;
+    }
+
+    r = view->rows;
+    c = view->cols;
+
+    arb_mat_clear(A);
+    arb_mat_init(A, r, c);
+
+    for (i = 0; i < r; i++)
+        for (j = 0; j < c; j++)
+            arb_set(arb_mat_entry(A, i, j), view->arb_entries + i * c + j);
+
+    arb_binary_view_clear(view);
+    return 0;
+}
+
+int
+arb_binary_read_acb_mat(acb_mat_t A, const char * filename)
+{
+    arb_binary_view_t view;
+    slong i, j, r, c;
+
+    if (arb_binary_view_init(view, filename) != 0)
+        return 1;
+
+    if (view->kind != ARB_BINARY_ACB_MAT)
+    {
+        arb_binary_view_clear(view);
+        return 1;
+    }
+
+    r = view->rows;
+    c = view->cols;
+
+    acb_mat_clear(A);
+    acb_mat_init(A, r, c);
+
+    for (i = 0; i < r; i++)
+        for (j = 0; j < c; j++)
+            acb_set(acb_mat_entry(A, i, j), view->acb_entries + i * c + j);
+
+    arb_binary_view_clear(view);
+    return 0;
+}
+
+int
+arb_binary_read_arb_poly(arb_poly_t poly, const char * filename)
+{
+    arb_binary_view_t view;
+    slong n;
+
+    if (arb_binary_view_init(view, filename) != 0)
+        return 1;
+
+    if (_arb_binary_is_complex(view->kind))
+    {
+        arb_binary_view_clear(view);
+        return 1;
+    }
+
+    n = view->rows * view->cols;
+    arb_poly_fit_length(poly, n);
+    _arb_vec_set(poly->coeffs, view->arb_entries, n);
+    _arb_poly_set_length(poly, n);
+    _arb_poly_normalise(poly);
+
+    arb_binary_view_clear(view);
+    return 0;
+}
@@ -0,0 +1,233 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include "arb_binary.h"
+
+#define FILENAME "arb_binary_test.bin"
+
+static int
+_arb_vec_equal(arb_srcptr x, arb_srcptr y, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        if (!arb_equal(x + i, y + i))
+            return 0;
+
+    return 1;
+}
+
+static int
+_acb_vec_equal(acb_srcptr x, acb_srcptr y, slong len)
+{
+    return _arb_vec_equal((arb_srcptr) x, (arb_srcptr) y, 2 * len);
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("binary....");
+    fflush(stdout);
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200 * arb_test_multiplier(); iter++)
+    {
+        slong i, j, n, m, len, prec;
+        arb_ptr x, y;
+        acb_ptr z, w;
+        arb_mat_t A, B;
+        acb_mat_t C, D;
+        arb_poly_t P, Q;
+        arb_binary_view_t view;
+        arb_t t;
+
+        n = n_randint(state, 20);
+        m = n_randint(state, 6);
+        prec = 2 + n_randint(state, 1000);
+
+        x = _arb_vec_init(n);
+        z = _acb_vec_init(n);
+        arb_mat_init(A, m, n % 5);
+        acb_mat_init(C, n % 5, m);
+        arb_mat_init(B, 0, 0);
+        acb_mat_init(D, 0, 0);
+        arb_poly_init(P);
+        arb_poly_init(Q);
+        arb_init(t);
+
+        for (i = 0; i < n; i++)
+        {
+            arb_randtest_special(x + i, state, prec, 10);
+            acb_randtest_special(z + i, state, prec, 10);
+        }
+
+        arb_mat_randtest(A, state, prec, 10);
+        acb_mat_randtest(C, state, prec, 10);
+        arb_poly_randtest(P, state, n, prec, 10);
+
+        /* vectors: deep copy and zero-copy view */
+        if (arb_binary_write_arb_vec(FILENAME, x, n) != 0 ||
+            arb_binary_read_arb_vec(&y, &len, FILENAME) != 0)
+        {
+            flint_printf("FAIL: arb_vec i/o\n\n");
+            flint_abort();
+        }
+
+        if (len != n || !_arb_vec_equal(x, y, n))
+        {
+            flint_printf("FAIL: arb_vec\n\n");
+            flint_abort();
+        }
+
+        if (arb_binary_view_init(view, FILENAME) != 0 ||
+            view->kind != ARB_BINARY_ARB_VEC ||
+            !_arb_vec_equal(x, view->arb_entries, n))
+        {
+            flint_printf("FAIL: arb_vec view\n\n");
+            flint_abort();
+        }
+
+        /* view entries can be used as inputs */
+        if (n > 0)
+        {
+            arb_add(t, view->arb_entries, view->arb_entries + n - 1, prec);
+            arb_add(y, x, x + n - 1, prec);
+
+            if (!arb_equal(t, y))
+            {
+                flint_printf("FAIL: view arithmetic\n\n");
+                flint_abort();
+            }
+        }
+
+        arb_binary_view_clear(view);
+        _arb_vec_clear(y, len);
+
+        if (arb_binary_write_acb_vec(FILENAME, z, n) != 0 ||
+            arb_binary_read_acb_vec(&w, &len, FILENAME) != 0)
+        {
+            flint_printf("FAIL: acb_vec i/o\n\n");
+            flint_abort();
+        }
+
+        if (len != n || !_acb_vec_equal(z, w, n))
+        {
+            flint_printf("FAIL: acb_vec\n\n");
+            flint_abort();
+        }
+
+        _acb_vec_clear(w, len);
+
+        /* a complex file is not a real vector */
+        if (arb_binary_read_arb_vec(&y, &len, FILENAME) == 0)
+        {
+            flint_printf("FAIL: kind\n\n");
+            flint_abort();
+        }
+
+        /* matrices and polynomials */
+        if (arb_binary_write_arb_mat(FILENAME, A) != 0 ||
+            arb_binary_read_arb_mat(B, FILENAME) != 0 || !arb_mat_equal(A, B))
+        {
+            flint_printf("FAIL: arb_mat\n\n");
+            flint_abort();
+        }
+
+        if (arb_binary_write_acb_mat(FILENAME, C) != 0 ||
+            arb_binary_read_acb_mat(D, FILENAME) != 0 || !acb_mat_equal(C, D))
+        {
+            flint_printf("FAIL: acb_mat\n\n");
+            flint_abort();
+        }
+
+        if (arb_binary_view_init(view, FILENAME) != 0 ||
+            view->rows != acb_mat_nrows(C) || view->cols != acb_mat_ncols(C))
+        {
+            flint_printf("FAIL: acb_mat view\n\n");
+            flint_abort();
+        }
+
+        for (i = 0; i < view->rows; i++)
+        {
+            for (j = 0; j < view->cols; j++)
+            {
+                if (!acb_equal(acb_mat_entry(C, i, j),
+                        view->acb_entries + i * view->cols + j))
+                {
+                    flint_printf("FAIL: acb_mat view entry\n\n");
+                    flint_abort();
+                }
+            }
+        }
+
+        arb_binary_view_clear(view);
+
+        if (arb_binary_write_arb_poly(FILENAME, P) != 0 ||
+            arb_binary_read_arb_poly(Q, FILENAME) != 0 || !arb_poly_equal(P, Q))
+        {
+            flint_printf("FAIL: arb_poly\n\n");
+            flint_abort();
+        }
+
+        /* a truncated file is rejected */
+        if (n > 0)
+        {
+            FILE * fp;
+            char * buf;
+            long size;
+
+            arb_binary_write_arb_vec(FILENAME, x, n);
+
+            fp = fopen(FILENAME, "rb");
+            fseek(fp, 0, SEEK_END);
+            size = ftell(fp);
+            fseek(fp, 0, SEEK_SET);
+            buf = flint_malloc(size);
+            if (fread(buf, 1, size, fp) != (size_t) size)
+            {
+                flint_printf("FAIL: fread\n\n");
+                flint_abort();
+            }
+            fclose(fp);
+
+            fp = fopen(FILENAME, "wb");
+            fwrite(buf, 1, size - sizeof(ulong), fp);
+            fclose(fp);
+            flint_free(buf);
+
+            if (arb_binary_view_init(view, FILENAME) == 0)
+            {
+                flint_printf("FAIL: truncated\n\n");
+                flint_abort();
+            }
+        }
+
+        remove(FILENAME);
+
+        _arb_vec_clear(x, n);
+        _acb_vec_clear(z, n);
+        arb_mat_clear(A);
+        arb_mat_clear(B);
+        acb_mat_clear(C);
+        acb_mat_clear(D);
+        arb_poly_clear(P);
+        arb_poly_clear(Q);
+        arb_clear(t);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
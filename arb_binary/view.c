@@ -0,0 +1,207 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_binary.h"
+#include "arb_cache.h"
+
+static int
+_arb_binary_exp_ok(ulong e)
+{
+    return (slong) e >= COEFF_MIN && (slong) e <= COEFF_MAX;
+}
+
+/* Checks that the header and the records describe valid, normalised
+   balls whose limbs lie inside the limb pool. */
+static int
+_arb_binary_validate(const ulong * data, slong len)
+{
+    const ulong * rec;
+    mp_srcptr pool;
+    ulong n, limbs, xn, off;
+    ulong exp, man;
+    slong i;
+
+    if (len < ARB_BINARY_HEADER_WORDS ||
+        data[0] != ARB_BINARY_MAGIC ||
+        data[1] != ARB_BINARY_VERSION ||
+        data[2] != FLINT_BITS ||
+        data[3] != ARB_BINARY_BYTE_ORDER)
+        return 0;
+
+    if (data[4] < ARB_BINARY_ARB_VEC || data[4] > ARB_BINARY_ARB_POLY)
+        return 0;
+
+    n = data[7];
+    limbs = data[8];
+
+    if (n > (ulong) (len - ARB_BINARY_HEADER_WORDS) / ARB_BINARY_RECORD_WORDS ||
+        limbs != (ulong) len - ARB_BINARY_HEADER_WORDS - n * ARB_BINARY_RECORD_WORDS)
+        return 0;
+
+    /* the shape must match the number of balls */
+    if ((slong) data[5] < 0 || (slong) data[6] < 0 ||
+        (data[5] != 0 && data[6] > n / data[5]))
+        return 0;
+
+    if (data[4] == ARB_BINARY_ACB_VEC || data[4] == ARB_BINARY_ACB_MAT)
+    {
+        if (2 * data[5] * data[6] != n)
+            return 0;
+    }
+    else
+    {
+        if (data[5] * data[6] != n)
+            return 0;
+    }
+
+    pool = data + ARB_BINARY_HEADER_WORDS + n * ARB_BINARY_RECORD_WORDS;
+
+    for (i = 0; i < (slong) n; i++)
+    {
+        rec = data + ARB_BINARY_HEADER_WORDS + i * ARB_BINARY_RECORD_WORDS;
+
+        exp = rec[0];
+        xn = rec[1] >> 1;
+        off = rec[2];
+
+        if (!_arb_binary_exp_ok(exp))
+            return 0;
+
+        if (xn == 0)
+        {
+            if (rec[1] != 0 || (exp != ARF_EXP_ZERO && exp != ARF_EXP_NAN &&
+                exp != ARF_EXP_POS_INF && exp != ARF_EXP_NEG_INF))
+                return 0;
+        }
+        else
+        {
+            if (off > limbs || xn > limbs - off)
+                return 0;
+
+            /* normalised: top bit set, no trailing zero limbs */
+            if ((pool[off + xn - 1] >> (FLINT_BITS - 1)) == 0 || pool[off] == 0)
+                return 0;
+        }
+
+        exp = rec[3];
+        man = rec[4];
+
+        if (!_arb_binary_exp_ok(exp))
+            return 0;
+
+        if (man == 0)
+        {
+            if (exp != 0 && exp != MAG_EXP_POS_INF)
+                return 0;
+        }
+        else if ((man >> (MAG_BITS - 1)) != 1)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+void
+arb_binary_view_clear(arb_binary_view_t view)
+{
+    flint_free(view->arb_entries);
+    _arb_cache_unmap_file(view->alloc, view->bytes, view->mapped);
+
+    view->alloc = NULL;
+    view->bytes = 0;
+    view->mapped = 0;
+    view->kind = 0;
+    view->rows = 0;
+    view->cols = 0;
+    view->arb_entries = NULL;
+    view->acb_entries = NULL;
+}
+
+int
+arb_binary_view_init(arb_binary_view_t view, const char * filename)
+{
+    const ulong * data;
+    const ulong * rec;
+    mp_srcptr pool;
+    arb_ptr x;
+    void * alloc;
+    size_t bytes;
+    int mapped;
+    slong i, n, xn;
+
+    view->alloc = NULL;
+    view->bytes = 0;
+    view->mapped = 0;
+    view->kind = 0;
+    view->rows = 0;
+    view->cols = 0;
+    view->arb_entries = NULL;
+    view->acb_entries = NULL;
+
+    if (_arb_cache_map_file(&alloc, &bytes, &mapped, filename) != 0)
+        return 1;
+
+    if (bytes % sizeof(ulong) != 0 ||
+        !_arb_binary_validate(alloc, bytes / sizeof(ulong)))
+    {
+        _arb_cache_unmap_file(alloc, bytes, mapped);
+        return 1;
+    }
+
+    data = alloc;
+    n = data[7];
+    pool = data + ARB_BINARY_HEADER_WORDS + n * ARB_BINARY_RECORD_WORDS;
+
+    /* Shallow balls: short mantissas are copied inline, longer ones
+       point directly into the file data. */
+    x = flint_malloc(sizeof(arb_struct) * FLINT_MAX(n, 1));
+
+    for (i = 0; i < n; i++)
+    {
+        rec = data + ARB_BINARY_HEADER_WORDS + i * ARB_BINARY_RECORD_WORDS;
+
+        xn = rec[1] >> 1;
+
+        ARF_EXP(arb_midref(x + i)) = (slong) rec[0];
+        ARF_XSIZE(arb_midref(x + i)) = (mp_size_t) rec[1];
+
+        if (xn <= ARF_NOPTR_LIMBS)
+        {
+            if (xn >= 1)
+                ARF_NOPTR_D(arb_midref(x + i))[0] = pool[rec[2]];
+            if (xn == 2)
+                ARF_NOPTR_D(arb_midref(x + i))[1] = pool[rec[2] + 1];
+        }
+        else
+        {
+            ARF_PTR_D(arb_midref(x + i)) = (mp_ptr) (pool + rec[2]);
+            ARF_PTR_ALLOC(arb_midref(x + i)) = xn;
+        }
+
+        MAG_EXP(arb_radref(x + i)) = (slong) rec[3];
+        MAG_MAN(arb_radref(x + i)) = rec[4];
+    }
+
+    view->alloc = alloc;
+    view->bytes = bytes;
+    view->mapped = mapped;
+    view->kind = data[4];
+    view->rows = data[5];
+    view->cols = data[6];
+    view->arb_entries = x;
+
+    if (view->kind == ARB_BINARY_ACB_VEC || view->kind == ARB_BINARY_ACB_MAT)
+        view->acb_entries = (acb_ptr) x;
+
+    return 0;
+}
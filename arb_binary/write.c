@@ -0,0 +1,181 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include "arb_binary.h"
+
+/*
+  File layout (words of type ulong, native byte order):
+
+    header: magic, version, FLINT_BITS, byte order probe, kind,
+            rows, cols, number of balls n, number of limbs L
+
+    n records of ARB_BINARY_RECORD_WORDS words:
+            midpoint exponent, midpoint size field (limb count and sign),
+            offset of the midpoint limbs in the limb pool,
+            radius exponent, radius mantissa
+
+    the limb pool: the midpoint limbs of all balls, contiguously
+
+  The exponents are stored as the raw (small) fmpz values, so that a
+  view can point directly at the limbs in a mapped file. Balls with
+  exponents that do not fit in a small fmpz are not supported.
+*/
+
+static int
+_arb_binary_exponents_ok(const arb_t x)
+{
+    return !COEFF_IS_MPZ(ARF_EXP(arb_midref(x))) &&
+           !COEFF_IS_MPZ(MAG_EXP(arb_radref(x)));
+}
+
+int
+_arb_binary_write(const char * filename, arb_srcptr vec, slong len,
+    int kind, slong rows, slong cols)
+{
+    ulong header[ARB_BINARY_HEADER_WORDS];
+    ulong rec[ARB_BINARY_RECORD_WORDS];
+    slong i, xn, limbs;
+    mp_srcptr xp;
+    FILE * fp;
+    int ok;
+
+    limbs = 0;
+    for (i = 0; i < len; i++)
+    {
+        if (!_arb_binary_exponents_ok(vec + i))
+            return 1;
+
+        limbs += ARF_SIZE(arb_midref(vec + i));
+    }
+
+    fp = fopen(filename, "wb");
+    if (fp == NULL)
+        return 1;
+
+    header[0] = ARB_BINARY_MAGIC;
+    header[1] = ARB_BINARY_VERSION;
+    header[2] = FLINT_BITS;
+    header[3] = ARB_BINARY_BYTE_ORDER;
+    header[4] = kind;
+    header[5] = rows;
+    header[6] = cols;
+    header[7] = len;
+    header[8] = limbs;
+
+    ok = (fwrite(header, sizeof(ulong), ARB_BINARY_HEADER_WORDS, fp) == ARB_BINARY_HEADER_WORDS);
+
+    limbs = 0;
+    for (i = 0; i < len && ok; i++)
+    {
+        rec[0] = ARF_EXP(arb_midref(vec + i));
+        rec[1] = ARF_XSIZE(arb_midref(vec + i));
+        rec[2] = limbs;
+        rec[3] = MAG_EXP(arb_radref(vec + i));
+        rec[4] = MAG_MAN(arb_radref(vec + i));
+
+        limbs += ARF_SIZE(arb_midref(vec + i));
+
+        ok = (fwrite(rec, sizeof(ulong), ARB_BINARY_RECORD_WORDS, fp) == ARB_BINARY_RECORD_WORDS);
+    }
+
+    for (i = 0; i < len && ok; i++)
+    {
+        xn = ARF_SIZE(arb_midref(vec + i));
+
+        if (xn != 0)
+        {
+            if (ARF_HAS_PTR(arb_midref(vec + i)))
+                xp = ARF_PTR_D(arb_midref(vec + i));
+            else
+                xp = ARF_NOPTR_D(arb_midref(vec + i));
+
+            ok = (fwrite(xp, sizeof(mp_limb_t), xn, fp) == (size_t) xn);
+        }
+    }
+
+    if (fclose(fp) != 0)
+        ok = 0;
+
+    return !ok;
+}
+
+int
+arb_binary_write_arb_vec(const char * filename, arb_srcptr vec, slong len)
+{
+    return _arb_binary_write(filename, vec, len, ARB_BINARY_ARB_VEC, 1, len);
+}
+
+int
+arb_binary_write_arb_poly(const char * filename, const arb_poly_t poly)
+{
+    return _arb_binary_write(filename, poly->coeffs, poly->length,
+        ARB_BINARY_ARB_POLY, 1, poly->length);
+}
+
+/* acb_struct consists of the real and imaginary parts as consecutive
+   arb_structs, so a complex vector is written as a real vector of
+   twice the length. */
+
+int
+arb_binary_write_acb_vec(const char * filename, acb_srcptr vec, slong len)
+{
+    return _arb_binary_write(filename, (arb_srcptr) vec, 2 * len,
+        ARB_BINARY_ACB_VEC, 1, len);
+}
+
+int
+arb_binary_write_arb_mat(const char * filename, const arb_mat_t A)
+{
+    slong r, c, i, j;
+    arb_ptr tmp;
+    int result;
+
+    r = arb_mat_nrows(A);
+    c = arb_mat_ncols(A);
+
+    /* shallow copy of the entries in row-major order */
+    tmp = flint_malloc(sizeof(arb_struct) * FLINT_MAX(r * c, 1));
+    for (i = 0; i < r; i++)
+        for (j = 0; j < c; j++)
+            tmp[i * c + j] = *arb_mat_entry(A, i, j);
+
+    result = _arb_binary_write(filename, tmp, r * c, ARB_BINARY_ARB_MAT, r, c);
+
+    flint_free(tmp);
+    return result;
+}
+
+int
+arb_binary_write_acb_mat(const char * filename, const acb_mat_t A)
+{
+    slong r, c, i, j;
+    arb_ptr tmp;
+    int result;
+
+    r = acb_mat_nrows(A);
+    c = acb_mat_ncols(A);
+
+    tmp = flint_malloc(2 * sizeof(arb_struct) * FLINT_MAX(r * c, 1));
+    for (i = 0; i < r; i++)
+    {
+        for (j = 0; j < c; j++)
+        {
+            tmp[2 * (i * c + j)] = *acb_realref(acb_mat_entry(A, i, j));
+            tmp[2 * (i * c + j) + 1] = *acb_imagref(acb_mat_entry(A, i, j));
+        }
+    }
+
+    result = _arb_binary_write(filename, tmp, 2 * r * c, ARB_BINARY_ACB_MAT, r, c);
+
+    flint_free(tmp);
+    return result;
+}
@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ARB_CACHE_H
+#define ARB_CACHE_H
+
+#include "flint/fmpq.h"
+#include "arb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* File format */
+
+#define ARB_CACHE_MAGIC UWORD(0x41524243)
+#define ARB_CACHE_VERSION 1
+#define ARB_CACHE_BYTE_ORDER UWORD(0x01020304)
+
+#define ARB_CACHE_HEADER_WORDS 7
+#define ARB_CACHE_ENTRY_WORDS 7
+
+#define ARB_CACHE_CONST 1
+#define ARB_CACHE_BERNOULLI 2
+#define ARB_CACHE_GL 3
+
+/* Loading and writing */
+
+int arb_cache_load(const char * filename);
+
+void arb_cache_unload(void);
+
+int arb_cache_is_loaded(void);
+
+int arb_cache_write(const char * filename, slong prec, slong bernoulli_num, slong gl_max_points);
+
+/* Internal */
+
+ulong _arb_cache_checksum(const ulong * data, slong len);
+
+int _arb_cache_map_file(void ** alloc, size_t * bytes, int * mapped, const char * filename);
+
+void _arb_cache_unmap_file(void * alloc, size_t bytes, int mapped);
+
+slong _arb_cache_bernoulli_load(fmpq * res, slong start, slong stop);
+
+slong _arb_cache_gl_load(arb_ptr nodes, arb_ptr weights, slong n, slong prec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
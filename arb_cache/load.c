@@ -0,0 +1,419 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "arb_cache.h"
+
+/*
+  The cache file is a sequence of words (ulong, in native byte order):
+
+    magic, version, FLINT_BITS, byte order probe, total number of words,
+    number of entries, checksum of all words after the header
+
+  followed by the entries, each consisting of the words
+
+    type, precision, count, name offset, name length in bytes,
+    data offset, data length
+
+  (offsets are word indices from the start of the file), followed by the
+  data. Integers are stored as a signed limb count followed by the
+  absolute value as limbs, and floating-point numbers as a kind
+  (0 = finite, 1 = zero, 2 = +inf, 3 = -inf, 4 = nan) followed, for
+  finite numbers, by the exponent and mantissa as integers. A ball
+  is stored as its midpoint followed by its radius.
+
+  The file is loaded once (mapped read-only if possible) and is never
+  modified afterwards, so lookups can be done from any thread. Every
+  payload is checked to lie within its entry when the file is loaded,
+  so the readers below do not need to check bounds.
+*/
+
+static const ulong * cache_data = NULL;
+static slong cache_len = 0;
+static void * cache_alloc = NULL;
+static size_t cache_bytes = 0;
+static int cache_mapped = 0;
+
+ulong
+_arb_cache_checksum(const ulong * data, slong len)
+{
+    ulong a, b;
+    slong i;
+
+    a = 1;
+    b = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        a += data[i];
+        b += a;
+    }
+
+    return a ^ ((b << 1) | (b >> (FLINT_BITS - 1)));
+}
+
+static const ulong *
+_arb_cache_read_fmpz(fmpz_t x, const ulong * p)
+{
+    slong n, an;
+
+    n = (slong) p[0];
+    an = FLINT_ABS(n);
+
+    if (an == 0)
+    {
+        fmpz_zero(x);
+    }
+    else if (an == 1)
+    {
+        fmpz_set_ui(x, p[1]);
+        if (n < 0)
+            fmpz_neg(x, x);
+    }
+    else
+    {
+        __mpz_struct * z = _fmpz_promote(x);
+        if (z->_mp_alloc < an)
+            mpz_realloc2(z, an * FLINT_BITS);
+        flint_mpn_copyi(z->_mp_d, p + 1, an);
+        z->_mp_size = n;
+    }
+
+    return p + 1 + an;
+}
+
+static const ulong *
+_arb_cache_read_arf(arf_t x, const ulong * p)
+{
+    fmpz_t man, exp;
+
+    switch (p[0])
+    {
+        case 0:
+            fmpz_init(man);
+            fmpz_init(exp);
+            p = _arb_cache_read_fmpz(exp, p + 1);
+            p = _arb_cache_read_fmpz(man, p);
+            arf_set_fmpz_2exp(x, man, exp);
+            fmpz_clear(man);
+            fmpz_clear(exp);
+            return p;
+        case 1:
+            arf_zero(x);
+            break;
+        case 2:
+            arf_pos_inf(x);
+            break;
+        case 3:
+            arf_neg_inf(x);
+            break;
+        default:
+            arf_nan(x);
+    }
+
+    return p + 1;
+}
+
+static const ulong *
+_arb_cache_read_arb(arb_t x, const ulong * p)
+{
+    arf_t t;
+
+    arf_init(t);
+    p = _arb_cache_read_arf(arb_midref(x), p);
+    p = _arb_cache_read_arf(t, p);
+    arf_get_mag(arb_radref(x), t);
+    arf_clear(t);
+
+    return p;
+}
+
+/* The following return a pointer past the object starting at p, or
+   NULL if it does not fit before end or is not in the form produced
+   by arb_cache_write. */
+static const ulong *
+_arb_cache_check_fmpz(const ulong * p, const ulong * end)
+{
+    ulong an;
+
+    if (p >= end)
+        return NULL;
+
+    an = ((slong) p[0] < 0) ? -p[0] : p[0];
+
+    if (an > (ulong) (end - p) - 1)
+        return NULL;
+
+    /* multi-limb integers must be normalised */
+    if (an >= 2 && p[an] == 0)
+        return NULL;
+
+    return p + 1 + an;
+}
+
+static const ulong *
+_arb_cache_check_arf(const ulong * p, const ulong * end)
+{
+    if (p >= end || p[0] > 4)
+        return NULL;
+
+    if (p[0] != 0)
+        return p + 1;
+
+    p = _arb_cache_check_fmpz(p + 1, end);
+    if (p != NULL)
+        p = _arb_cache_check_fmpz(p, end);
+
+    return p;
+}
+
+static const ulong *
+_arb_cache_check_arb(const ulong * p, const ulong * end)
+{
+    p = _arb_cache_check_arf(p, end);
+    if (p != NULL)
+        p = _arb_cache_check_arf(p, end);
+
+    return p;
+}
+
+static int
+_arb_cache_validate_entry(const ulong * data, const ulong * e)
+{
+    const ulong * p;
+    const ulong * q;
+    const ulong * end;
+    ulong i;
+
+    p = data + e[5];
+    end = p + e[6];
+
+    if (e[0] == ARB_CACHE_CONST)
+    {
+        return _arb_cache_check_arb(p, end) != NULL;
+    }
+    else if (e[0] == ARB_CACHE_BERNOULLI)
+    {
+        /* table of offsets, followed by numerators and denominators */
+        if (e[2] > e[6])
+            return 0;
+
+        for (i = 0; i < e[2]; i++)
+        {
+            if (p[i] >= e[6])
+                return 0;
+
+            q = _arb_cache_check_fmpz(p + p[i], end);
+
+            if (q == NULL || _arb_cache_check_fmpz(q, end) == NULL)
+                return 0;
+
+            /* positive denominator */
+            if ((slong) q[0] <= 0 || (q[0] == 1 && q[1] == 0))
+                return 0;
+        }
+
+        return 1;
+    }
+    else if (e[0] == ARB_CACHE_GL)
+    {
+        if (e[2] > e[6])
+            return 0;
+
+        for (i = 0; i < 2 * ((e[2] + 1) / 2) && p != NULL; i++)
+            p = _arb_cache_check_arb(p, end);
+
+        return p != NULL;
+    }
+
+    /* entries of unknown type are never read */
+    return 1;
+}
+
+static int
+_arb_cache_validate(const ulong * data, slong len)
+{
+    slong i, num;
+    const ulong * e;
+
+    if (len < ARB_CACHE_HEADER_WORDS ||
+        data[0] != ARB_CACHE_MAGIC ||
+        data[1] != ARB_CACHE_VERSION ||
+        data[2] != FLINT_BITS ||
+        data[3] != ARB_CACHE_BYTE_ORDER ||
+        data[4] != (ulong) len)
+        return 0;
+
+    num = data[5];
+
+    if (num < 0 || num > (len - ARB_CACHE_HEADER_WORDS) / ARB_CACHE_ENTRY_WORDS)
+        return 0;
+
+    if (data[6] != _arb_cache_checksum(data + ARB_CACHE_HEADER_WORDS,
+                                       len - ARB_CACHE_HEADER_WORDS))
+        return 0;
+
+    for (i = 0; i < num; i++)
+    {
+        e = data + ARB_CACHE_HEADER_WORDS + i * ARB_CACHE_ENTRY_WORDS;
+
+        if (e[3] > (ulong) len || e[4] > (ulong) (len - e[3]) * sizeof(ulong) ||
+            e[5] > (ulong) len || e[6] > (ulong) len - e[5])
+            return 0;
+
+        if (!_arb_cache_validate_entry(data, e))
+            return 0;
+    }
+
+    return 1;
+}
+
+void
+arb_cache_unload(void)
+{
+    _arb_cache_unmap_file(cache_alloc, cache_bytes, cache_mapped);
+
+    cache_data = NULL;
+    cache_len = 0;
+    cache_alloc = NULL;
+    cache_bytes = 0;
+    cache_mapped = 0;
+}
+
+int
+arb_cache_is_loaded(void)
+{
+    return cache_data != NULL;
+}
+
+int
+arb_cache_load(const char * filename)
+{
+    void * alloc;
+    size_t bytes;
+    int mapped;
+
+    arb_cache_unload();
+
+    if (_arb_cache_map_file(&alloc, &bytes, &mapped, filename) != 0)
+        return 1;
+
+    if (bytes % sizeof(ulong) != 0 ||
+        !_arb_cache_validate(alloc, bytes / sizeof(ulong)))
+    {
+        _arb_cache_unmap_file(alloc, bytes, mapped);
+        return 1;
+    }
+    cache_alloc = alloc;
+    cache_bytes = bytes;
+    cache_mapped = mapped;
+    cache_data = alloc;
+    cache_len = bytes / sizeof(ulong);
+
+    return 0;
+}
+
+/* Returns the first entry of the given type with count (if count >= 0)
+   and name (if not NULL) matching and precision at least prec. */
+static const ulong *
+_arb_cache_find(ulong type, slong count, const char * name, slong prec)
+{
+    slong i, num, len;
+    const ulong * e;
+
+    if (cache_data == NULL)
+        return NULL;
+
+    num = cache_data[5];
+    len = (name != NULL) ? strlen(name) : 0;
+
+    for (i = 0; i < num; i++)
+    {
+        e = cache_data + ARB_CACHE_HEADER_WORDS + i * ARB_CACHE_ENTRY_WORDS;
+
+        if (e[0] != type || (slong) e[1] < prec)
+            continue;
+
+        if (count >= 0 && (slong) e[2] != count)
+            continue;
+
+        if (name != NULL && ((slong) e[4] != len ||
+                memcmp(cache_data + e[3], name, len) != 0))
+            continue;
+
+        return e;
+    }
+
+    return NULL;
+}
+
+slong
+_arb_cache_const_lookup(arb_t res, const char * name, slong prec)
+{
+    const ulong * e;
+
+    e = _arb_cache_find(ARB_CACHE_CONST, -1, name, prec);
+
+    if (e == NULL)
+        return 0;
+
+    _arb_cache_read_arb(res, cache_data + e[5]);
+    return e[1];
+}
+
+slong
+_arb_cache_bernoulli_load(fmpq * res, slong start, slong stop)
+{
+    const ulong * e;
+    const ulong * p;
+    slong i;
+
+    e = _arb_cache_find(ARB_CACHE_BERNOULLI, -1, NULL, 0);
+
+    if (e == NULL)
+        return start;
+
+    stop = FLINT_MIN(stop, (slong) e[2]);
+
+    /* the data starts with a table of offsets of the entries */
+    for (i = start; i < stop; i++)
+    {
+        p = cache_data + e[5] + cache_data[e[5] + i];
+        p = _arb_cache_read_fmpz(fmpq_numref(res + i), p);
+        _arb_cache_read_fmpz(fmpq_denref(res + i), p);
+    }
+
+    return FLINT_MAX(start, stop);
+}
+
+slong
+_arb_cache_gl_load(arb_ptr nodes, arb_ptr weights, slong n, slong prec)
+{
+    const ulong * e;
+    const ulong * p;
+    slong i, m;
+
+    e = _arb_cache_find(ARB_CACHE_GL, n, NULL, prec);
+
+    if (e == NULL)
+        return 0;
+
+    m = (n + 1) / 2;
+    p = cache_data + e[5];
+
+    for (i = 0; i < m; i++)
+        p = _arb_cache_read_arb(nodes + i, p);
+    for (i = 0; i < m; i++)
+        p = _arb_cache_read_arb(weights + i, p);
+
+    return e[1];
+}
@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include "arb_cache.h"
+
+#if defined(_WIN32)
+#define ARB_CACHE_USE_MMAP 0
+#else
+#define ARB_CACHE_USE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+int
+_arb_cache_map_file(void ** alloc, size_t * bytes, int * mapped, const char * filename)
+{
+    *alloc = NULL;
+    *bytes = 0;
+    *mapped = 0;
+
+#if ARB_CACHE_USE_MMAP
+    {
+        struct stat st;
+        int fd;
+
+        fd = open(filename, O_RDONLY);
+        if (fd < 0)
+            return 1;
+
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            *bytes = st.st_size;
+            *alloc = mmap(NULL, *bytes, PROT_READ, MAP_SHARED, fd, 0);
+            if (*alloc == MAP_FAILED)
+                *alloc = NULL;
+            else
+                *mapped = 1;
+        }
+
+        close(fd);
+    }
+#endif
+
+    if (*alloc == NULL)
+    {
+        FILE * fp;
+        long size;
+
+        fp = fopen(filename, "rb");
+        if (fp == NULL)
+            return 1;
+
+        if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) <= 0 ||
+            fseek(fp, 0, SEEK_SET) != 0)
+        {
+            fclose(fp);
+            return 1;
+        }
+
+        *bytes = size;
+        *alloc = flint_malloc(*bytes);
+
+        if (fread(*alloc, 1, *bytes, fp) != *bytes)
+        {
+            flint_free(*alloc);
+            *alloc = NULL;
+            *bytes = 0;
+            fclose(fp);
+            return 1;
+        }
+
+        fclose(fp);
+    }
+
+    return 0;
+}
+
+void
+_arb_cache_unmap_file(void * alloc, size_t bytes, int mapped)
+{
+    if (alloc == NULL)
+        return;
+
+#if ARB_CACHE_USE_MMAP
+    if (mapped)
+        munmap(alloc, bytes);
+    else
+#endif
+        flint_free(alloc);
+}
@@ -0,0 +1,222 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include "arb_cache.h"
+#include "arb_hypgeom.h"
+#include "bernoulli.h"
+#include "acb_calc.h"
+
+#define FILENAME "arb_cache_test.bin"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("cache....");
+    fflush(stdout);
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10 * arb_test_multiplier(); iter++)
+    {
+        slong prec, file_prec, bnum, glmax, i, n;
+        arb_t x, y, w, z;
+        fmpq_t b;
+        FILE * fp;
+
+        arb_init(x);
+        arb_init(y);
+        arb_init(w);
+        arb_init(z);
+        fmpq_init(b);
+
+        file_prec = 2 + n_randint(state, 2000);
+        bnum = n_randint(state, 300);
+        glmax = n_randint(state, 100);
+
+        if (arb_cache_write(FILENAME, file_prec, bnum, glmax) != 0)
+        {
+            flint_printf("FAIL: write\n\n");
+            flint_abort();
+        }
+
+        /* start from empty caches */
+        flint_cleanup();
+
+        if (arb_cache_load(FILENAME) != 0 || !arb_cache_is_loaded())
+        {
+            flint_printf("FAIL: load\n\n");
+            flint_abort();
+        }
+
+        prec = 2 + n_randint(state, 2 * file_prec);
+
+        arb_const_euler(x, prec);
+        arb_const_catalan(y, prec);
+        arb_const_log_sqrt2pi(z, prec);
+
+        arb_cache_unload();
+        flint_cleanup();
+
+        arb_const_euler(w, prec);
+        if (!arb_overlaps(x, w) || arb_rel_accuracy_bits(x) < prec - 4)
+        {
+            flint_printf("FAIL: euler\n\n");
+            flint_printf("prec = %wd, file_prec = %wd\n", prec, file_prec);
+            flint_abort();
+        }
+
+        arb_const_catalan(w, prec);
+        if (!arb_overlaps(y, w) || arb_rel_accuracy_bits(y) < prec - 4)
+        {
+            flint_printf("FAIL: catalan\n\n");
+            flint_printf("prec = %wd, file_prec = %wd\n", prec, file_prec);
+            flint_abort();
+        }
+
+        arb_const_log_sqrt2pi(w, prec);
+        if (!arb_overlaps(z, w) || arb_rel_accuracy_bits(z) < prec - 4)
+        {
+            flint_printf("FAIL: log_sqrt2pi\n\n");
+            flint_printf("prec = %wd, file_prec = %wd\n", prec, file_prec);
+            flint_abort();
+        }
+
+        /* Bernoulli numbers and Gauss-Legendre nodes */
+        flint_cleanup();
+        arb_cache_load(FILENAME);
+
+        n = n_randint(state, 400);
+        BERNOULLI_ENSURE_CACHED(n);
+        arith_bernoulli_number(b, n);
+
+        if (!fmpq_equal(b, bernoulli_cache + n))
+        {
+            flint_printf("FAIL: bernoulli\n\n");
+            flint_printf("n = %wd, bnum = %wd\n", n, bnum);
+            flint_abort();
+        }
+
+        for (i = 0; i < 8; i++)
+        {
+            n = _acb_calc_gl_steps[i];
+            acb_calc_gl_node(x, y, i, n / 2, prec);
+            arb_hypgeom_legendre_p_ui_root(z, w, n, n / 2, prec);
+
+            if (!arb_overlaps(x, z) || !arb_overlaps(y, w))
+            {
+                flint_printf("FAIL: gl\n\n");
+                flint_printf("n = %wd, glmax = %wd\n", n, glmax);
+                flint_abort();
+            }
+        }
+
+        arb_cache_unload();
+
+        /* a corrupted file is rejected */
+        fp = fopen(FILENAME, "r+b");
+        if (fp != NULL)
+        {
+            int c;
+
+            fseek(fp, -1, SEEK_END);
+            c = fgetc(fp);
+            fseek(fp, -1, SEEK_END);
+            fputc(c ^ 1, fp);
+            fclose(fp);
+
+            if (arb_cache_load(FILENAME) == 0)
+            {
+                flint_printf("FAIL: checksum\n\n");
+                flint_abort();
+            }
+        }
+
+        arb_cache_unload();
+
+        /* a truncated or malformed entry is rejected, even with a
+           valid checksum */
+        arb_cache_write(FILENAME, file_prec, bnum, glmax);
+        fp = fopen(FILENAME, "rb");
+        if (fp != NULL)
+        {
+            ulong * data;
+            ulong * e;
+            slong len, num;
+
+            fseek(fp, 0, SEEK_END);
+            len = ftell(fp) / sizeof(ulong);
+            fseek(fp, 0, SEEK_SET);
+            data = flint_malloc(len * sizeof(ulong));
+            if (fread(data, sizeof(ulong), len, fp) != (size_t) len)
+            {
+                flint_printf("FAIL: read\n\n");
+                flint_abort();
+            }
+            fclose(fp);
+
+            num = data[5];
+            e = data + ARB_CACHE_HEADER_WORDS +
+                n_randint(state, num) * ARB_CACHE_ENTRY_WORDS;
+
+            if (n_randint(state, 2))
+            {
+                /* truncate the payload */
+                e[6] -= 1 + n_randint(state, e[6]);
+            }
+            else if (e[0] != ARB_CACHE_BERNOULLI && data[e[5]] == 0)
+            {
+                /* limb count of the exponent of the midpoint */
+                data[e[5] + 1] = UWORD_MAX / 2;
+            }
+            else
+            {
+                /* kind of the midpoint, or the first Bernoulli offset */
+                data[e[5]] = UWORD_MAX / 2;
+            }
+
+            data[6] = _arb_cache_checksum(data + ARB_CACHE_HEADER_WORDS,
+                len - ARB_CACHE_HEADER_WORDS);
+
+            fp = fopen(FILENAME, "wb");
+            if (fp != NULL)
+            {
+                fwrite(data, sizeof(ulong), len, fp);
+                fclose(fp);
+
+                if (arb_cache_load(FILENAME) == 0)
+                {
+                    flint_printf("FAIL: malformed entry\n\n");
+                    flint_printf("type = %wu, count = %wu\n", e[0], e[2]);
+                    flint_abort();
+                }
+            }
+
+            flint_free(data);
+        }
+
+        arb_cache_unload();
+        remove(FILENAME);
+        flint_cleanup();
+
+        arb_clear(x);
+        arb_clear(y);
+        arb_clear(w);
+        arb_clear(z);
+        fmpq_clear(b);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,278 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "arb_cache.h"
+#include "bernoulli.h"
+#include "acb_calc.h"
+
+/* cached constants not declared in the headers */
+void arb_const_pi_chudnovsky(arb_t x, slong prec);
+void arb_const_euler_brent_mcmillan(arb_t x, slong prec);
+void arb_const_log2_hypgeom(arb_t x, slong prec);
+
+typedef void (*cache_const_func_t)(arb_t, slong);
+
+/* The names must match those given to ARB_DEF_CACHED_CONSTANT. */
+#define NUM_CACHE_CONSTANTS 11
+
+static const char * cache_const_names[NUM_CACHE_CONSTANTS] = {
+    "arb_const_pi_chudnovsky", "arb_const_log2_hypgeom",
+    "arb_const_euler_brent_mcmillan", "arb_const_e", "arb_const_log10",
+    "arb_const_sqrt_pi", "arb_const_log_sqrt2pi", "arb_const_catalan",
+    "arb_const_apery", "arb_const_glaisher", "arb_const_khinchin" };
+
+static const cache_const_func_t cache_const_funcs[NUM_CACHE_CONSTANTS] = {
+    arb_const_pi_chudnovsky, arb_const_log2_hypgeom,
+    arb_const_euler_brent_mcmillan, arb_const_e, arb_const_log10,
+    arb_const_sqrt_pi, arb_const_log_sqrt2pi, arb_const_catalan,
+    arb_const_apery, arb_const_glaisher, arb_const_khinchin };
+
+typedef struct
+{
+    ulong * data;
+    slong len;
+    slong alloc;
+}
+cache_buf_struct;
+
+static void
+_buf_push(cache_buf_struct * buf, ulong x)
+{
+    if (buf->len == buf->alloc)
+    {
+        buf->alloc = FLINT_MAX(2 * buf->alloc, 256);
+        buf->data = flint_realloc(buf->data, buf->alloc * sizeof(ulong));
+    }
+
+    buf->data[buf->len++] = x;
+}
+
+static void
+_buf_push_str(cache_buf_struct * buf, const char * s)
+{
+    slong i, n, words;
+    ulong w;
+
+    n = strlen(s);
+    words = (n + sizeof(ulong) - 1) / sizeof(ulong);
+
+    for (i = 0; i < words; i++)
+    {
+        w = 0;
+        memcpy(&w, s + i * sizeof(ulong),
+            FLINT_MIN(sizeof(ulong), (size_t) (n - i * sizeof(ulong))));
+        _buf_push(buf, w);
+    }
+}
+
+static void
+_buf_push_fmpz(cache_buf_struct * buf, const fmpz_t x)
+{
+    slong i, n;
+
+    if (!COEFF_IS_MPZ(*x))
+    {
+        if (*x == 0)
+        {
+            _buf_push(buf, 0);
+        }
+        else
+        {
+            _buf_push(buf, (*x > 0) ? 1 : -(ulong) 1);
+            _buf_push(buf, FLINT_ABS(*x));
+        }
+    }
+    else
+    {
+        __mpz_struct * z = COEFF_TO_PTR(*x);
+        n = z->_mp_size;
+        _buf_push(buf, (ulong) n);
+        for (i = 0; i < FLINT_ABS(n); i++)
+            _buf_push(buf, z->_mp_d[i]);
+    }
+}
+
+static void
+_buf_push_arf(cache_buf_struct * buf, const arf_t x)
+{
+    if (arf_is_zero(x))
+        _buf_push(buf, 1);
+    else if (arf_is_pos_inf(x))
+        _buf_push(buf, 2);
+    else if (arf_is_neg_inf(x))
+        _buf_push(buf, 3);
+    else if (arf_is_nan(x))
+        _buf_push(buf, 4);
+    else
+    {
+        fmpz_t man, exp;
+        fmpz_init(man);
+        fmpz_init(exp);
+        arf_get_fmpz_2exp(man, exp, x);
+        _buf_push(buf, 0);
+        _buf_push_fmpz(buf, exp);
+        _buf_push_fmpz(buf, man);
+        fmpz_clear(man);
+        fmpz_clear(exp);
+    }
+}
+
+static void
+_buf_push_arb(cache_buf_struct * buf, const arb_t x)
+{
+    arf_t t;
+    arf_init_set_mag_shallow(t, arb_radref(x));
+    _buf_push_arf(buf, arb_midref(x));
+    _buf_push_arf(buf, t);
+}
+
+/* Appends an entry whose data is data->data[start:] (offsets relative to
+   the start of the data section; fixed up when the file is assembled). */
+static void
+_add_entry(cache_buf_struct * entries, cache_buf_struct * data,
+    ulong type, slong prec, slong count, const char * name, slong start)
+{
+    slong name_start;
+
+    name_start = data->len;
+    if (name != NULL)
+        _buf_push_str(data, name);
+
+    _buf_push(entries, type);
+    _buf_push(entries, prec);
+    _buf_push(entries, count);
+    _buf_push(entries, name_start);
+    _buf_push(entries, (name != NULL) ? strlen(name) : 0);
+    _buf_push(entries, start);
+    _buf_push(entries, name_start - start);
+}
+
+int
+arb_cache_write(const char * filename, slong prec, slong bernoulli_num, slong gl_max_points)
+{
+    cache_buf_struct entries, data;
+    slong i, j, k, n, m, start, base, num;
+    ulong header[ARB_CACHE_HEADER_WORDS];
+    FILE * fp;
+    int result;
+
+    entries.data = data.data = NULL;
+    entries.len = data.len = 0;
+    entries.alloc = data.alloc = 0;
+
+    /* constants */
+    if (prec > 0)
+    {
+        arb_t x;
+        arb_init(x);
+
+        for (i = 0; i < NUM_CACHE_CONSTANTS; i++)
+        {
+            /* same as the internal computation at this precision */
+            cache_const_funcs[i](x, prec + 32);
+            start = data.len;
+            _buf_push_arb(&data, x);
+            _add_entry(&entries, &data, ARB_CACHE_CONST, prec, 1,
+                cache_const_names[i], start);
+        }
+
+        arb_clear(x);
+    }
+
+    /* Bernoulli numbers, with a table of offsets for random access */
+    if (bernoulli_num > 0)
+    {
+        bernoulli_cache_compute(bernoulli_num);
+
+        start = data.len;
+        for (i = 0; i < bernoulli_num; i++)
+            _buf_push(&data, 0);
+
+        for (i = 0; i < bernoulli_num; i++)
+        {
+            data.data[start + i] = data.len - start;
+            _buf_push_fmpz(&data, fmpq_numref(bernoulli_cache + i));
+            _buf_push_fmpz(&data, fmpq_denref(bernoulli_cache + i));
+        }
+
+        _add_entry(&entries, &data, ARB_CACHE_BERNOULLI, 0, bernoulli_num,
+            NULL, start);
+    }
+
+    /* Gauss-Legendre nodes and weights */
+    if (prec > 0)
+    {
+        arb_ptr x, w;
+
+        for (i = 0; i < ACB_CALC_GL_STEPS && _acb_calc_gl_steps[i] <= gl_max_points; i++)
+        {
+            n = _acb_calc_gl_steps[i];
+            m = (n + 1) / 2;
+
+            x = _arb_vec_init(m);
+            w = _arb_vec_init(m);
+
+            acb_calc_gl_node(x, w, i, -1, prec);
+
+            start = data.len;
+            for (j = 0; j < m; j++)
+                _buf_push_arb(&data, x + j);
+            for (j = 0; j < m; j++)
+                _buf_push_arb(&data, w + j);
+
+            _add_entry(&entries, &data, ARB_CACHE_GL, prec, n, NULL, start);
+
+            _arb_vec_clear(x, m);
+            _arb_vec_clear(w, m);
+        }
+    }
+
+    /* make the offsets absolute */
+    num = entries.len / ARB_CACHE_ENTRY_WORDS;
+    base = ARB_CACHE_HEADER_WORDS + entries.len;
+
+    for (k = 0; k < num; k++)
+    {
+        entries.data[k * ARB_CACHE_ENTRY_WORDS + 3] += base;
+        entries.data[k * ARB_CACHE_ENTRY_WORDS + 5] += base;
+    }
+
+    header[0] = ARB_CACHE_MAGIC;
+    header[1] = ARB_CACHE_VERSION;
+    header[2] = FLINT_BITS;
+    header[3] = ARB_CACHE_BYTE_ORDER;
+    header[4] = base + data.len;
+    header[5] = num;
+    /* checksum of the entries followed by the data */
+    for (k = 0; k < data.len; k++)
+        _buf_push(&entries, data.data[k]);
+    header[6] = _arb_cache_checksum(entries.data, entries.len);
+
+    result = 1;
+    fp = fopen(filename, "wb");
+
+    if (fp != NULL)
+    {
+        if (fwrite(header, sizeof(ulong), ARB_CACHE_HEADER_WORDS, fp) == ARB_CACHE_HEADER_WORDS &&
+            fwrite(entries.data, sizeof(ulong), entries.len, fp) == (size_t) entries.len)
+            result = 0;
+
+        if (fclose(fp) != 0)
+            result = 1;
+    }
+
+    flint_free(entries.data);
+    flint_free(data.data);
+
+    return result;
+}
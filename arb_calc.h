@@ -124,6 +124,11 @@ slong arb_calc_isolate_roots(arf_interval_ptr * blocks, int ** flags,
     const arf_interval_t block, slong maxdepth, slong maxeval, slong maxfound,
     slong prec);
 
+slong arb_calc_isolate_roots_threaded(arf_interval_ptr * blocks, int ** flags,
+    arb_calc_func_t func, void * param,
+    const arf_interval_t block, slong maxdepth, slong maxeval, slong maxfound,
+    slong prec);
+
 int arb_calc_refine_root_bisect(arf_interval_t r, arb_calc_func_t func,
     void * param, const arf_interval_t start, slong iter, slong prec);
 
@@ -139,6 +144,10 @@ int arb_calc_refine_root_newton(arb_t r, arb_calc_func_t func,
     void * param, const arb_t start, const arb_t conv_region,
     const arf_t conv_factor, slong eval_extra_prec, slong prec);
 
+int arb_calc_refine_roots_newton_threaded(arb_ptr r, arb_calc_func_t func,
+    void * param, arf_interval_srcptr blocks, slong num, slong bisect_iter,
+    slong eval_extra_prec, slong low_prec, slong prec);
+
 
 
 #ifdef __cplusplus
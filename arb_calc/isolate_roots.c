@@ -182,3 +182,237 @@ arb_calc_isolate_roots(arf_interval_ptr * blocks, int ** flags,
     return length;
 }
 
+
+/*
+  Threaded version: the subdivision tree is processed one level at a
+  time. The current list of blocks is kept in increasing order; at each
+  level, all pending blocks are tested (and partitioned if necessary)
+  in parallel, and the list is then rebuilt in order. When the limits
+  are not reached, this produces exactly the same output as the
+  depth-first recursive algorithm.
+*/
+
+#define BLOCK_PENDING 3
+#define BLOCK_SPLIT 4
+
+typedef struct
+{
+    arf_interval_struct block;
+    int asign;
+    int bsign;
+    int status;
+}
+isolate_item_struct;
+
+typedef struct
+{
+    isolate_item_struct * items;
+    const slong * pending;
+    arf_interval_ptr L;
+    arf_interval_ptr R;
+    int * msign;
+    arb_calc_func_t func;
+    void * param;
+    slong depth;
+    slong prec;
+}
+isolate_work_t;
+
+static void
+isolate_worker(slong j, isolate_work_t * work)
+{
+    isolate_item_struct * item = work->items + work->pending[j];
+    int status;
+
+    status = check_block(work->func, work->param, &item->block,
+        item->asign, item->bsign, work->prec);
+
+    if (status == BLOCK_UNKNOWN && work->depth > 0)
+    {
+        work->msign[j] = arb_calc_partition(work->L + j, work->R + j,
+            work->func, work->param, &item->block, work->prec);
+        status = BLOCK_SPLIT;
+    }
+
+    item->status = status;
+}
+
+static void
+item_push(isolate_item_struct * items, slong * len,
+    arf_interval_t block, int asign, int bsign, int status)
+{
+    isolate_item_struct * item = items + *len;
+
+    arf_interval_init(&item->block);
+    arf_interval_swap(&item->block, block);
+    item->asign = asign;
+    item->bsign = bsign;
+    item->status = status;
+    (*len)++;
+}
+
+slong
+arb_calc_isolate_roots_threaded(arf_interval_ptr * blocks, int ** flags,
+    arb_calc_func_t func, void * param,
+    const arf_interval_t block, slong maxdepth, slong maxeval, slong maxfound,
+    slong prec)
+{
+    isolate_item_struct * items, * new_items, * item;
+    isolate_work_t work;
+    arf_interval_ptr L, R;
+    slong * pending;
+    int * msign;
+    slong len, new_len, num_pending, num_eval, depth, i, j;
+    int asign, bsign, status;
+    arb_t m, v;
+
+    arb_init(m);
+    arb_init(v);
+
+    arb_set_arf(m, &block->a);
+    func(v, m, param, 1, prec);
+    asign = arb_sgn_nonzero(v);
+
+    arb_set_arf(m, &block->b);
+    func(v, m, param, 1, prec);
+    bsign = arb_sgn_nonzero(v);
+
+    arb_clear(m);
+    arb_clear(v);
+
+    items = flint_malloc(sizeof(isolate_item_struct));
+    len = 0;
+
+    {
+        arf_interval_t t;
+        arf_interval_init(t);
+        arf_interval_set(t, block);
+        item_push(items, &len, t, asign, bsign, BLOCK_PENDING);
+        arf_interval_clear(t);
+    }
+
+    for (depth = maxdepth; ; depth--)
+    {
+        num_pending = 0;
+        for (i = 0; i < len; i++)
+            num_pending += (items[i].status == BLOCK_PENDING);
+
+        if (num_pending == 0)
+            break;
+
+        if (maxeval <= 0 || maxfound <= 0)
+        {
+            for (i = 0; i < len; i++)
+                if (items[i].status == BLOCK_PENDING)
+                    items[i].status = BLOCK_UNKNOWN;
+            break;
+        }
+
+        /* the leftmost blocks are tested first, as in the recursive version */
+        num_eval = FLINT_MIN(num_pending, maxeval);
+        maxeval -= num_eval;
+
+        pending = flint_malloc(sizeof(slong) * num_eval);
+        msign = flint_malloc(sizeof(int) * num_eval);
+        L = _arf_interval_vec_init(num_eval);
+        R = _arf_interval_vec_init(num_eval);
+
+        for (i = j = 0; j < num_eval; i++)
+            if (items[i].status == BLOCK_PENDING)
+                pending[j++] = i;
+
+        work.items = items;
+        work.pending = pending;
+        work.L = L;
+        work.R = R;
+        work.msign = msign;
+        work.func = func;
+        work.param = param;
+        work.depth = depth;
+        work.prec = prec;
+
+        flint_parallel_do((do_func_t) isolate_worker, &work, num_eval, -1, FLINT_PARALLEL_DYNAMIC);
+
+        new_items = flint_malloc(sizeof(isolate_item_struct) * (len + num_eval));
+        new_len = 0;
+
+        for (i = j = 0; i < len; i++)
+        {
+            item = items + i;
+            status = item->status;
+
+            if (j < num_eval && pending[j] == i)
+            {
+                if (maxfound <= 0)
+                {
+                    /* the recursive version would not have tested this block */
+                    status = BLOCK_UNKNOWN;
+                }
+                else if (status == BLOCK_ISOLATED_ZERO)
+                {
+                    if (arb_calc_verbose)
+                    {
+                        flint_printf("found isolated root in: ");
+                        arf_interval_printd(&item->block, 15);
+                        flint_printf("\n");
+                    }
+
+                    maxfound--;
+                }
+                else if (status == BLOCK_SPLIT)
+                {
+                    if (msign[j] == 0 && arb_calc_verbose)
+                    {
+                        flint_printf("possible zero at midpoint: ");
+                        arf_interval_printd(&item->block, 15);
+                        flint_printf("\n");
+                    }
+
+                    item_push(new_items, &new_len, L + j, item->asign, msign[j], BLOCK_PENDING);
+                    item_push(new_items, &new_len, R + j, msign[j], item->bsign, BLOCK_PENDING);
+                }
+
+                j++;
+            }
+            else if (status == BLOCK_PENDING)
+            {
+                /* out of evaluations */
+                status = BLOCK_UNKNOWN;
+            }
+
+            if (status == BLOCK_ISOLATED_ZERO || status == BLOCK_UNKNOWN)
+                item_push(new_items, &new_len, &item->block, item->asign, item->bsign, status);
+
+            arf_interval_clear(&item->block);
+        }
+
+        flint_free(items);
+        items = new_items;
+        len = new_len;
+
+        flint_free(pending);
+        flint_free(msign);
+        _arf_interval_vec_clear(L, num_eval);
+        _arf_interval_vec_clear(R, num_eval);
+    }
+
+    *blocks = NULL;
+    *flags = NULL;
+
+    if (len != 0)
+    {
+        *blocks = _arf_interval_vec_init(len);
+        *flags = flint_malloc(sizeof(int) * len);
+    }
+
+    for (i = 0; i < len; i++)
+    {
+        arf_interval_swap((*blocks) + i, &items[i].block);
+        (*flags)[i] = items[i].status;
+        arf_interval_clear(&items[i].block);
+    }
+
+    flint_free(items);
+
+    return len;
+}
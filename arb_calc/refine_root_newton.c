@@ -61,3 +61,105 @@ int arb_calc_refine_root_newton(arb_t r, arb_calc_func_t func,
     return ARB_CALC_SUCCESS;
 }
 
+
+typedef struct
+{
+    arb_ptr r;
+    int * result;
+    arb_calc_func_t func;
+    void * param;
+    arf_interval_srcptr blocks;
+    slong bisect_iter;
+    slong eval_extra_prec;
+    slong low_prec;
+    slong prec;
+}
+refine_work_t;
+
+static void
+refine_worker(slong i, refine_work_t * work)
+{
+    arf_interval_t t, u;
+    arb_t v, w;
+    arf_t C;
+    int result, res;
+
+    arf_interval_init(t);
+    arf_interval_init(u);
+    arb_init(v);
+    arb_init(w);
+    arf_init(C);
+
+    /* t is used as the convergence region and u as the starting point;
+       bisection does not write its output if the signs at the endpoints
+       cannot be determined at low_prec */
+    result = arb_calc_refine_root_bisect(t, work->func, work->param,
+        work->blocks + i, work->bisect_iter, work->low_prec);
+
+    if (result != ARB_CALC_SUCCESS)
+    {
+        arf_interval_get_arb(work->r + i, work->blocks + i, work->prec);
+        work->result[i] = result;
+        goto cleanup;
+    }
+
+    result = arb_calc_refine_root_bisect(u, work->func, work->param,
+        t, work->bisect_iter, work->low_prec);
+
+    arf_interval_get_arb(v, t, work->prec);
+    arb_calc_newton_conv_factor(C, work->func, work->param, v, work->low_prec);
+
+    if (result == ARB_CALC_SUCCESS)
+        arf_interval_get_arb(w, u, work->prec);
+    else
+        arb_set(w, v);
+
+    res = arb_calc_refine_root_newton(work->r + i, work->func, work->param,
+        w, v, C, work->eval_extra_prec, work->prec);
+
+    /* the output is not set if the starting ball is too imprecise */
+    if (res == ARB_CALC_IMPRECISE_INPUT)
+        arb_set(work->r + i, w);
+
+    if (result == ARB_CALC_SUCCESS)
+        result = res;
+
+    work->result[i] = result;
+
+cleanup:
+    arf_interval_clear(t);
+    arf_interval_clear(u);
+    arb_clear(v);
+    arb_clear(w);
+    arf_clear(C);
+}
+
+int arb_calc_refine_roots_newton_threaded(arb_ptr r, arb_calc_func_t func,
+    void * param, arf_interval_srcptr blocks, slong num, slong bisect_iter,
+    slong eval_extra_prec, slong low_prec, slong prec)
+{
+    refine_work_t work;
+    slong i;
+    int result;
+
+    work.r = r;
+    work.result = flint_malloc(sizeof(int) * FLINT_MAX(num, 1));
+    work.func = func;
+    work.param = param;
+    work.blocks = blocks;
+    work.bisect_iter = bisect_iter;
+    work.eval_extra_prec = eval_extra_prec;
+    work.low_prec = low_prec;
+    work.prec = prec;
+
+    flint_parallel_do((do_func_t) refine_worker, &work, num, -1, FLINT_PARALLEL_DYNAMIC);
+
+    /* report the first failure, independently of the scheduling */
+    result = ARB_CALC_SUCCESS;
+    for (i = 0; i < num && result == ARB_CALC_SUCCESS; i++)
+        result = work.result[i];
+
+    flint_free(work.result);
+
+    return result;
+}
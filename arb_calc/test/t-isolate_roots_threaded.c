@@ -0,0 +1,251 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_calc.h"
+
+/* sin((pi/2)x) */
+static int
+sin_pi2_x(arb_ptr out, const arb_t inp, void * params, slong order, slong prec)
+{
+    arb_ptr x;
+
+    x = _arb_vec_init(2);
+
+    arb_set(x, inp);
+    arb_one(x + 1);
+
+    arb_const_pi(out, prec);
+    arb_mul_2exp_si(out, out, -1);
+    _arb_vec_scalar_mul(x, x, 2, out, prec);
+    _arb_poly_sin_series(out, x, order, order, prec);
+
+    _arb_vec_clear(x, 2);
+
+    return 0;
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("isolate_roots_threaded....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 40 * arb_test_multiplier(); iter++)
+    {
+        slong m, r, a, b, maxdepth, maxeval, maxfound, prec, i, j, num, num2, num_roots;
+        arf_interval_ptr blocks, blocks2, roots;
+        int * info, * info2;
+        arf_interval_t interval;
+        arb_ptr refined;
+        arb_t t;
+        fmpz_t nn;
+        int limited;
+
+        m = n_randint(state, 80);
+        r = 1 + n_randint(state, 80);
+        a = m - r;
+        b = m + r;
+
+        limited = n_randint(state, 2);
+
+        maxdepth = 1 + n_randint(state, 60);
+        if (limited)
+        {
+            prec = 2 + n_randint(state, 50);
+            maxeval = 1 + n_randint(state, 5000);
+            maxfound = 1 + n_randint(state, 100);
+        }
+        else
+        {
+            /* large enough that the limits are never reached */
+            prec = 30 + n_randint(state, 50);
+            maxeval = 100000;
+            maxfound = WORD_MAX;
+        }
+
+        arf_interval_init(interval);
+        arb_init(t);
+        fmpz_init(nn);
+
+        arf_set_si(&interval->a, a);
+        arf_set_si(&interval->b, b);
+
+        flint_set_num_threads(1 + n_randint(state, 6));
+
+        num = arb_calc_isolate_roots_threaded(&blocks, &info, sin_pi2_x, NULL,
+            interval, maxdepth, maxeval, maxfound, prec);
+
+        /* check that all roots are accounted for */
+        for (i = a; i <= b; i++)
+        {
+            if (i % 2 == 0)
+            {
+                int found = 0;
+
+                for (j = 0; j < num; j++)
+                {
+                    arf_interval_get_arb(t, blocks + j, ARF_PREC_EXACT);
+
+                    if (arb_contains_si(t, i))
+                    {
+                        found = 1;
+                        break;
+                    }
+                }
+
+                if (!found)
+                {
+                    flint_printf("FAIL: missing root %wd\n", i);
+                    flint_printf("a = %wd, b = %wd, maxdepth = %wd, maxeval = %wd, maxfound = %wd, prec = %wd\n",
+                        a, b, maxdepth, maxeval, maxfound, prec);
+                    flint_abort();
+                }
+            }
+        }
+
+        /* check that the output is sorted */
+        for (i = 0; i + 1 < num; i++)
+        {
+            if (arf_cmp(&blocks[i].b, &blocks[i + 1].a) > 0)
+            {
+                flint_printf("FAIL: ordering\n");
+                flint_printf("a = %wd, b = %wd, maxdepth = %wd, maxeval = %wd, maxfound = %wd, prec = %wd\n",
+                    a, b, maxdepth, maxeval, maxfound, prec);
+                flint_abort();
+            }
+        }
+
+        /* check that all reported single roots are good */
+        num_roots = 0;
+        for (i = 0; i < num; i++)
+        {
+            if (info[i] == 1)
+            {
+                /* b contains unique 2n -> b/2 contains unique n */
+                arf_interval_get_arb(t, blocks + i, ARF_PREC_EXACT);
+                arb_mul_2exp_si(t, t, -1);
+
+                if (!arb_get_unique_fmpz(nn, t))
+                {
+                    flint_printf("FAIL: bad root %wd\n", i);
+                    flint_printf("a = %wd, b = %wd, maxdepth = %wd, maxeval = %wd, maxfound = %wd, prec = %wd\n",
+                        a, b, maxdepth, maxeval, maxfound, prec);
+                    flint_abort();
+                }
+
+                num_roots++;
+            }
+        }
+
+        /* without limits, the output is the same as the serial version */
+        if (!limited)
+        {
+            num2 = arb_calc_isolate_roots(&blocks2, &info2, sin_pi2_x, NULL,
+                interval, maxdepth, maxeval, maxfound, prec);
+
+            if (num != num2)
+            {
+                flint_printf("FAIL: num = %wd, num2 = %wd\n", num, num2);
+                flint_abort();
+            }
+
+            for (i = 0; i < num; i++)
+            {
+                if (info[i] != info2[i] ||
+                    !arf_equal(&blocks[i].a, &blocks2[i].a) ||
+                    !arf_equal(&blocks[i].b, &blocks2[i].b))
+                {
+                    flint_printf("FAIL: block %wd differs\n", i);
+                    arf_interval_printd(blocks + i, 15); flint_printf("  %d\n", info[i]);
+                    arf_interval_printd(blocks2 + i, 15); flint_printf("  %d\n", info2[i]);
+                    flint_abort();
+                }
+            }
+
+            _arf_interval_vec_clear(blocks2, num2);
+            flint_free(info2);
+        }
+
+        /* refine the isolated roots; with a very low low_prec, the
+           signs at the endpoints may be undecided and refinement can
+           fail, but the output must still enclose the roots */
+        if (num_roots != 0 && n_randint(state, 2))
+        {
+            slong high_prec = 64 + n_randint(state, 500);
+            slong low_prec;
+            int low, res;
+
+            low = n_randint(state, 2);
+            low_prec = low ? 2 + n_randint(state, 7) : prec + 10;
+
+            roots = _arf_interval_vec_init(num_roots);
+            refined = _arb_vec_init(num_roots);
+
+            for (i = j = 0; i < num; i++)
+                if (info[i] == 1)
+                    arf_interval_set(roots + j++, blocks + i);
+
+            res = arb_calc_refine_roots_newton_threaded(refined, sin_pi2_x, NULL,
+                roots, num_roots, 5, 10, low_prec, high_prec);
+
+            if (!low && res != ARB_CALC_SUCCESS)
+            {
+                flint_printf("FAIL: refine result %d\n", res);
+                flint_printf("prec = %wd, high_prec = %wd\n", prec, high_prec);
+                flint_abort();
+            }
+
+            for (i = 0; i < num_roots; i++)
+            {
+                arf_interval_get_arb(t, roots + i, ARF_PREC_EXACT);
+
+                if (!arb_overlaps(t, refined + i))
+                {
+                    flint_printf("FAIL: refined root outside block %wd\n", i);
+                    flint_printf("low_prec = %wd, result = %d\n", low_prec, res);
+                    arb_printn(refined + i, 30, 0); flint_printf("\n");
+                    flint_abort();
+                }
+
+                if (res == ARB_CALC_SUCCESS)
+                {
+                    arb_mul_2exp_si(t, refined + i, -1);
+
+                    if (!arb_get_unique_fmpz(nn, t))
+                    {
+                        flint_printf("FAIL: refined root %wd\n", i);
+                        arb_printn(refined + i, 30, 0); flint_printf("\n");
+                        flint_abort();
+                    }
+                }
+            }
+
+            _arf_interval_vec_clear(roots, num_roots);
+            _arb_vec_clear(refined, num_roots);
+        }
+
+        _arf_interval_vec_clear(blocks, num);
+        flint_free(info);
+
+        arf_interval_clear(interval);
+        arb_clear(t);
+        fmpz_clear(nn);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,315 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ARB_FIXED_H
+#define ARB_FIXED_H
+
+#ifdef ARB_FIXED_INLINES_C
+#define ARB_FIXED_INLINE
+#else
+#define ARB_FIXED_INLINE static __inline__
+#endif
+
+#include "arb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Balls with a midpoint of exactly N limbs and word-size exponents.
+  The midpoint is sgn * (d / 2^(N*FLINT_BITS)) * 2^exp where d is
+  normalized (top bit set), or zero (d = 0, exp = 0, sgn = 0).
+  The radius is a mag_struct whose exponent always fits in a word,
+  so no memory is ever allocated. A result whose exponents would leave
+  the allowed range is marked as indeterminate by exp = ARB_FIXED_EXP_NAN.
+*/
+
+#define ARB_FIXED_MAX_LIMBS 4
+#define ARB_FIXED_MAX_EXP (COEFF_MAX / 16)
+#define ARB_FIXED_EXP_NAN WORD_MIN
+
+typedef struct
+{
+    mp_limb_t d[2];
+    slong exp;
+    int sgn;
+    mag_struct rad;
+}
+arb2_struct;
+
+typedef arb2_struct arb2_t[1];
+typedef arb2_struct * arb2_ptr;
+typedef const arb2_struct * arb2_srcptr;
+
+typedef struct
+{
+    mp_limb_t d[4];
+    slong exp;
+    int sgn;
+    mag_struct rad;
+}
+arb4_struct;
+
+typedef arb4_struct arb4_t[1];
+typedef arb4_struct * arb4_ptr;
+typedef const arb4_struct * arb4_srcptr;
+
+/* Midpoint kernels (return nonzero if inexact; allow aliasing) */
+
+int _arb_fixed_add(mp_ptr zd, slong * zexp, int * zsgn,
+    mp_srcptr xd, slong xexp, int xsgn,
+    mp_srcptr yd, slong yexp, int ysgn, slong n);
+
+int _arb_fixed_mul(mp_ptr zd, slong * zexp, int * zsgn,
+    mp_srcptr xd, slong xexp, int xsgn,
+    mp_srcptr yd, slong yexp, int ysgn, slong n);
+
+int _arb_fixed_div(mp_ptr zd, slong * zexp, int * zsgn,
+    mp_srcptr xd, slong xexp, int xsgn,
+    mp_srcptr yd, slong yexp, int ysgn, slong n);
+
+int _arb_fixed_sqrt(mp_ptr zd, slong * zexp, mp_srcptr xd, slong xexp, slong n);
+
+int _arb_fixed_set_arf(mp_ptr zd, slong * zexp, int * zsgn, const arf_t x, slong n);
+
+/* Radius helpers (small exponents only) */
+
+/* upper bound for |mid| */
+ARB_FIXED_INLINE void
+_arb_fixed_mid_get_mag(mag_t z, mp_srcptr d, slong exp, slong n)
+{
+    if (d[n - 1] == 0)
+    {
+        mag_fast_zero(z);
+    }
+    else
+    {
+        MAG_MAN(z) = (d[n - 1] >> (FLINT_BITS - MAG_BITS)) + LIMB_ONE;
+        MAG_EXP(z) = exp;
+        MAG_FAST_ADJUST_ONE_TOO_LARGE(z);
+    }
+}
+
+/* lower bound for |mid| */
+ARB_FIXED_INLINE void
+_arb_fixed_mid_get_mag_lower(mag_t z, mp_srcptr d, slong exp, slong n)
+{
+    if (d[n - 1] == 0)
+    {
+        mag_fast_zero(z);
+    }
+    else
+    {
+        MAG_MAN(z) = d[n - 1] >> (FLINT_BITS - MAG_BITS);
+        MAG_EXP(z) = exp;
+    }
+}
+
+/* z = x + y, rounded up */
+ARB_FIXED_INLINE void
+_arb_fixed_mag_add(mag_t z, const mag_t x, const mag_t y)
+{
+    slong shift;
+
+    if (MAG_MAN(x) == 0)
+    {
+        mag_fast_init_set(z, y);
+    }
+    else if (MAG_MAN(y) == 0)
+    {
+        mag_fast_init_set(z, x);
+    }
+    else
+    {
+        shift = MAG_EXP(x) - MAG_EXP(y);
+
+        if (shift >= 0)
+        {
+            MAG_EXP(z) = MAG_EXP(x);
+            if (shift >= MAG_BITS)
+                MAG_MAN(z) = MAG_MAN(x) + LIMB_ONE;
+            else
+                MAG_MAN(z) = MAG_MAN(x) + (MAG_MAN(y) >> shift) + LIMB_ONE;
+        }
+        else
+        {
+            shift = -shift;
+            MAG_EXP(z) = MAG_EXP(y);
+            if (shift >= MAG_BITS)
+                MAG_MAN(z) = MAG_MAN(y) + LIMB_ONE;
+            else
+                MAG_MAN(z) = MAG_MAN(y) + (MAG_MAN(x) >> shift) + LIMB_ONE;
+        }
+
+        MAG_FAST_ADJUST_ONE_TOO_LARGE(z);
+    }
+}
+
+ARB_FIXED_INLINE int
+_arb_fixed_exp_ok(slong exp, const mag_t rad)
+{
+    return exp >= -ARB_FIXED_MAX_EXP && exp <= ARB_FIXED_MAX_EXP &&
+        (MAG_MAN(rad) == 0 || (MAG_EXP(rad) >= -ARB_FIXED_MAX_EXP &&
+                               MAG_EXP(rad) <= ARB_FIXED_MAX_EXP));
+}
+
+/* Basic operations on arb2_t */
+
+ARB_FIXED_INLINE void
+arb2_zero(arb2_t x)
+{
+    x->d[0] = x->d[1] = 0;
+    x->exp = 0;
+    x->sgn = 0;
+    mag_fast_zero(&x->rad);
+}
+
+ARB_FIXED_INLINE void
+arb2_init(arb2_t x)
+{
+    arb2_zero(x);
+}
+
+ARB_FIXED_INLINE void
+arb2_clear(arb2_t x)
+{
+}
+
+ARB_FIXED_INLINE void
+arb2_indeterminate(arb2_t x)
+{
+    arb2_zero(x);
+    x->exp = ARB_FIXED_EXP_NAN;
+}
+
+ARB_FIXED_INLINE int
+arb2_is_finite(const arb2_t x)
+{
+    return x->exp != ARB_FIXED_EXP_NAN;
+}
+
+ARB_FIXED_INLINE int
+arb2_is_exact(const arb2_t x)
+{
+    return x->exp != ARB_FIXED_EXP_NAN && MAG_MAN(&x->rad) == 0;
+}
+
+ARB_FIXED_INLINE void
+arb2_set(arb2_t z, const arb2_t x)
+{
+    *z = *x;
+}
+
+ARB_FIXED_INLINE void
+arb2_swap(arb2_t x, arb2_t y)
+{
+    arb2_struct t = *x;
+    *x = *y;
+    *y = t;
+}
+
+ARB_FIXED_INLINE void
+arb2_neg(arb2_t z, const arb2_t x)
+{
+    *z = *x;
+    z->sgn = (z->d[1] != 0) ? !z->sgn : 0;
+}
+
+void arb2_set_si(arb2_t z, slong c);
+int arb2_set_arb(arb2_t z, const arb_t x);
+void arb2_get_arb(arb_t z, const arb2_t x);
+
+void arb2_add(arb2_t z, const arb2_t x, const arb2_t y);
+void arb2_sub(arb2_t z, const arb2_t x, const arb2_t y);
+void arb2_mul(arb2_t z, const arb2_t x, const arb2_t y);
+void arb2_addmul(arb2_t z, const arb2_t x, const arb2_t y);
+void arb2_div(arb2_t z, const arb2_t x, const arb2_t y);
+void arb2_sqrt(arb2_t z, const arb2_t x);
+
+/* Basic operations on arb4_t */
+
+ARB_FIXED_INLINE void
+arb4_zero(arb4_t x)
+{
+    x->d[0] = x->d[1] = x->d[2] = x->d[3] = 0;
+    x->exp = 0;
+    x->sgn = 0;
+    mag_fast_zero(&x->rad);
+}
+
+ARB_FIXED_INLINE void
+arb4_init(arb4_t x)
+{
+    arb4_zero(x);
+}
+
+ARB_FIXED_INLINE void
+arb4_clear(arb4_t x)
+{
+}
+
+ARB_FIXED_INLINE void
+arb4_indeterminate(arb4_t x)
+{
+    arb4_zero(x);
+    x->exp = ARB_FIXED_EXP_NAN;
+}
+
+ARB_FIXED_INLINE int
+arb4_is_finite(const arb4_t x)
+{
+    return x->exp != ARB_FIXED_EXP_NAN;
+}
+
+ARB_FIXED_INLINE int
+arb4_is_exact(const arb4_t x)
+{
+    return x->exp != ARB_FIXED_EXP_NAN && MAG_MAN(&x->rad) == 0;
+}
+
+ARB_FIXED_INLINE void
+arb4_set(arb4_t z, const arb4_t x)
+{
+    *z = *x;
+}
+
+ARB_FIXED_INLINE void
+arb4_swap(arb4_t x, arb4_t y)
+{
+    arb4_struct t = *x;
+    *x = *y;
+    *y = t;
+}
+
+ARB_FIXED_INLINE void
+arb4_neg(arb4_t z, const arb4_t x)
+{
+    *z = *x;
+    z->sgn = (z->d[3] != 0) ? !z->sgn : 0;
+}
+
+void arb4_set_si(arb4_t z, slong c);
+int arb4_set_arb(arb4_t z, const arb_t x);
+void arb4_get_arb(arb_t z, const arb4_t x);
+
+void arb4_add(arb4_t z, const arb4_t x, const arb4_t y);
+void arb4_sub(arb4_t z, const arb4_t x, const arb4_t y);
+void arb4_mul(arb4_t z, const arb4_t x, const arb4_t y);
+void arb4_addmul(arb4_t z, const arb4_t x, const arb4_t y);
+void arb4_div(arb4_t z, const arb4_t x, const arb4_t y);
+void arb4_sqrt(arb4_t z, const arb4_t x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
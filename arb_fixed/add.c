@@ -0,0 +1,58 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+#define DEF_ADD(T, N) \
+void \
+T ## _add(T ## _t z, const T ## _t x, const T ## _t y) \
+{ \
+    mag_struct rad; \
+    int inexact; \
+    if (x->exp == ARB_FIXED_EXP_NAN || y->exp == ARB_FIXED_EXP_NAN) \
+    { \
+        T ## _indeterminate(z); \
+        return; \
+    } \
+    _arb_fixed_mag_add(&rad, &x->rad, &y->rad); \
+    inexact = _arb_fixed_add(z->d, &z->exp, &z->sgn, \
+        x->d, x->exp, x->sgn, y->d, y->exp, y->sgn, N); \
+    if (inexact) \
+        mag_fast_add_2exp_si(&rad, &rad, z->exp - N * FLINT_BITS + 1); \
+    z->rad = rad; \
+    if (!_arb_fixed_exp_ok(z->exp, &z->rad)) \
+        T ## _indeterminate(z); \
+} \
+\
+void \
+T ## _sub(T ## _t z, const T ## _t x, const T ## _t y) \
+{ \
+    mag_struct rad; \
+    int inexact; \
+    if (x->exp == ARB_FIXED_EXP_NAN || y->exp == ARB_FIXED_EXP_NAN) \
+    { \
+        T ## _indeterminate(z); \
+        return; \
+    } \
+    _arb_fixed_mag_add(&rad, &x->rad, &y->rad); \
+    inexact = _arb_fixed_add(z->d, &z->exp, &z->sgn, \
+        x->d, x->exp, x->sgn, y->d, y->exp, !y->sgn, N); \
+    if (z->d[N - 1] == 0) \
+        z->sgn = 0; \
+    if (inexact) \
+        mag_fast_add_2exp_si(&rad, &rad, z->exp - N * FLINT_BITS + 1); \
+    z->rad = rad; \
+    if (!_arb_fixed_exp_ok(z->exp, &z->rad)) \
+        T ## _indeterminate(z); \
+}
+
+DEF_ADD(arb2, 2)
+DEF_ADD(arb4, 4)
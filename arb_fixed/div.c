@@ -0,0 +1,58 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+/* rad = (|x| ry + |y| rx) / (|y| (|y| - ry)), like arb_div */
+#define DEF_DIV(T, N) \
+void \
+T ## _div(T ## _t z, const T ## _t x, const T ## _t y) \
+{ \
+    mag_struct rad, xm, ym, t; \
+    int inexact; \
+    if (x->exp == ARB_FIXED_EXP_NAN || y->exp == ARB_FIXED_EXP_NAN || \
+        y->d[N - 1] == 0) \
+    { \
+        T ## _indeterminate(z); \
+        return; \
+    } \
+    if (MAG_MAN(&x->rad) == 0 && MAG_MAN(&y->rad) == 0) \
+    { \
+        mag_fast_zero(&rad); \
+    } \
+    else \
+    { \
+        _arb_fixed_mid_get_mag(&xm, x->d, x->exp, N); \
+        _arb_fixed_mid_get_mag(&ym, y->d, y->exp, N); \
+        mag_fast_mul(&rad, &xm, &y->rad); \
+        mag_fast_addmul(&rad, &ym, &x->rad); \
+        _arb_fixed_mid_get_mag_lower(&ym, y->d, y->exp, N); \
+        mag_init(&t); \
+        mag_sub_lower(&t, &ym, &y->rad); \
+        mag_mul_lower(&t, &t, &ym); \
+        if (mag_is_zero(&t)) \
+        { \
+            T ## _indeterminate(z); \
+            return; \
+        } \
+        mag_div(&rad, &rad, &t); \
+    } \
+    inexact = _arb_fixed_div(z->d, &z->exp, &z->sgn, \
+        x->d, x->exp, x->sgn, y->d, y->exp, y->sgn, N); \
+    if (inexact) \
+        mag_fast_add_2exp_si(&rad, &rad, z->exp - N * FLINT_BITS); \
+    z->rad = rad; \
+    if (!_arb_fixed_exp_ok(z->exp, &z->rad)) \
+        T ## _indeterminate(z); \
+}
+
+DEF_DIV(arb2, 2)
+DEF_DIV(arb4, 4)
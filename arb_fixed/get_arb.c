@@ -0,0 +1,34 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+#define DEF_GET_ARB(T, N) \
+void \
+T ## _get_arb(arb_t z, const T ## _t x) \
+{ \
+    if (x->exp == ARB_FIXED_EXP_NAN) \
+    { \
+        arb_indeterminate(z); \
+        return; \
+    } \
+    if (x->d[N - 1] == 0) \
+        arf_zero(arb_midref(z)); \
+    else \
+    { \
+        arf_set_mpn(arb_midref(z), x->d, N, x->sgn); \
+        arf_mul_2exp_si(arb_midref(z), arb_midref(z), x->exp - N * FLINT_BITS); \
+    } \
+    mag_set(arb_radref(z), &x->rad); \
+}
+
+DEF_GET_ARB(arb2, 2)
+DEF_GET_ARB(arb4, 4)
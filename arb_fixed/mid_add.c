@@ -0,0 +1,143 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+/* The sum is computed with one guard limb and truncated. If inexact,
+   the error is less than 2 ulp of the output. */
+int
+_arb_fixed_add(mp_ptr zd, slong * zexp, int * zsgn,
+    mp_srcptr xd, slong xexp, int xsgn,
+    mp_srcptr yd, slong yexp, int ysgn, slong n)
+{
+    mp_limb_t t[ARB_FIXED_MAX_LIMBS + 1];
+    mp_limb_t u[ARB_FIXED_MAX_LIMBS + 1];
+    mp_limb_t s[ARB_FIXED_MAX_LIMBS + 1];
+    slong shift, limbs, bits, e, i;
+    int inexact;
+
+    if (yd[n - 1] == 0)
+    {
+        if (zd != xd)
+            flint_mpn_copyi(zd, xd, n);
+        *zexp = xexp;
+        *zsgn = xsgn;
+        return 0;
+    }
+
+    if (xd[n - 1] == 0)
+    {
+        if (zd != yd)
+            flint_mpn_copyi(zd, yd, n);
+        *zexp = yexp;
+        *zsgn = ysgn;
+        return 0;
+    }
+
+    /* ensure |x| >= |y| */
+    if (xexp < yexp || (xexp == yexp && mpn_cmp(xd, yd, n) < 0))
+    {
+        mp_srcptr td;
+        slong te;
+        int ts;
+
+        td = xd; xd = yd; yd = td;
+        te = xexp; xexp = yexp; yexp = te;
+        ts = xsgn; xsgn = ysgn; ysgn = ts;
+    }
+
+    shift = xexp - yexp;
+    inexact = 0;
+
+    t[0] = 0;
+    flint_mpn_copyi(t + 1, xd, n);
+
+    /* u = y shifted right, with a guard limb */
+    if (shift >= (n + 1) * FLINT_BITS)
+    {
+        flint_mpn_zero(u, n + 1);
+        inexact = 1;
+    }
+    else
+    {
+        limbs = shift / FLINT_BITS;
+        bits = shift % FLINT_BITS;
+
+        s[0] = 0;
+        flint_mpn_copyi(s + 1, yd, n);
+
+        for (i = 0; i < limbs; i++)
+            inexact |= (s[i] != 0);
+
+        if (bits == 0)
+            flint_mpn_copyi(u, s + limbs, n + 1 - limbs);
+        else
+            inexact |= (mpn_rshift(u, s + limbs, n + 1 - limbs, bits) != 0);
+
+        flint_mpn_zero(u + n + 1 - limbs, limbs);
+    }
+
+    e = xexp;
+
+    if (xsgn == ysgn)
+    {
+        if (mpn_add_n(t, t, u, n + 1))
+        {
+            inexact |= (t[0] & 1);
+            mpn_rshift(t, t, n + 1, 1);
+            t[n] |= LIMB_TOP;
+            e++;
+        }
+    }
+    else
+    {
+        mp_limb_t top;
+        slong zlimbs, zbits;
+
+        mpn_sub_n(t, t, u, n + 1);
+
+        /* normalize */
+        zlimbs = 0;
+        while (zlimbs <= n && t[n - zlimbs] == 0)
+            zlimbs++;
+
+        if (zlimbs == n + 1)
+        {
+            flint_mpn_zero(zd, n);
+            *zexp = 0;
+            *zsgn = 0;
+            return inexact;
+        }
+
+        top = t[n - zlimbs];
+        count_leading_zeros(zbits, top);
+
+        if (zlimbs != 0)
+        {
+            for (i = n; i >= zlimbs; i--)
+                t[i] = t[i - zlimbs];
+            for (i = 0; i < zlimbs; i++)
+                t[i] = 0;
+        }
+
+        if (zbits != 0)
+            mpn_lshift(t, t, n + 1, zbits);
+
+        e -= zlimbs * FLINT_BITS + zbits;
+    }
+
+    inexact |= (t[0] != 0);
+    flint_mpn_copyi(zd, t + 1, n);
+    *zexp = e;
+    *zsgn = xsgn;
+
+    return inexact;
+}
@@ -0,0 +1,58 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+/* Truncated quotient; requires y != 0. If inexact, the error is less
+   than 1 ulp. */
+int
+_arb_fixed_div(mp_ptr zd, slong * zexp, int * zsgn,
+    mp_srcptr xd, slong xexp, int xsgn,
+    mp_srcptr yd, slong yexp, int ysgn, slong n)
+{
+    mp_limb_t num[2 * ARB_FIXED_MAX_LIMBS + 1];
+    mp_limb_t q[ARB_FIXED_MAX_LIMBS + 2];
+    mp_limb_t r[ARB_FIXED_MAX_LIMBS];
+    slong e;
+    int inexact;
+
+    if (xd[n - 1] == 0)
+    {
+        flint_mpn_zero(zd, n);
+        *zexp = 0;
+        *zsgn = 0;
+        return 0;
+    }
+
+    /* q = floor(x * 2^((n+1) FLINT_BITS) / y), which has n + 1 or
+       n + 2 limbs */
+    flint_mpn_zero(num, n + 1);
+    flint_mpn_copyi(num + n + 1, xd, n);
+    mpn_tdiv_qr(q, r, 0, num, 2 * n + 1, yd, n);
+
+    inexact = !flint_mpn_zero_p(r, n);
+    e = xexp - yexp;
+
+    if (q[n + 1] != 0)
+    {
+        inexact |= (q[0] & 1);
+        mpn_rshift(q, q, n + 2, 1);
+        e++;
+    }
+
+    inexact |= (q[0] != 0);
+
+    flint_mpn_copyi(zd, q + 1, n);
+    *zexp = e;
+    *zsgn = xsgn ^ ysgn;
+
+    return inexact;
+}
@@ -0,0 +1,49 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+/* Truncated product; if inexact, the error is less than 1 ulp. */
+int
+_arb_fixed_mul(mp_ptr zd, slong * zexp, int * zsgn,
+    mp_srcptr xd, slong xexp, int xsgn,
+    mp_srcptr yd, slong yexp, int ysgn, slong n)
+{
+    mp_limb_t p[2 * ARB_FIXED_MAX_LIMBS];
+    slong e;
+
+    if (xd[n - 1] == 0 || yd[n - 1] == 0)
+    {
+        flint_mpn_zero(zd, n);
+        *zexp = 0;
+        *zsgn = 0;
+        return 0;
+    }
+
+    if (n == 1)
+        umul_ppmm(p[1], p[0], xd[0], yd[0]);
+    else
+        mpn_mul_n(p, xd, yd, n);
+
+    e = xexp + yexp;
+
+    if (!(p[2 * n - 1] & LIMB_TOP))
+    {
+        mpn_lshift(p, p, 2 * n, 1);
+        e--;
+    }
+
+    flint_mpn_copyi(zd, p + n, n);
+    *zexp = e;
+    *zsgn = xsgn ^ ysgn;
+
+    return !flint_mpn_zero_p(p, n);
+}
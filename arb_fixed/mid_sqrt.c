@@ -0,0 +1,43 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+/* Truncated square root of |x|; if inexact, the error is less than 1 ulp. */
+int
+_arb_fixed_sqrt(mp_ptr zd, slong * zexp, mp_srcptr xd, slong xexp, slong n)
+{
+    mp_limb_t a[2 * ARB_FIXED_MAX_LIMBS];
+    mp_limb_t r[ARB_FIXED_MAX_LIMBS + 1];
+    mp_size_t rn;
+
+    if (xd[n - 1] == 0)
+    {
+        flint_mpn_zero(zd, n);
+        *zexp = 0;
+        return 0;
+    }
+
+    /* a = x * 2^(2 n FLINT_BITS), halved if the exponent is odd */
+    flint_mpn_zero(a, n);
+    flint_mpn_copyi(a + n, xd, n);
+
+    if (xexp & 1)
+    {
+        mpn_rshift(a, a, 2 * n, 1);
+        xexp++;
+    }
+
+    rn = mpn_sqrtrem(zd, r, a, 2 * n);
+    *zexp = xexp / 2;
+
+    return rn != 0;
+}
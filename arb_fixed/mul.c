@@ -0,0 +1,56 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+/* rad = |x| ry + |y| rx + rx ry */
+#define DEF_MUL(T, N) \
+void \
+T ## _mul(T ## _t z, const T ## _t x, const T ## _t y) \
+{ \
+    mag_struct rad, xm, ym; \
+    int inexact; \
+    if (x->exp == ARB_FIXED_EXP_NAN || y->exp == ARB_FIXED_EXP_NAN) \
+    { \
+        T ## _indeterminate(z); \
+        return; \
+    } \
+    if (MAG_MAN(&x->rad) == 0 && MAG_MAN(&y->rad) == 0) \
+    { \
+        mag_fast_zero(&rad); \
+    } \
+    else \
+    { \
+        _arb_fixed_mid_get_mag(&xm, x->d, x->exp, N); \
+        _arb_fixed_mid_get_mag(&ym, y->d, y->exp, N); \
+        mag_fast_mul(&rad, &x->rad, &y->rad); \
+        mag_fast_addmul(&rad, &xm, &y->rad); \
+        mag_fast_addmul(&rad, &ym, &x->rad); \
+    } \
+    inexact = _arb_fixed_mul(z->d, &z->exp, &z->sgn, \
+        x->d, x->exp, x->sgn, y->d, y->exp, y->sgn, N); \
+    if (inexact) \
+        mag_fast_add_2exp_si(&rad, &rad, z->exp - N * FLINT_BITS); \
+    z->rad = rad; \
+    if (!_arb_fixed_exp_ok(z->exp, &z->rad)) \
+        T ## _indeterminate(z); \
+} \
+\
+void \
+T ## _addmul(T ## _t z, const T ## _t x, const T ## _t y) \
+{ \
+    T ## _t t; \
+    T ## _mul(t, x, y); \
+    T ## _add(z, z, t); \
+}
+
+DEF_MUL(arb2, 2)
+DEF_MUL(arb4, 4)
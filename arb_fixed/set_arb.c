@@ -0,0 +1,39 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+#define DEF_SET_ARB(T, N) \
+int \
+T ## _set_arb(T ## _t z, const arb_t x) \
+{ \
+    int inexact; \
+    if (!arb_is_finite(x) || \
+        COEFF_IS_MPZ(ARF_EXP(arb_midref(x))) || \
+        COEFF_IS_MPZ(MAG_EXP(arb_radref(x)))) \
+    { \
+        T ## _indeterminate(z); \
+        return 0; \
+    } \
+    inexact = _arb_fixed_set_arf(z->d, &z->exp, &z->sgn, arb_midref(x), N); \
+    mag_fast_init_set(&z->rad, arb_radref(x)); \
+    if (inexact) \
+        mag_fast_add_2exp_si(&z->rad, &z->rad, z->exp - N * FLINT_BITS); \
+    if (!_arb_fixed_exp_ok(z->exp, &z->rad)) \
+    { \
+        T ## _indeterminate(z); \
+        return 0; \
+    } \
+    return 1; \
+}
+
+DEF_SET_ARB(arb2, 2)
+DEF_SET_ARB(arb4, 4)
@@ -0,0 +1,46 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+/* Requires x to be finite with a small exponent. If inexact (truncated),
+   the error is less than 1 ulp. */
+int
+_arb_fixed_set_arf(mp_ptr zd, slong * zexp, int * zsgn, const arf_t x, slong n)
+{
+    mp_srcptr xp;
+    mp_size_t xn;
+
+    if (arf_is_zero(x))
+    {
+        flint_mpn_zero(zd, n);
+        *zexp = 0;
+        *zsgn = 0;
+        return 0;
+    }
+
+    ARF_GET_MPN_READONLY(xp, xn, x);
+
+    *zexp = ARF_EXP(x);
+    *zsgn = ARF_SGNBIT(x);
+
+    if (xn >= n)
+    {
+        flint_mpn_copyi(zd, xp + xn - n, n);
+        return xn > n;
+    }
+    else
+    {
+        flint_mpn_zero(zd, n - xn);
+        flint_mpn_copyi(zd + n - xn, xp, xn);
+        return 0;
+    }
+}
@@ -0,0 +1,32 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+#define DEF_SET_SI(T, N) \
+void \
+T ## _set_si(T ## _t z, slong c) \
+{ \
+    mp_limb_t v; \
+    unsigned int bits; \
+    T ## _zero(z); \
+    if (c != 0) \
+    { \
+        v = FLINT_UABS(c); \
+        count_leading_zeros(bits, v); \
+        z->d[N - 1] = v << bits; \
+        z->exp = FLINT_BITS - bits; \
+        z->sgn = (c < 0); \
+    } \
+}
+
+DEF_SET_SI(arb2, 2)
+DEF_SET_SI(arb4, 4)
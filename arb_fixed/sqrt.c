@@ -0,0 +1,56 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+/* rad = r / (2 sqrt(m - r)); balls that are not strictly positive
+   (except exact zero) give an indeterminate result */
+#define DEF_SQRT(T, N) \
+void \
+T ## _sqrt(T ## _t z, const T ## _t x) \
+{ \
+    mag_struct rad, t; \
+    int inexact; \
+    if (x->exp == ARB_FIXED_EXP_NAN || (x->sgn && x->d[N - 1] != 0)) \
+    { \
+        T ## _indeterminate(z); \
+        return; \
+    } \
+    if (MAG_MAN(&x->rad) == 0) \
+    { \
+        mag_fast_zero(&rad); \
+    } \
+    else \
+    { \
+        mag_init(&t); \
+        _arb_fixed_mid_get_mag_lower(&t, x->d, x->exp, N); \
+        mag_sub_lower(&t, &t, &x->rad); \
+        if (mag_is_zero(&t)) \
+        { \
+            T ## _indeterminate(z); \
+            return; \
+        } \
+        mag_sqrt_lower(&t, &t); \
+        mag_init(&rad); \
+        mag_div(&rad, &x->rad, &t); \
+        mag_mul_2exp_si(&rad, &rad, -1); \
+    } \
+    inexact = _arb_fixed_sqrt(z->d, &z->exp, x->d, x->exp, N); \
+    z->sgn = 0; \
+    if (inexact) \
+        mag_fast_add_2exp_si(&rad, &rad, z->exp - N * FLINT_BITS); \
+    z->rad = rad; \
+    if (!_arb_fixed_exp_ok(z->exp, &z->rad)) \
+        T ## _indeterminate(z); \
+}
+
+DEF_SQRT(arb2, 2)
+DEF_SQRT(arb4, 4)
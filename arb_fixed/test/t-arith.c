@@ -0,0 +1,128 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_fixed.h"
+
+static void
+check(const char * name, const arb_t x, const arb_t y, const arb_t z1,
+    const arb_t z2, int exact, slong prec)
+{
+    /* when exact is set, z1 is computed exactly and z2 must contain
+       its midpoint */
+    if ((exact && !arb_contains_arf(z2, arb_midref(z1))) || !arb_overlaps(z1, z2) ||
+        (arb_is_exact(x) && arb_is_exact(y) && arb_is_finite(z2) &&
+            arb_rel_accuracy_bits(z2) < prec - 4))
+    {
+        flint_printf("FAIL: %s\n\n", name);
+        flint_printf("x = "); arb_printd(x, 50); flint_printf("\n\n");
+        flint_printf("y = "); arb_printd(y, 50); flint_printf("\n\n");
+        flint_printf("z1 = "); arb_printd(z1, 50); flint_printf("\n\n");
+        flint_printf("z2 = "); arb_printd(z2, 50); flint_printf("\n\n");
+        flint_abort();
+    }
+}
+
+#define TEST(T, N) \
+static void \
+test_ ## T(flint_rand_t state) \
+{ \
+    T ## _t a, b, c; \
+    arb_t x, y, z1, z2; \
+    slong prec = N * FLINT_BITS; \
+    arb_init(x); \
+    arb_init(y); \
+    arb_init(z1); \
+    arb_init(z2); \
+    arb_randtest(x, state, 1 + n_randint(state, prec + 20), 6); \
+    arb_randtest(y, state, 1 + n_randint(state, prec + 20), 6); \
+    if (n_randint(state, 2)) \
+    { \
+        mag_zero(arb_radref(x)); \
+        mag_zero(arb_radref(y)); \
+    } \
+    if (!T ## _set_arb(a, x) || !T ## _set_arb(b, y)) \
+    { \
+        flint_printf("FAIL: set_arb\n\n"); \
+        flint_abort(); \
+    } \
+    /* work with the exactly representable inputs */ \
+    T ## _get_arb(x, a); \
+    T ## _get_arb(y, b); \
+    arb_add(z1, x, y, ARF_PREC_EXACT); \
+    T ## _add(c, a, b); \
+    T ## _get_arb(z2, c); \
+    check(#T "_add", x, y, z1, z2, 1, prec); \
+    arb_sub(z1, x, y, ARF_PREC_EXACT); \
+    T ## _sub(c, a, b); \
+    T ## _get_arb(z2, c); \
+    check(#T "_sub", x, y, z1, z2, 1, prec); \
+    arb_mul(z1, x, y, ARF_PREC_EXACT); \
+    T ## _mul(c, a, b); \
+    T ## _get_arb(z2, c); \
+    check(#T "_mul", x, y, z1, z2, 1, prec); \
+    arb_set(z1, y); \
+    arb_addmul(z1, x, y, ARF_PREC_EXACT); \
+    T ## _set(c, b); \
+    T ## _addmul(c, a, b); \
+    T ## _get_arb(z2, c); \
+    check(#T "_addmul", x, y, z1, z2, 1, 0); \
+    arb_div(z1, x, y, 4 * prec); \
+    T ## _div(c, a, b); \
+    T ## _get_arb(z2, c); \
+    if (arb_is_finite(z2)) \
+        check(#T "_div", x, y, z1, z2, 0, prec); \
+    else if (arb_is_exact(y) && !arb_is_zero(y)) \
+    { \
+        flint_printf("FAIL: " #T "_div (finite)\n\n"); \
+        flint_abort(); \
+    } \
+    arb_abs(x, x); \
+    T ## _set_arb(a, x); \
+    arb_sqrt(z1, x, 4 * prec); \
+    T ## _sqrt(c, a); \
+    T ## _get_arb(z2, c); \
+    if (arb_is_finite(z2)) \
+        check(#T "_sqrt", x, x, z1, z2, 0, prec); \
+    else if (arb_is_exact(x) && !arb_is_zero(x)) \
+    { \
+        flint_printf("FAIL: " #T "_sqrt (finite)\n\n"); \
+        flint_abort(); \
+    } \
+    arb_clear(x); \
+    arb_clear(y); \
+    arb_clear(z1); \
+    arb_clear(z2); \
+}
+
+TEST(arb2, 2)
+TEST(arb4, 4)
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("arith....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 100000 * arb_test_multiplier(); iter++)
+    {
+        test_arb2(state);
+        test_arb4(state);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -31,6 +31,7 @@ extern "C" {
 
 #define FPWRAP_ACCURATE_PARTS 1
 #define FPWRAP_CORRECT_ROUNDING 2
+#define FPWRAP_LEARN_PRECISION 4
 #define FPWRAP_WORK_LIMIT 65536
 
 typedef struct
@@ -325,6 +326,74 @@ int arb_fpwrap_cdouble_modular_j(complex_double * res, complex_double tau, int f
 int arb_fpwrap_cdouble_modular_lambda(complex_double * res, complex_double tau, int flags);
 int arb_fpwrap_cdouble_modular_delta(complex_double * res, complex_double tau, int flags);
 
+/* Vector versions of the real one-argument functions */
+
+int arb_fpwrap_double_exp_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_expm1_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_log_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_log1p_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_sqrt_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_rsqrt_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_cbrt_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_sin_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_cos_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_tan_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_cot_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_sec_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_csc_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_sinc_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_sin_pi_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_cos_pi_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_tan_pi_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_cot_pi_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_sinc_pi_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_asin_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_acos_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_atan_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_asinh_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_acosh_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_atanh_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_gamma_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_rgamma_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_lgamma_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_digamma_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_zeta_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_barnes_g_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_log_barnes_g_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_dilog_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_erf_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_erfc_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_erfi_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_erfinv_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_erfcinv_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_exp_integral_ei_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_sin_integral_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_cos_integral_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_sinh_integral_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_cosh_integral_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_airy_ai_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_airy_ai_prime_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_airy_bi_vec(double * res, int * status, const double * x, slong n, int flags);
+int arb_fpwrap_double_airy_bi_prime_vec(double * res, int * status, const double * x, slong n, int flags);
+
+/* Learned starting precision */
+
+typedef void (*_arb_fpwrap_func_t)(void);
+
+slong _arb_fpwrap_wp_cache_start(_arb_fpwrap_func_t func, double x, slong wp_max);
+void _arb_fpwrap_wp_cache_update(_arb_fpwrap_func_t func, double x, slong wp_start, slong wp_final, int success);
+
+void arb_fpwrap_wp_cache_clear(void);
+void arb_fpwrap_wp_cache_stats(slong * lookups, slong * hits, slong * restarts, slong * restarts_avoided);
+
+/* Certified double-double fast path (internal) */
+
+int _arb_fpwrap_double_exp_fast(double * res, double x, int flags);
+int _arb_fpwrap_double_log_fast(double * res, double x, int flags);
+int _arb_fpwrap_double_sin_fast(double * res, double x, int flags);
+int _arb_fpwrap_double_cos_fast(double * res, double x, int flags);
+int _arb_fpwrap_double_erf_fast(double * res, double x, int flags);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,484 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <math.h>
+#include <float.h>
+#include "arb_fpwrap.h"
+
+/*
+  Certified fast evaluation of some elementary functions using
+  double-double arithmetic.
+
+  Each function returns 1 and sets res if it can certify that the result
+  satisfies the same accuracy requirement as the ball arithmetic wrapper
+  (taking flags into account), and returns 0 without touching res
+  otherwise, in which case the caller falls back to ball arithmetic.
+
+  Error analysis: with u = 2^-53, each double-double operation used below
+  (accurate addition, multiplication, division by a double or
+  double-double) has relative error at most 15u^2 < 2^-100 (Joldes, Muller
+  and Popescu, "Tight and rigorous error bounds for basic building blocks
+  of double-word arithmetic", 2017). We take EPS = 2^-100 for every
+  operation and bound the propagation through each Horner scheme by hand.
+
+  The error-free transformations require round-to-nearest arithmetic
+  without extended intermediate precision, so the fast path is disabled
+  when this cannot be guaranteed at compile time. They also require
+  that a * b + c is not contracted to a fused multiply-add (which GCC
+  does by default in GNU mode, and with -ffp-contract=fast), so
+  contraction is turned off for this file. When a fast fma() is
+  available, it is used explicitly for the exact product instead.
+*/
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract (off)
+#else
+#pragma STDC FP_CONTRACT OFF
+#endif
+
+#if defined(__FAST_MATH__)
+#define FPWRAP_FAST_ENABLED 0
+#elif defined(FLT_EVAL_METHOD)
+#define FPWRAP_FAST_ENABLED (FLT_EVAL_METHOD == 0)
+#elif defined(__FLT_EVAL_METHOD__)
+#define FPWRAP_FAST_ENABLED (__FLT_EVAL_METHOD__ == 0)
+#else
+#define FPWRAP_FAST_ENABLED 0
+#endif
+
+/* ln(2) = LN2_1 + LN2_2 + LN2_3 + O(2^-157), LN2_1 having 42 bits */
+#define LN2_1 0.6931471805598903
+#define LN2_2 5.497923018708371e-14
+#define LN2_3 1.94704509238075e-31
+#define INV_LN2 1.4426950408889634
+
+/* pi/2 = PI2_1 + PI2_2 + PI2_3 + O(2^-142), PI2_1 having 31 bits */
+#define PI2_1 1.5707963267341256
+#define PI2_2 6.077100506506192e-11
+#define PI2_3 3.5215598651832e-27
+#define TWO_OVER_PI 0.6366197723675814
+
+/* 2/sqrt(pi) = TWO_OVER_SQRT_PI_HI + TWO_OVER_SQRT_PI_LO + O(2^-110) */
+#define TWO_OVER_SQRT_PI_HI 1.1283791670955126
+#define TWO_OVER_SQRT_PI_LO 1.533545961316588e-17
+
+#define SQRT_HALF 0.70710678118654752
+
+typedef struct
+{
+    double hi;
+    double lo;
+}
+dd_t;
+
+static __inline__ dd_t
+dd_set(double hi, double lo)
+{
+    dd_t res;
+    res.hi = hi;
+    res.lo = lo;
+    return res;
+}
+
+/* s + e = a + b exactly */
+static __inline__ dd_t
+dd_two_sum(double a, double b)
+{
+    double s, bb;
+    s = a + b;
+    bb = s - a;
+    return dd_set(s, (a - (s - bb)) + (b - bb));
+}
+
+/* s + e = a + b exactly, assuming |a| >= |b| */
+static __inline__ dd_t
+dd_fast_two_sum(double a, double b)
+{
+    double s;
+    s = a + b;
+    return dd_set(s, b - (s - a));
+}
+
+/* p + e = a * b exactly (Dekker, or using fma), assuming no overflow
+   or underflow */
+static __inline__ dd_t
+dd_two_prod(double a, double b)
+{
+#if defined(FP_FAST_FMA)
+    double p;
+
+    p = a * b;
+    return dd_set(p, fma(a, b, -p));
+#else
+    double p, c, ah, al, bh, bl;
+
+    p = a * b;
+    c = 134217729.0 * a;
+    ah = c - (c - a);
+    al = a - ah;
+    c = 134217729.0 * b;
+    bh = c - (c - b);
+    bl = b - bh;
+
+    return dd_set(p, ((ah * bh - p) + ah * bl + al * bh) + al * bl);
+#endif
+}
+
+static __inline__ dd_t
+dd_neg(dd_t x)
+{
+    return dd_set(-x.hi, -x.lo);
+}
+
+static dd_t
+dd_add(dd_t x, dd_t y)
+{
+    dd_t s, t, v;
+
+    s = dd_two_sum(x.hi, y.hi);
+    t = dd_two_sum(x.lo, y.lo);
+    v = dd_fast_two_sum(s.hi, s.lo + t.hi);
+    return dd_fast_two_sum(v.hi, t.lo + v.lo);
+}
+
+static __inline__ dd_t
+dd_sub(dd_t x, dd_t y)
+{
+    return dd_add(x, dd_neg(y));
+}
+
+static dd_t
+dd_mul(dd_t x, dd_t y)
+{
+    dd_t c;
+
+    c = dd_two_prod(x.hi, y.hi);
+    return dd_fast_two_sum(c.hi, c.lo + (x.hi * y.lo + x.lo * y.hi));
+}
+
+static dd_t
+dd_mul_d(dd_t x, double b)
+{
+    dd_t c, t;
+
+    c = dd_two_prod(x.hi, b);
+    t = dd_fast_two_sum(c.hi, x.lo * b);
+    return dd_fast_two_sum(t.hi, t.lo + c.lo);
+}
+
+static dd_t
+dd_div_d(dd_t x, double b)
+{
+    dd_t p;
+    double t;
+
+    t = x.hi / b;
+    p = dd_two_prod(t, b);
+    return dd_fast_two_sum(t, (((x.hi - p.hi) - p.lo) + x.lo) / b);
+}
+
+static dd_t
+dd_div(dd_t x, dd_t y)
+{
+    dd_t r;
+    double t;
+
+    t = x.hi / y.hi;
+    r = dd_mul_d(y, t);
+    return dd_fast_two_sum(t, ((x.hi - r.hi) + (x.lo - r.lo)) / y.hi);
+}
+
+/*
+  Given y = yh + yl with yh = fl(yh + yl) and a bound err for the distance
+  from y to the true (nonzero) function value, decides whether yh is an
+  acceptable output.
+*/
+static int
+_dd_accept(double yh, double yl, double err, int flags)
+{
+    double ulp, gap_toward_zero, m;
+    int e;
+
+    if (yh == 0.0 || yh != yh)
+        return 0;
+
+    if (flags & FPWRAP_CORRECT_ROUNDING)
+    {
+        /* the true value must lie strictly inside the rounding interval
+           of yh, which is narrower below a power of two */
+        m = frexp(yh, &e);
+        ulp = ldexp(1.0, e - 53);
+        gap_toward_zero = (m == 0.5 || m == -0.5) ? 0.5 * ulp : ulp;
+
+        if (yh < 0.0)
+            yl = -yl;
+
+        return (yl + err < 0.5 * ulp) && (-yl + err < 0.5 * gap_toward_zero);
+    }
+    else
+    {
+        return err <= ldexp(fabs(yh), -60);
+    }
+}
+
+int
+_arb_fpwrap_double_exp_fast(double * res, double x, int flags)
+{
+    dd_t r, p;
+    double k;
+    slong j;
+
+    if (!FPWRAP_FAST_ENABLED || !(fabs(x) <= 700.0))
+        return 0;
+
+    /* exp(x) is in (1 - 2^-59, 1 + 2^-59), which rounds to 1 */
+    if (fabs(x) < 8.673617379884035e-19)
+    {
+        *res = 1.0;
+        return 1;
+    }
+
+    /* x = k log(2) + r with |r| <= 0.36, with absolute error < 2^-96 */
+    k = floor(x * INV_LN2 + 0.5);
+    r = dd_two_sum(x, -k * LN2_1);
+    r = dd_sub(r, dd_two_prod(k, LN2_2));
+    r = dd_sub(r, dd_two_prod(k, LN2_3));
+
+    /* p = sum_{j<=27} r^j / j!, truncation error < 2^-139; the partial
+       Horner values lie in [0.6, 1.5] so the rounding errors amplify by
+       at most 0.9 per step, giving relative error < 30 EPS < 2^-95 */
+    p = dd_set(1.0, 0.0);
+    for (j = 27; j >= 1; j--)
+    {
+        p = dd_div_d(dd_mul(r, p), (double) j);
+        p = dd_add(dd_set(1.0, 0.0), p);
+    }
+
+    if (!_dd_accept(p.hi, p.lo, ldexp(p.hi, -92), flags))
+        return 0;
+
+    /* exact since the result is a normal number */
+    *res = ldexp(p.hi, (int) k);
+    return 1;
+}
+
+int
+_arb_fpwrap_double_log_fast(double * res, double x, int flags)
+{
+    dd_t s, s2, q, y;
+    double m;
+    slong j;
+    int e;
+
+    if (!FPWRAP_FAST_ENABLED || !(x >= DBL_MIN && x <= DBL_MAX))
+        return 0;
+
+    if (x == 1.0)
+    {
+        *res = 0.0;
+        return 1;
+    }
+
+    /* x = 2^e m with m in [sqrt(1/2), sqrt(2)) */
+    m = frexp(x, &e);
+    if (m < SQRT_HALF)
+    {
+        m *= 2.0;
+        e--;
+    }
+
+    /* log(m) = 2 atanh(s), s = (m-1)/(m+1), |s| <= 0.172; m - 1 is exact */
+    s = dd_div(dd_set(m - 1.0, 0.0), dd_two_sum(m, 1.0));
+    s2 = dd_mul(s, s);
+
+    /* q = sum_{j<=22} s^(2j) / (2j+1), truncation error < 2^-117; all
+       terms are positive so the relative error is < 4 EPS */
+    q = dd_div_d(dd_set(1.0, 0.0), 45.0);
+    for (j = 21; j >= 0; j--)
+    {
+        q = dd_mul(s2, q);
+        q = dd_add(dd_div_d(dd_set(1.0, 0.0), (double) (2 * j + 1)), q);
+    }
+
+    y = dd_mul(dd_set(2.0 * s.hi, 2.0 * s.lo), q);
+
+    /* y = e log(2) + log(m); |log(m)| <= |e| log(2) / 2 when e != 0, so
+       the addition amplifies errors by at most a factor 3, giving
+       relative error < 2^-94 in total */
+    if (e != 0)
+    {
+        dd_t t;
+        t = dd_two_sum(e * LN2_1, 0.0);
+        t = dd_add(t, dd_two_prod((double) e, LN2_2));
+        t = dd_add(t, dd_two_prod((double) e, LN2_3));
+        y = dd_add(t, y);
+    }
+
+    if (!_dd_accept(y.hi, y.lo, ldexp(fabs(y.hi), -92), flags))
+        return 0;
+
+    *res = y.hi;
+    return 1;
+}
+
+/* Sets y to sin(x) (if cosine = 0) or cos(x) (if cosine = 1) with
+   relative error < 2^-89, for 2^-30 <= |x| <= 2^20. Returns 0 if x is
+   too close to a multiple of pi/2. */
+static int
+_dd_sin_cos(dd_t * y, double x, int cosine)
+{
+    dd_t r, r2, t;
+    double k;
+    slong j, q;
+
+    /* x = k pi/2 + r, |r| <= 0.786, with absolute error
+       < 2 EPS |r| + 2^-117, and exactly if k = 0 */
+    k = floor(x * TWO_OVER_PI + 0.5);
+    r = dd_two_sum(x, -k * PI2_1);
+    r = dd_sub(r, dd_two_prod(k, PI2_2));
+    r = dd_sub(r, dd_two_prod(k, PI2_3));
+
+    /* ensure that r has relative error < 2^-90 */
+    if (k != 0.0 && fabs(r.hi) < 7.450580596923828e-09)
+        return 0;
+
+    q = ((slong) fmod(k, 4.0) + 4 + cosine) % 4;
+
+    /* Horner schemes with 15 terms, truncation error < 2^-134; the
+       partial values lie in [0.69, 1] and each step amplifies errors
+       by at most 0.45, giving relative error < 10 EPS */
+    r2 = dd_mul(r, r);
+    t = dd_set(1.0, 0.0);
+
+    if (q % 2 == 0)
+    {
+        /* sin(r) = r (1 - r^2/(2*3) (1 - r^2/(4*5) (1 - ...))) */
+        for (j = 15; j >= 1; j--)
+        {
+            t = dd_div_d(dd_mul(r2, t), (double) ((2 * j) * (2 * j + 1)));
+            t = dd_sub(dd_set(1.0, 0.0), t);
+        }
+
+        t = dd_mul(r, t);
+    }
+    else
+    {
+        /* cos(r) = 1 - r^2/(1*2) (1 - r^2/(3*4) (1 - ...)) */
+        for (j = 15; j >= 1; j--)
+        {
+            t = dd_div_d(dd_mul(r2, t), (double) ((2 * j - 1) * (2 * j)));
+            t = dd_sub(dd_set(1.0, 0.0), t);
+        }
+    }
+
+    *y = (q >= 2) ? dd_neg(t) : t;
+    return 1;
+}
+
+int
+_arb_fpwrap_double_sin_fast(double * res, double x, int flags)
+{
+    dd_t y;
+
+    if (!FPWRAP_FAST_ENABLED || !(fabs(x) <= 1048576.0))
+        return 0;
+
+    /* sin(x) = x (1 - d) with 0 <= d < 2^-61, which rounds to x */
+    if (fabs(x) < 9.313225746154785e-10)
+    {
+        *res = x;
+        return 1;
+    }
+
+    if (!_dd_sin_cos(&y, x, 0))
+        return 0;
+
+    if (!_dd_accept(y.hi, y.lo, ldexp(fabs(y.hi), -88), flags))
+        return 0;
+
+    *res = y.hi;
+    return 1;
+}
+
+int
+_arb_fpwrap_double_cos_fast(double * res, double x, int flags)
+{
+    dd_t y;
+
+    if (!FPWRAP_FAST_ENABLED || !(fabs(x) <= 1048576.0))
+        return 0;
+
+    /* cos(x) is in (1 - 2^-61, 1], which rounds to 1 */
+    if (fabs(x) < 9.313225746154785e-10)
+    {
+        *res = 1.0;
+        return 1;
+    }
+
+    if (!_dd_sin_cos(&y, x, 1))
+        return 0;
+
+    if (!_dd_accept(y.hi, y.lo, ldexp(fabs(y.hi), -88), flags))
+        return 0;
+
+    *res = y.hi;
+    return 1;
+}
+
+int
+_arb_fpwrap_double_erf_fast(double * res, double x, int flags)
+{
+    dd_t z, h, y;
+    double ax;
+    slong n;
+
+    ax = fabs(x);
+
+    if (!FPWRAP_FAST_ENABLED || !(ax >= 3.054936363499605e-151))
+        return 0;
+
+    /* 0 < erfc(x) < 2.2e-17 < 2^-55 for x >= 6, so erf(x) rounds to 1 */
+    if (ax >= 6.0)
+    {
+        *res = (x > 0.0) ? 1.0 : -1.0;
+        return 1;
+    }
+
+    if (ax > 1.0)
+        return 0;
+
+    /* erf(x) = (2/sqrt(pi)) x sum_{n<=30} (-x^2)^n / (n! (2n+1)),
+       truncation error < 2^-118. The sum is at least half the sum of the
+       absolute values of its terms, and each step of the Horner scheme
+       amplifies errors by at most 0.5, so the relative error of the sum
+       is < 20 EPS and the total relative error is < 2^-94. */
+    z = dd_neg(dd_two_prod(ax, ax));
+
+    h = dd_div_d(dd_set(1.0, 0.0), 61.0);
+    for (n = 29; n >= 0; n--)
+    {
+        h = dd_div_d(dd_mul(z, h), (double) (n + 1));
+        h = dd_add(dd_div_d(dd_set(1.0, 0.0), (double) (2 * n + 1)), h);
+    }
+
+    y = dd_mul_d(dd_set(TWO_OVER_SQRT_PI_HI, TWO_OVER_SQRT_PI_LO), ax);
+    y = dd_mul(y, h);
+
+    if (!_dd_accept(y.hi, y.lo, ldexp(fabs(y.hi), -92), flags))
+        return 0;
+
+    *res = (x > 0.0) ? y.hi : -y.hi;
+    return 1;
+}
@@ -188,7 +188,7 @@ typedef void (*acb_func_4_int)(acb_t, const acb_t, const acb_t, const acb_t, con
 int arb_fpwrap_double_1(double * res, arb_func_1 func, double x, int flags)
 {
     arb_t arb_res, arb_x;
-    slong wp;
+    slong wp, wp_start;
     int status;
 
     arb_init(arb_res);
@@ -203,11 +203,18 @@ int arb_fpwrap_double_1(double * res, arb_func_1 func, double x, int flags)
     }
     else
     {
-        for (wp = WP_INITIAL; ; wp *= 2)
+        wp_start = WP_INITIAL;
+        if (flags & FPWRAP_LEARN_PRECISION)
+            wp_start = _arb_fpwrap_wp_cache_start((_arb_fpwrap_func_t) func, x, double_wp_max(flags));
+
+        for (wp = wp_start; ; wp *= 2)
         {
             func(arb_res, arb_x, wp);
             DOUBLE_CHECK_RESULT
         }
+
+        if (flags & FPWRAP_LEARN_PRECISION)
+            _arb_fpwrap_wp_cache_update((_arb_fpwrap_func_t) func, x, wp_start, wp, status == FPWRAP_SUCCESS);
     }
 
     arb_clear(arb_x);
@@ -216,6 +223,125 @@ int arb_fpwrap_double_1(double * res, arb_func_1 func, double x, int flags)
     return status;
 }
 
+/* Vector version: elements are processed in chunks, each chunk
+   reusing the same temporaries, and chunks are distributed over threads. */
+
+#define VEC_CHUNK 64
+
+typedef int (*arb_fast_func_1)(double *, double, int);
+
+typedef struct
+{
+    double * res;
+    int * status;
+    arb_fast_func_1 fast;
+    arb_func_1 func;
+    const double * x;
+    slong n;
+    int flags;
+}
+double_1_vec_work_t;
+
+static void
+_arb_fpwrap_double_1_vec_worker(slong chunk, void * _work)
+{
+    double_1_vec_work_t * work = (double_1_vec_work_t *) _work;
+    arb_t arb_res, arb_x;
+    slong i, wp, wp_start;
+    int status, flags;
+    double * res;
+
+    flags = work->flags;
+
+    arb_init(arb_res);
+    arb_init(arb_x);
+
+    for (i = chunk * VEC_CHUNK; i < FLINT_MIN((chunk + 1) * VEC_CHUNK, work->n); i++)
+    {
+        res = work->res + i;
+
+        if (work->fast != NULL && work->fast(res, work->x[i], flags))
+        {
+            work->status[i] = FPWRAP_SUCCESS;
+            continue;
+        }
+
+        arb_set_d(arb_x, work->x[i]);
+
+        if (!arb_is_finite(arb_x))
+        {
+            *res = D_NAN;
+            status = FPWRAP_UNABLE;
+        }
+        else
+        {
+            wp_start = WP_INITIAL;
+            if (flags & FPWRAP_LEARN_PRECISION)
+                wp_start = _arb_fpwrap_wp_cache_start((_arb_fpwrap_func_t) work->func, work->x[i], double_wp_max(flags));
+
+            for (wp = wp_start; ; wp *= 2)
+            {
+                work->func(arb_res, arb_x, wp);
+                DOUBLE_CHECK_RESULT
+            }
+
+            if (flags & FPWRAP_LEARN_PRECISION)
+                _arb_fpwrap_wp_cache_update((_arb_fpwrap_func_t) work->func, work->x[i], wp_start, wp, status == FPWRAP_SUCCESS);
+        }
+
+        work->status[i] = status;
+    }
+
+    arb_clear(arb_x);
+    arb_clear(arb_res);
+}
+
+static int
+_arb_fpwrap_double_1_vec(double * res, int * status, arb_fast_func_1 fast, arb_func_1 func, const double * x, slong n, int flags)
+{
+    double_1_vec_work_t work;
+    slong i, num_chunks;
+    int result;
+
+    if (n <= 0)
+        return FPWRAP_SUCCESS;
+
+    work.res = res;
+    work.status = (status != NULL) ? status : flint_malloc(sizeof(int) * n);
+    work.fast = fast;
+    work.func = func;
+    work.x = x;
+    work.n = n;
+    work.flags = flags;
+
+    num_chunks = (n + VEC_CHUNK - 1) / VEC_CHUNK;
+
+    if (num_chunks == 1 || flint_get_num_threads() == 1)
+    {
+        for (i = 0; i < num_chunks; i++)
+            _arb_fpwrap_double_1_vec_worker(i, &work);
+    }
+    else
+    {
+        flint_parallel_do(_arb_fpwrap_double_1_vec_worker, &work,
+            num_chunks, -1, FLINT_PARALLEL_DYNAMIC);
+    }
+
+    result = FPWRAP_SUCCESS;
+    for (i = 0; i < n; i++)
+        result |= work.status[i];
+
+    if (status == NULL)
+        flint_free(work.status);
+
+    return result;
+}
+
+int arb_fpwrap_double_1_vec(double * res, int * status, arb_func_1 func, const double * x, slong n, int flags)
+{
+    return _arb_fpwrap_double_1_vec(res, status, NULL, func, x, n, flags);
+}
+
 int arb_fpwrap_double_2(double * res, arb_func_2 func, double x1, double x2, int flags)
 {
     arb_t arb_res, arb_x1, arb_x2;
@@ -766,6 +892,24 @@ int arb_fpwrap_cdouble_4_int(complex_double * res, acb_func_4_int func, complex_
     { \
         return arb_fpwrap_double_1(res, arb_fun, x, flags); \
     } \
+    int arb_fpwrap_double_ ## name ## _vec(double * res, int * status, const double * x, slong n, int flags) \
+    { \
+        return arb_fpwrap_double_1_vec(res, status, arb_fun, x, n, flags); \
+    } \
+
+/* Tries a certified double-double evaluation before falling back
+   to ball arithmetic. */
+#define DEF_DOUBLE_FUN_1_FAST(name, arb_fun) \
+    int arb_fpwrap_double_ ## name(double * res, double x, int flags) \
+    { \
+        if (_arb_fpwrap_double_ ## name ## _fast(res, x, flags)) \
+            return FPWRAP_SUCCESS; \
+        return arb_fpwrap_double_1(res, arb_fun, x, flags); \
+    } \
+    int arb_fpwrap_double_ ## name ## _vec(double * res, int * status, const double * x, slong n, int flags) \
+    { \
+        return _arb_fpwrap_double_1_vec(res, status, _arb_fpwrap_double_ ## name ## _fast, arb_fun, x, n, flags); \
+    } \
 
 #define DEF_DOUBLE_FUN_2(name, arb_fun) \
     int arb_fpwrap_double_ ## name(double * res, double x1, double x2, int flags) \
@@ -857,13 +1001,13 @@ int arb_fpwrap_cdouble_4_int(complex_double * res, acb_func_4_int func, complex_
         return arb_fpwrap_cdouble_4_int(res, acb_fun, x1, x2, x3, x4, intx, flags); \
     } \
 
-DEF_DOUBLE_FUN_1(exp, arb_exp)
+DEF_DOUBLE_FUN_1_FAST(exp, arb_exp)
 DEF_CDOUBLE_FUN_1(exp, acb_exp)
 
 DEF_DOUBLE_FUN_1(expm1, arb_expm1)
 DEF_CDOUBLE_FUN_1(expm1, acb_expm1)
 
-DEF_DOUBLE_FUN_1(log, arb_log)
+DEF_DOUBLE_FUN_1_FAST(log, arb_log)
 DEF_CDOUBLE_FUN_1(log, acb_log)
 
 DEF_DOUBLE_FUN_1(log1p, arb_log1p)
@@ -884,10 +1028,10 @@ static void _acb_cbrt(acb_t res, const acb_t x, slong prec) { acb_root_ui(res, x
 DEF_DOUBLE_FUN_1(cbrt, _arb_cbrt)
 DEF_CDOUBLE_FUN_1(cbrt, _acb_cbrt)
 
-DEF_DOUBLE_FUN_1(sin, arb_sin)
+DEF_DOUBLE_FUN_1_FAST(sin, arb_sin)
 DEF_CDOUBLE_FUN_1(sin, acb_sin)
 
-DEF_DOUBLE_FUN_1(cos, arb_cos)
+DEF_DOUBLE_FUN_1_FAST(cos, arb_cos)
 DEF_CDOUBLE_FUN_1(cos, acb_cos)
 
 DEF_DOUBLE_FUN_1(tan, arb_tan)
@@ -1029,7 +1173,7 @@ DEF_DOUBLE_FUN_1(dilog, arb_hypgeom_dilog)
 DEF_CDOUBLE_FUN_1(dilog, acb_hypgeom_dilog)
 
 
-DEF_DOUBLE_FUN_1(erf, arb_hypgeom_erf)
+DEF_DOUBLE_FUN_1_FAST(erf, arb_hypgeom_erf)
 DEF_CDOUBLE_FUN_1(erf, acb_hypgeom_erf)
 
 DEF_DOUBLE_FUN_1(erfc, arb_hypgeom_erfc)
@@ -88,6 +88,162 @@ int main()
         mpfr_clear(t);
     }
 
+    /* double-double fast path */
+    for (iter = 0; iter < 100000 * arb_test_multiplier(); iter++)
+    {
+        mpfr_t t;
+        double x, y, z;
+        int flags, ok;
+
+        mpfr_init2(t, 53);
+
+        x = d_randtest(state);
+        if (n_randint(state, 2))
+            x = ldexp(x, n_randint(state, 24) - 4);
+        if (n_randint(state, 2))
+            x = -x;
+
+        flags = n_randint(state, 2) ? FPWRAP_CORRECT_ROUNDING : 0;
+
+        switch (n_randint(state, 5))
+        {
+            case 0:
+                ok = _arb_fpwrap_double_exp_fast(&y, x, flags);
+                mpfr_set_d(t, x, MPFR_RNDN);
+                mpfr_exp(t, t, MPFR_RNDN);
+                break;
+            case 1:
+                x = fabs(x);
+                ok = _arb_fpwrap_double_log_fast(&y, x, flags);
+                mpfr_set_d(t, x, MPFR_RNDN);
+                mpfr_log(t, t, MPFR_RNDN);
+                break;
+            case 2:
+                ok = _arb_fpwrap_double_sin_fast(&y, x, flags);
+                mpfr_set_d(t, x, MPFR_RNDN);
+                mpfr_sin(t, t, MPFR_RNDN);
+                break;
+            case 3:
+                ok = _arb_fpwrap_double_cos_fast(&y, x, flags);
+                mpfr_set_d(t, x, MPFR_RNDN);
+                mpfr_cos(t, t, MPFR_RNDN);
+                break;
+            default:
+                ok = _arb_fpwrap_double_erf_fast(&y, x, flags);
+                mpfr_set_d(t, x, MPFR_RNDN);
+                mpfr_erf(t, t, MPFR_RNDN);
+                break;
+        }
+
+        z = mpfr_get_d(t, MPFR_RNDN);
+
+        if (ok && ((flags & FPWRAP_CORRECT_ROUNDING) ? (y != z) :
+                (fabs(y - z) > ldexp(fabs(z), -52))))
+        {
+            flint_printf("FAIL: fast path\n\n");
+            flint_printf("flags = %d, x = %.17g, y = %.17g, z = %.17g\n", flags, x, y, z);
+            flint_abort();
+        }
+
+        mpfr_clear(t);
+    }
+
+    /* vector functions agree with scalar functions */
+    for (iter = 0; iter < 100 * arb_test_multiplier(); iter++)
+    {
+        double *x, *y;
+        int *status;
+        slong i, n;
+        int flags, vec_fail, fail, st;
+        double z;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        n = n_randint(state, 300);
+        flags = n_randint(state, 2) ? FPWRAP_CORRECT_ROUNDING : 0;
+
+        x = flint_malloc(sizeof(double) * (n + 1));
+        y = flint_malloc(sizeof(double) * (n + 1));
+        status = flint_malloc(sizeof(int) * (n + 1));
+
+        for (i = 0; i < n; i++)
+        {
+            x[i] = d_randtest(state) * n_randint(state, 100);
+
+            /* include some points where evaluation fails */
+            if (n_randint(state, 20) == 0)
+                x[i] = -1.0;
+        }
+
+        /* the status vector is optional */
+        if (n_randint(state, 2))
+            arb_fpwrap_double_lgamma_vec(y, NULL, x, n, flags);
+
+        vec_fail = arb_fpwrap_double_lgamma_vec(y, status, x, n, flags);
+
+        fail = 0;
+        for (i = 0; i < n; i++)
+        {
+            st = arb_fpwrap_double_lgamma(&z, x[i], flags);
+            fail |= st;
+
+            if (status[i] != st || (st == FPWRAP_SUCCESS && z != y[i]))
+            {
+                flint_printf("FAIL: vector function\n\n");
+                flint_printf("n = %wd, i = %wd, x = %.17g, y = %.17g, z = %.17g\n",
+                    n, i, x[i], y[i], z);
+                flint_abort();
+            }
+        }
+
+        if (fail != vec_fail)
+        {
+            flint_printf("FAIL: vector function status\n\n");
+            flint_abort();
+        }
+
+        flint_free(x);
+        flint_free(y);
+        flint_free(status);
+    }
+
+    /* learned starting precision gives the same correctly rounded values */
+    {
+        slong lookups, hits, restarts, avoided;
+        double x, y, z;
+        int st1, st2;
+
+        arb_fpwrap_wp_cache_clear();
+
+        for (iter = 0; iter < 1000 * arb_test_multiplier(); iter++)
+        {
+            /* lgamma has zeros at 1 and 2 */
+            x = 1.0 + n_randint(state, 2) + ldexp(d_randtest(state), -20 - n_randint(state, 20));
+
+            st1 = arb_fpwrap_double_lgamma(&y, x, FPWRAP_CORRECT_ROUNDING | FPWRAP_LEARN_PRECISION);
+            st2 = arb_fpwrap_double_lgamma(&z, x, FPWRAP_CORRECT_ROUNDING);
+
+            if (st1 != st2 || (st1 == FPWRAP_SUCCESS && y != z))
+            {
+                flint_printf("FAIL: learned precision\n\n");
+                flint_printf("x = %.17g, y = %.17g, z = %.17g\n", x, y, z);
+                flint_abort();
+            }
+        }
+
+        arb_fpwrap_wp_cache_stats(&lookups, &hits, &restarts, &avoided);
+
+        if (lookups != 1000 * arb_test_multiplier() || hits == 0 || avoided == 0)
+        {
+            flint_printf("FAIL: learned precision statistics\n\n");
+            flint_printf("lookups = %wd, hits = %wd, restarts = %wd, avoided = %wd\n",
+                lookups, hits, restarts, avoided);
+            flint_abort();
+        }
+
+        arb_fpwrap_wp_cache_clear();
+    }
+
     {
         double a[1], b[2];
         double z, y;
@@ -0,0 +1,165 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include "arb_fpwrap.h"
+
+/*
+  Thread-local memory of the working precision that was needed to
+  evaluate a function on a region of input values. A region is given
+  by the sign, the exponent and the four leading mantissa bits of the
+  input, so that, e.g., the neighborhoods of 1 and 2 where lgamma
+  has zeros are recorded separately from the rest of [1, 4).
+
+  The table is direct-mapped; colliding entries simply replace
+  each other. A learned precision is lowered by one level after
+  WP_CACHE_DECAY successful uses so that it does not stay high forever
+  after a single difficult input.
+*/
+
+#define WP_CACHE_SIZE 256
+#define WP_CACHE_DECAY 32
+#define WP_INITIAL 64
+
+typedef struct
+{
+    _arb_fpwrap_func_t func;
+    slong region;
+    slong wp;
+    slong uses;
+}
+wp_cache_entry;
+
+static TLS_PREFIX wp_cache_entry wp_cache[WP_CACHE_SIZE];
+
+static TLS_PREFIX slong wp_cache_lookups = 0;
+static TLS_PREFIX slong wp_cache_hits = 0;
+static TLS_PREFIX slong wp_cache_restarts = 0;
+static TLS_PREFIX slong wp_cache_restarts_avoided = 0;
+
+static slong
+_wp_region(double x)
+{
+    double m;
+    int e;
+
+    if (x == 0.0 || x != x)
+        return 0;
+
+    m = frexp(fabs(x), &e);
+    e = FLINT_MAX(e, -256);
+    e = FLINT_MIN(e, 256);
+
+    return ((e + 512) * 16 + (slong) (m * 32.0 - 16.0)) * 2 + (x < 0.0);
+}
+
+static wp_cache_entry *
+_wp_cache_entry(_arb_fpwrap_func_t func, slong region)
+{
+    ulong h;
+
+    h = 0;
+    memcpy(&h, &func, FLINT_MIN(sizeof(h), sizeof(func)));
+    h = (h >> 4) * UWORD(0x9e3779b97f4a7c15) + (ulong) region * UWORD(0x2545f491);
+    h ^= h >> 23;
+
+    return wp_cache + (h % WP_CACHE_SIZE);
+}
+
+slong
+_arb_fpwrap_wp_cache_start(_arb_fpwrap_func_t func, double x, slong wp_max)
+{
+    wp_cache_entry * entry;
+    slong region;
+
+    region = _wp_region(x);
+    entry = _wp_cache_entry(func, region);
+
+    wp_cache_lookups++;
+
+    if (entry->func == func && entry->region == region && entry->wp > WP_INITIAL)
+    {
+        wp_cache_hits++;
+        return FLINT_MIN(entry->wp, wp_max);
+    }
+
+    return WP_INITIAL;
+}
+
+void
+_arb_fpwrap_wp_cache_update(_arb_fpwrap_func_t func, double x,
+    slong wp_start, slong wp_final, int success)
+{
+    wp_cache_entry * entry;
+    slong region, w;
+
+    for (w = wp_start; w < wp_final; w *= 2)
+        wp_cache_restarts++;
+
+    if (!success)
+        return;
+
+    for (w = WP_INITIAL; w < FLINT_MIN(wp_start, wp_final); w *= 2)
+        wp_cache_restarts_avoided++;
+
+    region = _wp_region(x);
+    entry = _wp_cache_entry(func, region);
+
+    if (entry->func == func && entry->region == region)
+    {
+        if (wp_final > entry->wp)
+        {
+            entry->wp = wp_final;
+            entry->uses = 0;
+        }
+        else if (++entry->uses >= WP_CACHE_DECAY)
+        {
+            entry->wp = FLINT_MAX(entry->wp / 2, WP_INITIAL);
+            entry->uses = 0;
+        }
+    }
+    else if (wp_final > WP_INITIAL)
+    {
+        entry->func = func;
+        entry->region = region;
+        entry->wp = wp_final;
+        entry->uses = 0;
+    }
+}
+
+void
+arb_fpwrap_wp_cache_clear(void)
+{
+    slong i;
+
+    for (i = 0; i < WP_CACHE_SIZE; i++)
+    {
+        wp_cache[i].func = NULL;
+        wp_cache[i].region = 0;
+        wp_cache[i].wp = 0;
+        wp_cache[i].uses = 0;
+    }
+
+    wp_cache_lookups = 0;
+    wp_cache_hits = 0;
+    wp_cache_restarts = 0;
+    wp_cache_restarts_avoided = 0;
+}
+
+void
+arb_fpwrap_wp_cache_stats(slong * lookups, slong * hits,
+    slong * restarts, slong * restarts_avoided)
+{
+    *lookups = wp_cache_lookups;
+    *hits = wp_cache_hits;
+    *restarts = wp_cache_restarts;
+    *restarts_avoided = wp_cache_restarts_avoided;
+}
@@ -184,7 +184,10 @@ void arb_hypgeom_legendre_p_ui_one(arb_t res, arb_t res2, ulong n, const arb_t x
 void arb_hypgeom_legendre_p_ui_zero(arb_t res, arb_t res2, ulong n, const arb_t x, slong K, slong prec);
 void arb_hypgeom_legendre_p_ui(arb_t res, arb_t res_prime, ulong n, const arb_t x, slong prec);
 
+void arb_hypgeom_legendre_p_ui_root_initial(arb_t res, ulong n, ulong k, slong prec);
 void arb_hypgeom_legendre_p_ui_root(arb_t res, arb_t weight, ulong n, ulong k, slong prec);
+void _arb_hypgeom_legendre_p_ui_roots_vec(arb_ptr res, arb_ptr weights, ulong n, slong prec);
+void arb_hypgeom_legendre_p_ui_roots_vec(arb_ptr res, arb_ptr weights, ulong n, slong prec);
 
 void arb_hypgeom_central_bin_ui(arb_t res, ulong n, slong prec);
 
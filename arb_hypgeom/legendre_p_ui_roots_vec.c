@@ -0,0 +1,219 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_hypgeom.h"
+
+typedef struct
+{
+    arb_ptr res;
+    arb_ptr weights;
+    ulong n;
+    const slong * steps;
+    slong num_steps;
+    slong padding;
+    slong prec;
+}
+roots_work_t;
+
+/* Same algorithm as arb_hypgeom_legendre_p_ui_root, except that the
+   weight is computed from P(m), P'(m) at the midpoint m used in the
+   final Newton step instead of evaluating P'(x) once more at full
+   precision. With x - m = O(2^(-prec/2)), a first-order Taylor
+   expansion of P' about m is accurate to full precision, and P''(m)
+   is given by the differential equation. */
+static void
+roots_worker(slong k, roots_work_t * work)
+{
+    arb_ptr x;
+    arb_t t, u, v, p, dp;
+    mag_t err, pb, p2b, p3b;
+    ulong n;
+    slong step, wp, prec, padding;
+    int have_deriv;
+
+    x = work->res + k;
+    n = work->n;
+    prec = work->prec;
+    padding = work->padding;
+    have_deriv = 0;
+
+    arb_init(t);
+    arb_init(u);
+    arb_init(v);
+    arb_init(p);
+    arb_init(dp);
+    mag_init(err);
+    mag_init(pb);
+    mag_init(p2b);
+    mag_init(p3b);
+
+    if (n % 2 == 1 && k == n / 2)
+    {
+        arb_zero(x);
+    }
+    else if (work->num_steps == 0)
+    {
+        arb_hypgeom_legendre_p_ui_root_initial(x, n, k, prec + padding);
+    }
+    else
+    {
+        step = work->num_steps - 1;
+        wp = work->steps[step] + padding;
+        arb_hypgeom_legendre_p_ui_root_initial(x, n, k, wp);
+        step--;
+
+        arb_mul(t, x, x, wp);
+        arb_sub_ui(t, t, 1, wp);
+        arb_hypgeom_legendre_p_ui_deriv_bound(pb, p2b, n, x, t);
+
+        /* (1-x^2) P''' = 4x P'' - (n(n+1)-2) P' gives a bound for P''' */
+        if (work->weights != NULL)
+        {
+            mag_mul_ui(p3b, pb, n);
+            mag_mul_ui(p3b, p3b, n + 1);
+            mag_mul_2exp_si(err, p2b, 2);
+            mag_add(p3b, p3b, err);
+            arb_get_mag_lower(err, t);
+            mag_div(p3b, p3b, err);
+        }
+
+        for ( ; step >= 0; step--)
+        {
+            wp = work->steps[step] + padding;
+
+            /* Interval Newton update, as in arb_hypgeom_legendre_p_ui_root */
+            arb_set(v, x);
+            mag_mul(err, p2b, arb_radref(v));
+            mag_zero(arb_radref(v));
+            arb_hypgeom_legendre_p_ui(p, dp, n, v, wp);
+            arb_set(u, dp);
+            arb_add_error_mag(u, err);
+            arb_div(t, p, u, wp);
+            arb_sub(t, v, t, wp);
+
+            if (mag_cmp(arb_radref(t), arb_radref(x)) >= 0)
+                break;
+
+            arb_swap(x, t);
+            have_deriv = (step == 0);
+        }
+    }
+
+    if (work->weights != NULL)
+    {
+        wp = FLINT_MAX(prec, 40) + padding;
+
+        if (have_deriv && mag_is_finite(p3b))
+        {
+            /* P''(m) = (2m P'(m) - n(n+1) P(m)) / (1-m^2) */
+            arb_mul(t, v, dp, wp);
+            arb_mul_2exp_si(t, t, 1);
+            arb_mul_ui(u, p, n, wp);
+            arb_mul_ui(u, u, n + 1, wp);
+            arb_sub(t, t, u, wp);
+            arb_mul(u, v, v, wp);
+            arb_sub_ui(u, u, 1, wp);
+            arb_div(t, t, u, wp);
+            arb_neg(t, t);
+
+            /* P'(x) = P'(m) + P''(m) (x-m) + R, |R| <= p3b |x-m|^2 / 2 */
+            arb_sub(u, x, v, wp);
+            arb_get_mag(err, u);
+            mag_mul(err, err, err);
+            mag_mul(err, err, p3b);
+            mag_mul_2exp_si(err, err, -1);
+            arb_mul(t, t, u, wp);
+            arb_add(t, t, dp, wp);
+            arb_add_error_mag(t, err);
+        }
+        else
+        {
+            arb_hypgeom_legendre_p_ui(NULL, t, n, x, wp);
+        }
+
+        arb_mul(t, t, t, wp);
+        arb_mul(u, x, x, wp);
+        arb_sub_ui(u, u, 1, wp);
+        arb_neg(u, u);
+        arb_mul(t, t, u, wp);
+        arb_ui_div(work->weights + k, 2, t, prec);
+    }
+
+    arb_set_round(x, x, prec);
+
+    arb_clear(t);
+    arb_clear(u);
+    arb_clear(v);
+    arb_clear(p);
+    arb_clear(dp);
+    mag_clear(err);
+    mag_clear(pb);
+    mag_clear(p2b);
+    mag_clear(p3b);
+}
+
+void
+_arb_hypgeom_legendre_p_ui_roots_vec(arb_ptr res, arb_ptr weights, ulong n, slong prec)
+{
+    roots_work_t work;
+    slong steps[FLINT_BITS];
+    slong padding, initial_prec, step;
+
+    if (n == 0)
+        return;
+
+    /* The precision schedule only depends on n and prec, so it is
+       shared by all roots. */
+    padding = 8 + 2 * FLINT_BIT_COUNT(n);
+    initial_prec = 40 + padding;
+    step = 0;
+
+    if (initial_prec <= prec / 2)
+    {
+        steps[0] = prec + padding;
+
+        while (step < FLINT_BITS - 1 && (steps[step] / 2) > initial_prec)
+        {
+            steps[step + 1] = (steps[step] / 2);
+            step++;
+        }
+
+        step++;
+    }
+
+    work.res = res;
+    work.weights = weights;
+    work.n = n;
+    work.steps = steps;
+    work.num_steps = step;
+    work.padding = padding;
+    work.prec = prec;
+
+    /* the cost per root is uneven (roots close to +/- 1 use different
+       evaluation algorithms), so distribute them dynamically */
+    flint_parallel_do((do_func_t) roots_worker, &work, (n + 1) / 2, -1, FLINT_PARALLEL_DYNAMIC);
+}
+
+void
+arb_hypgeom_legendre_p_ui_roots_vec(arb_ptr res, arb_ptr weights, ulong n, slong prec)
+{
+    ulong k;
+
+    _arb_hypgeom_legendre_p_ui_roots_vec(res, weights, n, prec);
+
+    for (k = (n + 1) / 2; k < n; k++)
+    {
+        arb_neg(res + k, res + n - 1 - k);
+
+        if (weights != NULL)
+            arb_set(weights + k, weights + n - 1 - k);
+    }
+}
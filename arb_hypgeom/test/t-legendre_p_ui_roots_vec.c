@@ -0,0 +1,104 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_hypgeom.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("legendre_p_ui_roots_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 200 * arb_test_multiplier(); iter++)
+    {
+        arb_ptr x1, w1;
+        arb_t x2, w2, s;
+        ulong n, k;
+        slong prec;
+        int with_weights;
+
+        if (n_randint(state, 4) == 0)
+            n = 1 + n_randint(state, 2000);
+        else
+            n = 1 + n_randint(state, 100);
+
+        prec = 2 + n_randint(state, 1000);
+        with_weights = n_randint(state, 4) != 0;
+
+        x1 = _arb_vec_init(n);
+        w1 = _arb_vec_init(n);
+        arb_init(x2);
+        arb_init(w2);
+        arb_init(s);
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        arb_hypgeom_legendre_p_ui_roots_vec(x1, with_weights ? w1 : NULL, n, prec);
+
+        for (k = 0; k < n; k++)
+        {
+            if (n > 100 && n_randint(state, 10) != 0)
+                continue;
+
+            arb_hypgeom_legendre_p_ui_root(x2, w2, n, k, prec);
+
+            if (!arb_overlaps(x1 + k, x2) || (with_weights && !arb_overlaps(w1 + k, w2)))
+            {
+                flint_printf("FAIL: overlap\n\n");
+                flint_printf("n = %wu, k = %wu, prec = %wd\n\n", n, k, prec);
+                flint_printf("x1 = "); arb_printn(x1 + k, 100, 0); flint_printf("\n\n");
+                flint_printf("x2 = "); arb_printn(x2, 100, 0); flint_printf("\n\n");
+                flint_printf("w1 = "); arb_printn(w1 + k, 100, 0); flint_printf("\n\n");
+                flint_printf("w2 = "); arb_printn(w2, 100, 0); flint_printf("\n\n");
+                flint_abort();
+            }
+
+            if (arb_rel_accuracy_bits(x1 + k) < prec - 3 ||
+                (with_weights && arb_rel_accuracy_bits(w1 + k) < prec - 3))
+            {
+                flint_printf("FAIL: accuracy\n\n");
+                flint_printf("n = %wu, k = %wu, prec = %wd\n\n", n, k, prec);
+                flint_printf("acc(x1) = %wd, acc(w1) = %wd\n\n",
+                    arb_rel_accuracy_bits(x1 + k), arb_rel_accuracy_bits(w1 + k));
+                flint_abort();
+            }
+        }
+
+        if (with_weights)
+        {
+            for (k = 0; k < n; k++)
+                arb_add(s, s, w1 + k, prec);
+
+            if (!arb_contains_si(s, 2))
+            {
+                flint_printf("FAIL: sum of weights\n\n");
+                flint_printf("n = %wu, prec = %wd\n\n", n, prec);
+                flint_printf("s = "); arb_printn(s, 30, 0); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        _arb_vec_clear(x1, n);
+        _arb_vec_clear(w1, n);
+        arb_clear(x2);
+        arb_clear(w2);
+        arb_clear(s);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
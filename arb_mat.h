@@ -24,6 +24,7 @@
 #include "flint/perm.h"
 #include "arb.h"
 #include "arb_poly.h"
+#include "arb_soa.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -211,10 +212,17 @@ void arb_mat_mul(arb_mat_t res, const arb_mat_t mat1, const arb_mat_t mat2, slon
 
 void arb_mat_mul_classical(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong prec);
 
+void arb_mat_mul_tiled(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong prec);
+
 void arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong prec);
 
+void _arb_mat_mul_threaded_tiling(slong * tile_rows, slong * tile_cols, slong ar, slong bc, slong num_threads);
+
 void _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B, slong ar, slong ac, slong bc);
 
+void _arb_mat_addmul_rad_soa(arb_mat_t C, const uint32_t * Aman, const slong * Aexp,
+    const uint32_t * Bman, const slong * Bexp, slong ar, slong ac, slong bc);
+
 void arb_mat_mul_block(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong prec);
 
 void arb_mat_mul_entrywise(arb_mat_t res, const arb_mat_t mat1, const arb_mat_t mat2, slong prec);
@@ -83,23 +83,17 @@ _d_mat_addmul(double * C, const double * A, const double * B, slong ar, slong ac
 }
 
 /* We use WORD_MIN to represent zero here. */
-static __inline__ slong _mag_get_exp(const mag_t x)
-{
-    if (mag_is_special(x))
-        return WORD_MIN;
-    else
-        return MAG_EXP(x);
-}
+#define SOA_GET_EXP(man, exp, i) (((man)[i] == 0) ? WORD_MIN : (exp)[i])
 
 static double
-mag_get_d_fixed_si(const mag_t x, slong e)
+soa_get_d_fixed_si(uint32_t man, slong exp, slong e)
 {
-    return ldexp(MAG_MAN(x), MAG_EXP(x) - e - MAG_BITS);
+    return ldexp(man, exp - e - MAG_BITS);
 }
 
 void
-_arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
-    slong ar, slong ac, slong bc)
+_arb_mat_addmul_rad_soa(arb_mat_t C, const uint32_t * Aman, const slong * Aexp,
+    const uint32_t * Bman, const slong * Bexp, slong ar, slong ac, slong bc)
 {
     slong i, j, k, M, N, P, top, n, block_start, block_end;
     slong *A_min, *A_max, *B_min, *B_max, max_offset;
@@ -128,16 +122,16 @@ _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
 
         /* begin with this column of A and row of B */
         for (i = 0; i < M; i++)
-            A_max[i] = A_min[i] = _mag_get_exp(A + i * N + block_start);
+            A_max[i] = A_min[i] = SOA_GET_EXP(Aman, Aexp, i * N + block_start);
         for (i = 0; i < P; i++)
-            B_max[i] = B_min[i] = _mag_get_exp(B + i * N + block_start);
+            B_max[i] = B_min[i] = SOA_GET_EXP(Bman, Bexp, i * N + block_start);
 
         while (block_end < N)
         {
             /* check if we can extend with column [block_end] of A */
             for (i = 0; i < M; i++)
             {
-                top = _mag_get_exp(A + i * N + block_end);
+                top = SOA_GET_EXP(Aman, Aexp, i * N + block_end);
                 /* zeros are irrelevant */
                 if (top == WORD_MIN || A_max[i] == WORD_MIN)
                     continue;
@@ -149,7 +143,7 @@ _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
             /* check if we can extend with row [block_end] of B */
             for (i = 0; i < P; i++)
             {
-                top = _mag_get_exp(B + i * N + block_end);
+                top = SOA_GET_EXP(Bman, Bexp, i * N + block_end);
                 if (top == WORD_MIN || B_max[i] == WORD_MIN)
                     continue;
                 if (top > B_min[i] + max_offset || top < B_max[i] - max_offset)
@@ -159,7 +153,7 @@ _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
             /* second pass to update the extreme values */
             for (i = 0; i < M; i++)
             {
-                top = _mag_get_exp(A + i * N + block_end);
+                top = SOA_GET_EXP(Aman, Aexp, i * N + block_end);
                 if (A_max[i] == WORD_MIN)
                 {
                     A_max[i] = top;
@@ -174,7 +168,7 @@ _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
 
             for (i = 0; i < P; i++)
             {
-                top = _mag_get_exp(B + i * N + block_end);
+                top = SOA_GET_EXP(Bman, Bexp, i * N + block_end);
                 if (B_max[i] == WORD_MIN)
                 {
                     B_max[i] = top;
@@ -196,22 +190,28 @@ _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
 
         if (n <= MIN_D_BLOCK_SIZE)
         {
+            mag_t t;
+
             /* increment so we don't just do steps of 1 in degenerate cases */
             block_end = FLINT_MIN(block_start + MIN_D_BLOCK_SIZE, N);
             n = block_end - block_start;
 
+            mag_init(t);
+
             for (i = 0; i < ar; i++)
             {
                 for (j = 0; j < bc; j++)
                 {
-                    for (k = 0; k < n; k++)
-                    {
-                        mag_fast_addmul(arb_radref(arb_mat_entry(C, i, j)),
-                            A + i * ac + block_start + k,
-                            B + j * ac + block_start + k);
-                    }
+                    _arb_soa_rad_dot(t,
+                        Aman + i * ac + block_start, Aexp + i * ac + block_start,
+                        Bman + j * ac + block_start, Bexp + j * ac + block_start, n);
+
+                    mag_add(arb_radref(arb_mat_entry(C, i, j)),
+                            arb_radref(arb_mat_entry(C, i, j)), t);
                 }
             }
+
+            mag_clear(t);
         }
         else
         {
@@ -223,7 +223,8 @@ _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
                 A_min[i] = (A_min[i] + A_max[i]) / 2;
 
                 for (j = 0; j < n; j++)
-                    AA[i * n + j] = mag_get_d_fixed_si(A + i * ac + block_start + j, A_min[i]);
+                    AA[i * n + j] = soa_get_d_fixed_si(Aman[i * ac + block_start + j],
+                        Aexp[i * ac + block_start + j], A_min[i]);
             }
 
             /* Note: B and BB are both transposed in memory */
@@ -235,7 +236,8 @@ _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
                 B_min[i] = (B_min[i] + B_max[i]) / 2;
 
                 for (j = 0; j < n; j++)
-                    BB[i * n + j] = mag_get_d_fixed_si(B + i * ac + block_start + j, B_min[i]);
+                    BB[i * n + j] = soa_get_d_fixed_si(Bman[i * ac + block_start + j],
+                        Bexp[i * ac + block_start + j], B_min[i]);
             }
 
             for (i = 0; i < ar * bc; i++)
@@ -277,3 +279,28 @@ _arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
     flint_free(CC);
 }
 
+void
+_arb_mat_addmul_rad_mag_fast(arb_mat_t C, mag_srcptr A, mag_srcptr B,
+    slong ar, slong ac, slong bc)
+{
+    uint32_t *Aman, *Bman;
+    slong *Aexp, *Bexp;
+    slong i;
+
+    Aman = flint_malloc(ar * ac * sizeof(uint32_t));
+    Bman = flint_malloc(ac * bc * sizeof(uint32_t));
+    Aexp = flint_malloc(ar * ac * sizeof(slong));
+    Bexp = flint_malloc(ac * bc * sizeof(slong));
+
+    for (i = 0; i < ar * ac; i++)
+        _arb_soa_rad_set_mag(Aman + i, Aexp + i, A + i);
+    for (i = 0; i < ac * bc; i++)
+        _arb_soa_rad_set_mag(Bman + i, Bexp + i, B + i);
+
+    _arb_mat_addmul_rad_soa(C, Aman, Aexp, Bman, Bexp, ar, ac, bc);
+
+    flint_free(Aman);
+    flint_free(Bman);
+    flint_free(Aexp);
+    flint_free(Bexp);
+}
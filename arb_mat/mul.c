@@ -35,6 +35,12 @@ arb_mat_mul(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong prec)
         {
             arb_mat_mul_threaded(C, A, B, prec);
         }
+        else if (prec <= 8 * FLINT_BITS &&
+            arb_mat_nrows(A) >= 20 && arb_mat_ncols(A) >= 20 &&
+            arb_mat_ncols(B) >= 20)
+        {
+            arb_mat_mul_tiled(C, A, B, prec);
+        }
         else
         {
             arb_mat_mul_classical(C, A, B, prec);
@@ -469,81 +469,94 @@ arb_mat_mul_block(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong prec)
     /* Radius multiplications */
     if (!A_exact || !B_exact)
     {
-        mag_ptr AA, BB;
+        uint32_t *AAman, *BBman, *Tman;
+        slong *AAexp, *BBexp, *Texp;
 
-        /* Shallow (since exponents are small!) mag_struct matrices
-           represented by linear arrays; B is transposed to improve locality. */
-        AA = flint_malloc(M * N * sizeof(mag_struct));
-        BB = flint_malloc(P * N * sizeof(mag_struct));
+        /* Radius matrices in SoA form (the exponents are small, since
+           we have checked that the entries are lagom), represented by
+           linear arrays; B is transposed to improve locality. */
+        AAman = flint_malloc(M * N * sizeof(uint32_t));
+        AAexp = flint_malloc(M * N * sizeof(slong));
+        BBman = flint_malloc(P * N * sizeof(uint32_t));
+        BBexp = flint_malloc(P * N * sizeof(slong));
 
         if (!A_exact && !B_exact)
         {
             /* (A+ar)(B+br) = AB + (A+ar)br + ar B
                             = AB + A br + ar (B + br) */
 
+            Tman = flint_malloc(N * sizeof(uint32_t));
+            Texp = flint_malloc(N * sizeof(slong));
+
             /* A + ar */
             for (i = 0; i < M; i++)
-                for (j = 0; j < N; j++)
-                {
-                    mag_fast_init_set_arf(AA + i * N + j,
-                        arb_midref(arb_mat_entry(A, i, j)));
-                    mag_add(AA + i * N + j, AA + i * N + j,
-                        arb_radref(arb_mat_entry(A, i, j)));
-                }
+            {
+                _arb_soa_rad_set_arb_mid(AAman + i * N, AAexp + i * N,
+                    arb_mat_entry(A, i, 0), N);
+                _arb_soa_rad_set_arb_rad(Tman, Texp, arb_mat_entry(A, i, 0), N);
+                _arb_soa_rad_add(AAman + i * N, AAexp + i * N,
+                    AAman + i * N, AAexp + i * N, Tman, Texp, N);
+            }
 
             /* br */
             for (i = 0; i < N; i++)
                 for (j = 0; j < P; j++)
-                    BB[j * N + i] = *arb_radref(arb_mat_entry(B, i, j));
+                    _arb_soa_rad_set_mag(BBman + j * N + i, BBexp + j * N + i,
+                        arb_radref(arb_mat_entry(B, i, j)));
 
-            _arb_mat_addmul_rad_mag_fast(C, AA, BB, M, N, P);
+            _arb_mat_addmul_rad_soa(C, AAman, AAexp, BBman, BBexp, M, N, P);
 
             /* ar */
             for (i = 0; i < M; i++)
-                for (j = 0; j < N; j++)
-                    AA[i * N + j] = *arb_radref(arb_mat_entry(A, i, j));
+                _arb_soa_rad_set_arb_rad(AAman + i * N, AAexp + i * N,
+                    arb_mat_entry(A, i, 0), N);
 
             /* B */
             for (i = 0; i < N; i++)
                 for (j = 0; j < P; j++)
-                    mag_fast_init_set_arf(BB + j * N + i,
+                    _arb_soa_rad_set_arf(BBman + j * N + i, BBexp + j * N + i,
                         arb_midref(arb_mat_entry(B, i, j)));
 
-            _arb_mat_addmul_rad_mag_fast(C, AA, BB, M, N, P);
+            _arb_mat_addmul_rad_soa(C, AAman, AAexp, BBman, BBexp, M, N, P);
+
+            flint_free(Tman);
+            flint_free(Texp);
         }
         else if (A_exact)
         {
             /* A(B+br) = AB + A br */
 
             for (i = 0; i < M; i++)
-                for (j = 0; j < N; j++)
-                    mag_fast_init_set_arf(AA + i * N + j,
-                        arb_midref(arb_mat_entry(A, i, j)));
+                _arb_soa_rad_set_arb_mid(AAman + i * N, AAexp + i * N,
+                    arb_mat_entry(A, i, 0), N);
 
             for (i = 0; i < N; i++)
                 for (j = 0; j < P; j++)
-                    BB[j * N + i] = *arb_radref(arb_mat_entry(B, i, j));
+                    _arb_soa_rad_set_mag(BBman + j * N + i, BBexp + j * N + i,
+                        arb_radref(arb_mat_entry(B, i, j)));
 
-            _arb_mat_addmul_rad_mag_fast(C, AA, BB, M, N, P);
+            _arb_mat_addmul_rad_soa(C, AAman, AAexp, BBman, BBexp, M, N, P);
         }
         else
         {
             /* (A+ar)B = AB + ar B */
 
             for (i = 0; i < M; i++)
-                for (j = 0; j < N; j++)
-                    AA[i * N + j] = *arb_radref(arb_mat_entry(A, i, j));
+                _arb_soa_rad_set_arb_rad(AAman + i * N, AAexp + i * N,
+                    arb_mat_entry(A, i, 0), N);
 
             for (i = 0; i < N; i++)
                 for (j = 0; j < P; j++)
-                    mag_fast_init_set_arf(BB + j * N + i,
+                    _arb_soa_rad_set_arf(BBman + j * N + i, BBexp + j * N + i,
                         arb_midref(arb_mat_entry(B, i, j)));
 
-            _arb_mat_addmul_rad_mag_fast(C, AA, BB, M, N, P);
+            _arb_mat_addmul_rad_soa(C, AAman, AAexp, BBman, BBexp, M, N, P);
         }
 
-        flint_free(AA);
-        flint_free(BB);
+        flint_free(AAman);
+        flint_free(AAexp);
+        flint_free(BBman);
+        flint_free(BBexp);
     }
 }
 
@@ -10,60 +10,65 @@
 */
 
 #include "arb_mat.h"
-#include "pthread.h"
+
+/* Maximum side length of an output tile. */
+#define TILE_MAX 64
 
 typedef struct
 {
     arb_ptr * C;
     const arb_ptr * A;
-    const arb_ptr * B;
-    slong ar0;
-    slong ar1;
-    slong bc0;
-    slong bc1;
+    arb_srcptr BT;
+    slong ar;
+    slong bc;
     slong br;
+    slong tile_rows;
+    slong tile_cols;
+    slong num_tile_cols;
     slong prec;
 }
-arb_mat_mul_arg_t;
+arb_mat_mul_work_t;
 
-void *
-_arb_mat_mul_thread(void * arg_ptr)
+static void
+_arb_mat_mul_tile_worker(slong tile, void * _work)
 {
-    arb_mat_mul_arg_t arg = *((arb_mat_mul_arg_t *) arg_ptr);
-    slong i, j, br, bc;
-    arb_ptr tmp;
-    TMP_INIT;
-
-    br = arg.br;
-    bc = arg.bc1 - arg.bc0;
-
-    TMP_START;
-    tmp = TMP_ALLOC(sizeof(arb_struct) * br * bc);
+    arb_mat_mul_work_t work = *((arb_mat_mul_work_t *) _work);
+    slong i, j, i0, i1, j0, j1;
+
+    i0 = (tile / work.num_tile_cols) * work.tile_rows;
+    j0 = (tile % work.num_tile_cols) * work.tile_cols;
+    i1 = FLINT_MIN(i0 + work.tile_rows, work.ar);
+    j1 = FLINT_MIN(j0 + work.tile_cols, work.bc);
+
+    for (i = i0; i < i1; i++)
+        for (j = j0; j < j1; j++)
+            arb_dot(work.C[i] + j, NULL, 0,
+                work.A[i], 1, work.BT + j * work.br, 1, work.br, work.prec);
+}
 
-    for (i = 0; i < br; i++)
-        for (j = 0; j < bc; j++)
-            tmp[j * br + i] = arg.B[i][arg.bc0 + j];
+/* Choose a tiling of the ar x bc output with a few tiles per thread so
+   that dynamic scheduling can balance uneven entry costs. */
+void
+_arb_mat_mul_threaded_tiling(slong * tile_rows, slong * tile_cols,
+    slong ar, slong bc, slong num_threads)
+{
+    slong side;
 
-    for (i = arg.ar0; i < arg.ar1; i++)
-    {
-        for (j = arg.bc0; j < arg.bc1; j++)
-        {
-            arb_dot(arg.C[i] + j, NULL, 0,
-                arg.A[i], 1, tmp + (j - arg.bc0) * br, 1, br, arg.prec);
-        }
-    }
+    side = sqrt((double) ar * (double) bc / (4.0 * num_threads));
+    side = FLINT_MAX(side, 1);
+    side = FLINT_MIN(side, TILE_MAX);
 
-    TMP_END;
-    flint_cleanup();
-    return NULL;
+    *tile_rows = FLINT_MIN(side, ar);
+    *tile_cols = FLINT_MIN(side, bc);
 }
 
 void
 arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong prec)
 {
-    slong ar, ac, br, bc, i, num_threads;
-    pthread_t * threads;
-    arb_mat_mul_arg_t * args;
+    slong ar, ac, br, bc, i, j;
+    arb_mat_mul_work_t work;
+    arb_ptr tmp;
+    TMP_INIT;
 
     ar = arb_mat_nrows(A);
     ac = arb_mat_ncols(A);
@@ -82,6 +87,9 @@ arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong pr
         return;
     }
 
+    if (ar == 0 || bc == 0)
+        return;
+
     if (A == C || B == C)
     {
         arb_mat_t T;
@@ -92,42 +100,30 @@ arb_mat_mul_threaded(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong pr
         return;
     }
 
-    num_threads = flint_get_num_threads();
-    threads = flint_malloc(sizeof(pthread_t) * num_threads);
-    args = flint_malloc(sizeof(arb_mat_mul_arg_t) * num_threads);
+    TMP_START;
 
-    for (i = 0; i < num_threads; i++)
-    {
-        args[i].C = C->rows;
-        args[i].A = A->rows;
-        args[i].B = B->rows;
-
-        if (ar >= bc)
-        {
-            args[i].ar0 = (ar * i) / num_threads;
-            args[i].ar1 = (ar * (i + 1)) / num_threads;
-            args[i].bc0 = 0;
-            args[i].bc1 = bc;
-        }
-        else
-        {
-            args[i].ar0 = 0;
-            args[i].ar1 = ar;
-            args[i].bc0 = (bc * i) / num_threads;
-            args[i].bc1 = (bc * (i + 1)) / num_threads;
-        }
-
-        args[i].br = br;
-        args[i].prec = prec;
-
-        pthread_create(&threads[i], NULL, _arb_mat_mul_thread, &args[i]);
-    }
+    /* Shallow transpose of B, shared read-only by all tiles. */
+    tmp = TMP_ALLOC(sizeof(arb_struct) * br * bc);
 
-    for (i = 0; i < num_threads; i++)
-    {
-        pthread_join(threads[i], NULL);
-    }
+    for (i = 0; i < br; i++)
+        for (j = 0; j < bc; j++)
+            tmp[j * br + i] = *arb_mat_entry(B, i, j);
+
+    _arb_mat_mul_threaded_tiling(&work.tile_rows, &work.tile_cols,
+        ar, bc, flint_get_num_threads());
 
-    flint_free(threads);
-    flint_free(args);
+    work.C = C->rows;
+    work.A = A->rows;
+    work.BT = tmp;
+    work.ar = ar;
+    work.bc = bc;
+    work.br = br;
+    work.num_tile_cols = (bc + work.tile_cols - 1) / work.tile_cols;
+    work.prec = prec;
+
+    flint_parallel_do(_arb_mat_mul_tile_worker, &work,
+        ((ar + work.tile_rows - 1) / work.tile_rows) * work.num_tile_cols,
+        -1, FLINT_PARALLEL_DYNAMIC);
+
+    TMP_END;
 }
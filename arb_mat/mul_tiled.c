@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_mat.h"
+
+/* Target size in bytes of one packed panel of columns of B. */
+#define PANEL_BYTES 131072
+
+/* Sets res to a read-only shallow copy of x whose midpoint limbs (if not
+   stored inline) are moved to the contiguous array limbs. Returns a pointer
+   to the first unused limb. */
+static mp_ptr
+_arb_pack_shallow(arb_t res, const arb_t x, mp_ptr limbs)
+{
+    slong xn;
+
+    *res = *x;
+
+    if (ARF_HAS_PTR(arb_midref(res)))
+    {
+        xn = ARF_SIZE(arb_midref(res));
+        flint_mpn_copyi(limbs, ARF_PTR_D(arb_midref(res)), xn);
+        ARF_PTR_D(arb_midref(res)) = limbs;
+        limbs += xn;
+    }
+
+    return limbs;
+}
+
+static slong
+_arb_ptr_limbs(const arb_t x)
+{
+    return ARF_HAS_PTR(arb_midref(x)) ? ARF_SIZE(arb_midref(x)) : 0;
+}
+
+void
+arb_mat_mul_tiled(arb_mat_t C, const arb_mat_t A, const arb_mat_t B, slong prec)
+{
+    slong ar, ac, br, bc, i, j, k, j0, j1, panel, alloc, balloc;
+    arb_ptr AP, BP;
+    mp_ptr limbs, ptr;
+
+    ar = arb_mat_nrows(A);
+    ac = arb_mat_ncols(A);
+    br = arb_mat_nrows(B);
+    bc = arb_mat_ncols(B);
+
+    if (ac != br || ar != arb_mat_nrows(C) || bc != arb_mat_ncols(C))
+    {
+        flint_printf("arb_mat_mul_tiled: incompatible dimensions\n");
+        flint_abort();
+    }
+
+    if (br <= 2 || ar == 0 || bc == 0)
+    {
+        arb_mat_mul_classical(C, A, B, prec);
+        return;
+    }
+
+    if (A == C || B == C)
+    {
+        arb_mat_t T;
+        arb_mat_init(T, ar, bc);
+        arb_mat_mul_tiled(T, A, B, prec);
+        arb_mat_swap_entrywise(T, C);
+        arb_mat_clear(T);
+        return;
+    }
+
+    /* Pack the rows of A and the columns of B, each row or column
+       with its midpoint limbs stored contiguously. */
+    alloc = 0;
+    for (i = 0; i < ar; i++)
+        for (k = 0; k < br; k++)
+            alloc += _arb_ptr_limbs(arb_mat_entry(A, i, k));
+    balloc = 0;
+    for (k = 0; k < br; k++)
+        for (j = 0; j < bc; j++)
+            balloc += _arb_ptr_limbs(arb_mat_entry(B, k, j));
+    alloc += balloc;
+
+    AP = flint_malloc(sizeof(arb_struct) * ar * br);
+    BP = flint_malloc(sizeof(arb_struct) * br * bc);
+    limbs = flint_malloc(sizeof(mp_limb_t) * FLINT_MAX(alloc, 1));
+
+    ptr = limbs;
+    for (i = 0; i < ar; i++)
+        for (k = 0; k < br; k++)
+            ptr = _arb_pack_shallow(AP + i * br + k, arb_mat_entry(A, i, k), ptr);
+    for (j = 0; j < bc; j++)
+        for (k = 0; k < br; k++)
+            ptr = _arb_pack_shallow(BP + j * br + k, arb_mat_entry(B, k, j), ptr);
+
+    /* Choose the panel width so that a panel of packed columns of B
+       stays in cache while all rows of A stream past it. */
+    panel = (sizeof(arb_struct) * br * bc + sizeof(mp_limb_t) * balloc) / bc;
+    panel = PANEL_BYTES / FLINT_MAX(panel, 1);
+    panel = FLINT_MAX(panel, 1);
+
+    for (j0 = 0; j0 < bc; j0 += panel)
+    {
+        j1 = FLINT_MIN(j0 + panel, bc);
+
+        for (i = 0; i < ar; i++)
+            for (j = j0; j < j1; j++)
+                arb_dot(arb_mat_entry(C, i, j), NULL, 0,
+                    AP + i * br, 1, BP + j * br, 1, br, prec);
+    }
+
+    flint_free(AP);
+    flint_free(BP);
+    flint_free(limbs);
+}
@@ -0,0 +1,105 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include "arb_mat.h"
+#include "flint/profiler.h"
+
+/* Reports the throughput of arb_mat_lu in units of 10^9 scalar operations
+   per second, counting 2n^3/3 multiply-adds for an n x n matrix. */
+
+static int usage(char *argv[])
+{
+    flint_printf("usage: %s [--threads <max>] [--prec <bits>] n1 [n2 ...]\n", argv[0]);
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    slong i, n, prec, max_threads, num_threads, j, np;
+    slong precs[5] = { 64, 128, 256, 512, 1024 };
+    flint_rand_t state;
+    arb_mat_t A, LU;
+    slong * perm;
+    timeit_t timer;
+    double t, gflops;
+    int k, ok;
+
+    max_threads = 1;
+    np = 5;
+
+    for (k = 1; k < argc && argv[k][0] == '-'; k++)
+    {
+        if (!strcmp(argv[k], "--threads") && k + 1 < argc)
+        {
+            max_threads = atol(argv[++k]);
+        }
+        else if (!strcmp(argv[k], "--prec") && k + 1 < argc)
+        {
+            precs[0] = atol(argv[++k]);
+            np = 1;
+        }
+        else
+        {
+            return usage(argv);
+        }
+    }
+
+    if (k == argc)
+        return usage(argv);
+
+    flint_randinit(state);
+
+    printf("%8s %8s %8s %12s %12s\n", "n", "prec", "threads", "time (s)", "Gflop-eq/s");
+
+    for ( ; k < argc; k++)
+    {
+        n = atol(argv[k]);
+
+        for (j = 0; j < np; j++)
+        {
+            prec = precs[j];
+
+            arb_mat_init(A, n, n);
+            arb_mat_init(LU, n, n);
+            perm = _perm_init(n);
+
+            /* diagonally dominant so that the factorization succeeds */
+            for (i = 0; i < n * n; i++)
+                arb_urandom(A->entries + i, state, prec);
+            for (i = 0; i < n; i++)
+                arb_add_ui(arb_mat_entry(A, i, i), arb_mat_entry(A, i, i), n, prec);
+
+            for (num_threads = 1; num_threads <= max_threads; num_threads *= 2)
+            {
+                flint_set_num_threads(num_threads);
+
+                timeit_start(timer);
+                ok = arb_mat_lu(perm, LU, A, prec);
+                timeit_stop(timer);
+
+                t = timer->wall * 0.001;
+                gflops = (2.0 / 3.0) * n * (double) n * n / FLINT_MAX(t, 1e-9) * 1e-9;
+
+                flint_printf("%8wd %8wd %8wd ", n, prec, num_threads);
+                printf("%12.3f %12.4f%s\n", t, gflops, ok ? "" : "  (failed)");
+            }
+
+            arb_mat_clear(A);
+            arb_mat_clear(LU);
+            _perm_clear(perm);
+        }
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    return EXIT_SUCCESS;
+}
@@ -170,6 +170,77 @@ int main()
         _perm_clear(perm);
     }
 
+    /* Large diagonally dominant matrices, exercising the multithreaded
+       algorithm. */
+    for (iter = 0; iter < 5 * arb_test_multiplier(); iter++)
+    {
+        fmpq_mat_t Q;
+        arb_mat_t A, LU, P, L, U, T;
+        slong i, j, n, qbits, prec, *perm;
+
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        n = 64 + n_randint(state, 40);
+        qbits = 1 + n_randint(state, 20);
+        prec = 128 + n_randint(state, 200);
+
+        fmpq_mat_init(Q, n, n);
+        arb_mat_init(A, n, n);
+        arb_mat_init(LU, n, n);
+        arb_mat_init(P, n, n);
+        arb_mat_init(L, n, n);
+        arb_mat_init(U, n, n);
+        arb_mat_init(T, n, n);
+        perm = _perm_init(n);
+
+        fmpq_mat_randtest(Q, state, qbits);
+        for (i = 0; i < n; i++)
+            fmpq_add_si(fmpq_mat_entry(Q, i, i), fmpq_mat_entry(Q, i, i),
+                2 * n * (WORD(1) << qbits));
+
+        arb_mat_set_fmpq_mat(A, Q, prec);
+
+        if (!arb_mat_lu_recursive(perm, LU, A, prec))
+        {
+            flint_printf("FAIL (threaded, failed to converge)\n");
+            flint_printf("n = %wd, prec = %wd, threads = %d\n",
+                n, prec, flint_get_num_threads());
+            flint_abort();
+        }
+
+        arb_mat_one(L);
+        for (i = 0; i < n; i++)
+            for (j = 0; j < i; j++)
+                arb_set(arb_mat_entry(L, i, j), arb_mat_entry(LU, i, j));
+
+        for (i = 0; i < n; i++)
+            for (j = i; j < n; j++)
+                arb_set(arb_mat_entry(U, i, j), arb_mat_entry(LU, i, j));
+
+        for (i = 0; i < n; i++)
+            arb_one(arb_mat_entry(P, perm[i], i));
+
+        arb_mat_mul(T, P, L, prec);
+        arb_mat_mul(T, T, U, prec);
+
+        if (!arb_mat_contains_fmpq_mat(T, Q))
+        {
+            flint_printf("FAIL (threaded, containment)\n");
+            flint_printf("n = %wd, prec = %wd, threads = %d\n",
+                n, prec, flint_get_num_threads());
+            flint_abort();
+        }
+
+        fmpq_mat_clear(Q);
+        arb_mat_clear(A);
+        arb_mat_clear(LU);
+        arb_mat_clear(P);
+        arb_mat_clear(L);
+        arb_mat_clear(U);
+        arb_mat_clear(T);
+        _perm_clear(perm);
+    }
+
     flint_randclear(state);
     flint_cleanup();
     flint_printf("PASS\n");
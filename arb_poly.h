@@ -480,6 +480,37 @@ void _arb_poly_interpolate_fast(arb_ptr poly,
 void arb_poly_interpolate_fast(arb_poly_t poly,
         arb_srcptr xs, arb_srcptr ys, slong n, slong prec);
 
+/* Precomputed points for multipoint evaluation and interpolation */
+
+typedef struct
+{
+    arb_ptr * tree;
+    arb_ptr weights;
+    slong len;
+    slong prec;
+}
+arb_poly_multipoint_struct;
+
+typedef arb_poly_multipoint_struct arb_poly_multipoint_t[1];
+
+void arb_poly_multipoint_init(arb_poly_multipoint_t mp,
+    arb_srcptr xs, slong n, slong prec);
+
+void arb_poly_multipoint_clear(arb_poly_multipoint_t mp);
+
+void arb_poly_multipoint_precompute_weights(arb_poly_multipoint_t mp);
+
+slong arb_poly_multipoint_allocated_bytes(const arb_poly_multipoint_t mp);
+
+void arb_poly_multipoint_evaluate(arb_ptr ys, const arb_poly_multipoint_t mp,
+    const arb_poly_t poly, slong prec);
+
+void arb_poly_multipoint_evaluate_vec(arb_ptr ys, const arb_poly_multipoint_t mp,
+    const arb_poly_struct * polys, slong num, slong prec);
+
+void arb_poly_multipoint_interpolate(arb_poly_t poly, arb_poly_multipoint_t mp,
+    arb_srcptr ys, slong prec);
+
 /* Derivative and integral */
 
 void _arb_poly_derivative(arb_ptr res, arb_srcptr poly, slong len, slong prec);
@@ -27,14 +27,102 @@ _arb_poly_rem_2(arb_ptr r, arb_srcptr a, slong al,
     }
 }
 
+/* Minimum number of points for processing the levels of the tree
+   with several threads. */
+#define TREE_THREADED_CUTOFF 64
+
+typedef struct
+{
+    arb_ptr * tree;
+    arb_srcptr poly;
+    slong plen;
+    arb_ptr t;
+    arb_ptr u;
+    slong level;
+    slong len;
+    slong prec;
+    slong num_nodes;
+    slong num_chunks;
+}
+eval_work_t;
+
+/* Initial reduction of the polynomial modulo node k on the given level. */
+static void
+_arb_poly_evaluate_vec_fast_top(eval_work_t * work, slong k)
+{
+    slong pow, i, tlen;
+
+    pow = WORD(1) << work->level;
+    i = k * pow;
+    tlen = ((i + pow) <= work->len) ? pow : work->len % pow;
+
+    _arb_poly_rem(work->t + i, work->poly, work->plen,
+        work->tree[work->level] + k * (pow + 1), tlen + 1, work->prec);
+}
+
+/* Reduces the remainder for node k on level i + 1 modulo the
+   two children of that node. */
+static void
+_arb_poly_evaluate_vec_fast_node(eval_work_t * work, slong k)
+{
+    slong pow, left, prec;
+    arb_ptr pa, pb, pc;
+
+    prec = work->prec;
+    pow = WORD(1) << work->level;
+    left = work->len - k * 2 * pow;
+    pa = work->tree[work->level] + k * (2 * pow + 2);
+    pb = work->t + k * 2 * pow;
+    pc = work->u + k * 2 * pow;
+
+    if (left >= 2 * pow)
+    {
+        _arb_poly_rem_2(pc, pb, 2 * pow, pa, pow + 1, prec);
+        _arb_poly_rem_2(pc + pow, pb, 2 * pow, pa + pow + 1, pow + 1, prec);
+    }
+    else if (left > pow)
+    {
+        _arb_poly_rem(pc, pb, left, pa, pow + 1, prec);
+        _arb_poly_rem(pc + pow, pb, left, pa + pow + 1, left - pow + 1, prec);
+    }
+    else if (left > 0)
+        _arb_vec_set(pc, pb, left);
+}
+
+static void
+_arb_poly_evaluate_vec_fast_top_worker(slong j, void * arg)
+{
+    eval_work_t * work = (eval_work_t *) arg;
+    slong k, k1, k2;
+
+    k1 = (j * work->num_nodes) / work->num_chunks;
+    k2 = ((j + 1) * work->num_nodes) / work->num_chunks;
+
+    for (k = k1; k < k2; k++)
+        _arb_poly_evaluate_vec_fast_top(work, k);
+}
+
+static void
+_arb_poly_evaluate_vec_fast_node_worker(slong j, void * arg)
+{
+    eval_work_t * work = (eval_work_t *) arg;
+    slong k, k1, k2;
+
+    k1 = (j * work->num_nodes) / work->num_chunks;
+    k2 = ((j + 1) * work->num_nodes) / work->num_chunks;
+
+    for (k = k1; k < k2; k++)
+        _arb_poly_evaluate_vec_fast_node(work, k);
+}
+
 void
 _arb_poly_evaluate_vec_fast_precomp(arb_ptr vs, arb_srcptr poly,
     slong plen, arb_ptr * tree, slong len, slong prec)
 {
-    slong height, i, j, pow, left;
+    slong height, i, k, pow, num_threads;
     slong tree_height;
-    slong tlen;
-    arb_ptr t, u, swap, pa, pb, pc;
+    arb_ptr t, u, swap;
+    eval_work_t work;
 
     /* avoid worrying about some degenerate cases */
     if (len < 2 || plen < 2)
@@ -62,7 +150,15 @@ _arb_poly_evaluate_vec_fast_precomp(arb_ptr vs, arb_srcptr poly,
     t = _arb_vec_init(len);
     u = _arb_vec_init(len);
 
-    left = len;
+    /* The nodes on each level are independent, so each level
+       can be split between threads. */
+    num_threads = (len >= TREE_THREADED_CUTOFF) ? flint_get_num_threads() : 1;
+
+    work.tree = tree;
+    work.poly = poly;
+    work.plen = plen;
+    work.len = len;
+    work.prec = prec;
 
     /* Initial reduction. We allow the polynomial to be larger
         or smaller than the number of points. */
@@ -72,38 +168,42 @@ _arb_poly_evaluate_vec_fast_precomp(arb_ptr vs, arb_srcptr poly,
         height--;
     pow = WORD(1) << height;
 
-    for (i = j = 0; i < len; i += pow, j += (pow + 1))
+    work.t = t;
+    work.level = height;
+    work.num_nodes = (len + pow - 1) / pow;
+    work.num_chunks = FLINT_MIN(num_threads, work.num_nodes);
+
+    if (work.num_chunks > 1)
     {
-        tlen = ((i + pow) <= len) ? pow : len % pow;
-        _arb_poly_rem(t + i, poly, plen, tree[height] + j, tlen + 1, prec);
+        flint_parallel_do(_arb_poly_evaluate_vec_fast_top_worker, &work,
+            work.num_chunks, -1, FLINT_PARALLEL_STRIDED);
+    }
+    else
+    {
+        for (k = 0; k < work.num_nodes; k++)
+            _arb_poly_evaluate_vec_fast_top(&work, k);
     }
 
     for (i = height - 1; i >= 0; i--)
     {
         pow = WORD(1) << i;
-        left = len;
-        pa = tree[i];
-        pb = t;
-        pc = u;
 
-        while (left >= 2 * pow)
-        {
-            _arb_poly_rem_2(pc, pb, 2 * pow, pa, pow + 1, prec);
-            _arb_poly_rem_2(pc + pow, pb, 2 * pow, pa + pow + 1, pow + 1, prec);
+        work.t = t;
+        work.u = u;
+        work.level = i;
+        work.num_nodes = (len + 2 * pow - 1) / (2 * pow);
+        work.num_chunks = FLINT_MIN(num_threads, work.num_nodes);
 
-            pa += 2 * pow + 2;
-            pb += 2 * pow;
-            pc += 2 * pow;
-            left -= 2 * pow;
+        if (work.num_chunks > 1)
+        {
+            flint_parallel_do(_arb_poly_evaluate_vec_fast_node_worker, &work,
+                work.num_chunks, -1, FLINT_PARALLEL_STRIDED);
         }
-
-        if (left > pow)
+        else
         {
-            _arb_poly_rem(pc, pb, left, pa, pow + 1, prec);
-            _arb_poly_rem(pc + pow, pb, left, pa + pow + 1, left - pow + 1, prec);
+            for (k = 0; k < work.num_nodes; k++)
+                _arb_poly_evaluate_vec_fast_node(&work, k);
         }
-        else if (left > 0)
-            _arb_vec_set(pc, pb, left);
 
         swap = t;
         t = u;
@@ -23,9 +23,20 @@ _arb_poly_exp_series_newton(arb_ptr f, arb_ptr g,
 {
     slong alloc;
     arb_ptr T, U, hprime;
+    arb_arena_struct * arena;
 
     alloc = 3 * len;
-    T = _arb_vec_init(alloc);
+    arena = arb_arena_scratch();
+
+    if (arena != NULL)
+    {
+        arb_arena_push(arena);
+        T = arb_arena_vec(arena, alloc);
+    }
+    else
+    {
+        T = _arb_vec_init(alloc);
+    }
     U = T + len;
     hprime = U + len;
 
@@ -78,7 +89,10 @@ _arb_poly_exp_series_newton(arb_ptr f, arb_ptr g,
 
     NEWTON_END
 
-    _arb_vec_clear(T, alloc);
+    if (arena != NULL)
+        arb_arena_pop(arena);
+    else
+        _arb_vec_clear(T, alloc);
 }
 
 void
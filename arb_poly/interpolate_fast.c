@@ -43,13 +43,76 @@ _arb_poly_interpolation_weights(arb_ptr w,
     _arb_vec_clear(tmp, len + 1);
 }
 
+/* Minimum number of points for processing the levels of the tree
+   with several threads. */
+#define TREE_THREADED_CUTOFF 64
+
+typedef struct
+{
+    arb_ptr * tree;
+    arb_ptr poly;
+    arb_ptr t;
+    arb_ptr u;
+    slong level;
+    slong len;
+    slong prec;
+    slong num_nodes;
+    slong num_chunks;
+}
+interp_work_t;
+
+/* Combines the two halves of node k on the given level. Node k only
+   touches entries k * 2^(level+1) to (k + 1) * 2^(level+1) - 1 of
+   poly and of the temporary vectors, so the nodes are independent. */
+static void
+_arb_poly_interpolate_fast_node(interp_work_t * work, slong k)
+{
+    slong pow, left, prec;
+    arb_ptr pa, pb, t, u;
+
+    prec = work->prec;
+    pow = WORD(1) << work->level;
+    left = work->len - k * 2 * pow;
+    pa = work->tree[work->level] + k * (2 * pow + 2);
+    pb = work->poly + k * 2 * pow;
+    t = work->t + k * 2 * pow;
+    u = work->u + k * 2 * pow;
+
+    if (left >= 2 * pow)
+    {
+        _arb_poly_mul(t, pa, pow + 1, pb + pow, pow, prec);
+        _arb_poly_mul(u, pa + pow + 1, pow + 1, pb, pow, prec);
+        _arb_vec_add(pb, t, u, 2 * pow, prec);
+    }
+    else if (left > pow)
+    {
+        _arb_poly_mul(t, pa, pow + 1, pb + pow, left - pow, prec);
+        _arb_poly_mul(u, pb, pow, pa + pow + 1, left - pow + 1, prec);
+        _arb_vec_add(pb, t, u, left, prec);
+    }
+}
+
+static void
+_arb_poly_interpolate_fast_worker(slong j, void * arg)
+{
+    interp_work_t * work = (interp_work_t *) arg;
+    slong k, k1, k2;
+
+    k1 = (j * work->num_nodes) / work->num_chunks;
+    k2 = ((j + 1) * work->num_nodes) / work->num_chunks;
+
+    for (k = k1; k < k2; k++)
+        _arb_poly_interpolate_fast_node(work, k);
+}
+
 void
 _arb_poly_interpolate_fast_precomp(arb_ptr poly,
     arb_srcptr ys, arb_ptr * tree, arb_srcptr weights,
     slong len, slong prec)
 {
-    arb_ptr t, u, pa, pb;
-    slong i, pow, left;
+    arb_ptr t, u;
+    slong i, k, pow, num_threads;
+    interp_work_t work;
 
     if (len == 0)
         return;
@@ -60,29 +123,32 @@ _arb_poly_interpolate_fast_precomp(arb_ptr poly,
     for (i = 0; i < len; i++)
         arb_mul(poly + i, weights + i, ys + i, prec);
 
+    num_threads = (len >= TREE_THREADED_CUTOFF) ? flint_get_num_threads() : 1;
+
+    work.tree = tree;
+    work.poly = poly;
+    work.t = t;
+    work.u = u;
+    work.len = len;
+    work.prec = prec;
+
     for (i = 0; i < FLINT_CLOG2(len); i++)
     {
         pow = (WORD(1) << i);
-        pa = tree[i];
-        pb = poly;
-        left = len;
 
-        while (left >= 2 * pow)
-        {
-            _arb_poly_mul(t, pa, pow + 1, pb + pow, pow, prec);
-            _arb_poly_mul(u, pa + pow + 1, pow + 1, pb, pow, prec);
-            _arb_vec_add(pb, t, u, 2 * pow, prec);
+        work.level = i;
+        work.num_nodes = (len + 2 * pow - 1) / (2 * pow);
+        work.num_chunks = FLINT_MIN(num_threads, work.num_nodes);
 
-            left -= 2 * pow;
-            pa += 2 * pow + 2;
-            pb += 2 * pow;
+        if (work.num_chunks > 1)
+        {
+            flint_parallel_do(_arb_poly_interpolate_fast_worker, &work,
+                work.num_chunks, -1, FLINT_PARALLEL_STRIDED);
         }
-
-        if (left > pow)
+        else
         {
-            _arb_poly_mul(t, pa, pow + 1, pb + pow, left - pow, prec);
-            _arb_poly_mul(u, pb, pow, pa + pow + 1, left - pow + 1, prec);
-            _arb_vec_add(pb, t, u, left, prec);
+            for (k = 0; k < work.num_nodes; k++)
+                _arb_poly_interpolate_fast_node(&work, k);
         }
     }
 
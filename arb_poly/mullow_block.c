@@ -11,6 +11,7 @@
 
 #include <math.h>
 #include "arb_poly.h"
+#include "arb_soa.h"
 
 void
 _arb_poly_get_scale(fmpz_t scale, arb_srcptr x, slong xlen,
@@ -83,15 +84,191 @@ _arb_poly_get_scale(fmpz_t scale, arb_srcptr x, slong xlen,
 #define DOUBLE_BLOCK_SHIFT (DOUBLE_BLOCK_MAX_HEIGHT / 2)
 
 
+static int
+_arb_vec_is_lagom(arb_srcptr x, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+        if (!ARB_IS_LAGOM(x + i))
+            return 0;
+
+    return 1;
+}
+
+/* Minimum length and output size (length times bits) for splitting
+   an integer polynomial multiplication between threads. */
+#define THREADED_MIN_LEN 256
+#define THREADED_MIN_SIZE 1000000
+
+typedef struct
+{
+    fmpz * res;
+    slong * reslen;
+    const slong * ta;
+    const slong * tb;
+    const fmpz * x;
+    slong xlen;
+    const fmpz * y;
+    slong ylen;
+    slong n;
+    slong m;
+    int squaring;
+}
+mullow_work_t;
+
+static void
+_fmpz_poly_mullow_piece_worker(slong i, void * arg)
+{
+    mullow_work_t * work = (mullow_work_t *) arg;
+    const fmpz *x, *y;
+    slong a, b, xl, yl, bn;
+    fmpz * z;
+
+    a = work->ta[i];
+    b = work->tb[i];
+    x = work->x + a * work->m;
+    y = work->y + b * work->m;
+    xl = FLINT_MIN(work->m, work->xlen - a * work->m);
+    yl = FLINT_MIN(work->m, work->ylen - b * work->m);
+    z = work->res + i * 2 * work->m;
+
+    bn = FLINT_MIN(xl + yl - 1, work->n - (a + b) * work->m);
+
+    /* the piece may lie entirely beyond the truncation */
+    if (xl <= 0 || yl <= 0 || bn <= 0)
+    {
+        work->reslen[i] = 0;
+        return;
+    }
+
+    xl = FLINT_MIN(xl, bn);
+    yl = FLINT_MIN(yl, bn);
+
+    if (work->squaring && a == b)
+        _fmpz_poly_sqrlow(z, x, xl, bn);
+    else if (xl >= yl)
+        _fmpz_poly_mullow(z, x, xl, y, yl, bn);
+    else
+        _fmpz_poly_mullow(z, y, yl, x, xl, bn);
+
+    work->reslen[i] = bn;
+}
+
+/* Sets res to the low n coefficients of the product of x and y, where
+   n <= xlen + ylen - 1 (if squaring is set, x and y must be identical).
+   Large products are split into pieces x_a * y_b which are multiplied
+   in parallel. All arithmetic is exact, so the output does not
+   depend on the number of threads. */
+static void
+_fmpz_poly_mullow_threaded(fmpz * res, const fmpz * x, slong xlen,
+    const fmpz * y, slong ylen, slong n, int squaring)
+{
+    mullow_work_t work;
+    slong num_threads, num_tasks, k, m, a, b, i;
+    slong *ta, *tb, *reslen;
+    fmpz * tmp;
+
+    xlen = FLINT_MIN(xlen, n);
+    ylen = FLINT_MIN(ylen, n);
+
+    num_threads = flint_get_num_threads();
+    k = 0;
+
+    if (num_threads > 1 && n >= THREADED_MIN_LEN)
+    {
+        slong bits;
+
+        bits = FLINT_ABS(_fmpz_vec_max_bits(x, xlen));
+        bits += FLINT_ABS(_fmpz_vec_max_bits(y, ylen));
+
+        /* choose the number of pieces k such that the number of
+           products does not exceed the number of threads */
+        if (bits > THREADED_MIN_SIZE / n)
+        {
+            for (k = 1; ; k++)
+            {
+                num_tasks = squaring ? ((k + 2) / 2) * ((k + 3) / 2)
+                                     : (k + 1) * (k + 2) / 2;
+                if (num_tasks > num_threads)
+                    break;
+            }
+        }
+    }
+
+    if (k < 2)
+    {
+        if (squaring)
+            _fmpz_poly_sqrlow(res, x, xlen, n);
+        else if (xlen >= ylen)
+            _fmpz_poly_mullow(res, x, xlen, y, ylen, n);
+        else
+            _fmpz_poly_mullow(res, y, ylen, x, xlen, n);
+        return;
+    }
+
+    m = (n + k - 1) / k;
+
+    ta = flint_malloc(sizeof(slong) * k * k);
+    tb = flint_malloc(sizeof(slong) * k * k);
+    reslen = flint_malloc(sizeof(slong) * k * k);
+
+    num_tasks = 0;
+    for (a = 0; a < k; a++)
+    {
+        for (b = squaring ? a : 0; a + b < k; b++)
+        {
+            ta[num_tasks] = a;
+            tb[num_tasks] = b;
+            num_tasks++;
+        }
+    }
+
+    tmp = _fmpz_vec_init(num_tasks * 2 * m);
+
+    work.res = tmp;
+    work.reslen = reslen;
+    work.ta = ta;
+    work.tb = tb;
+    work.x = x;
+    work.xlen = xlen;
+    work.y = y;
+    work.ylen = ylen;
+    work.n = n;
+    work.m = m;
+    work.squaring = squaring;
+
+    flint_parallel_do(_fmpz_poly_mullow_piece_worker, &work,
+        num_tasks, -1, FLINT_PARALLEL_DYNAMIC);
+
+    /* add up the pieces in a fixed order */
+    _fmpz_vec_zero(res, n);
+
+    for (i = 0; i < num_tasks; i++)
+    {
+        fmpz * r = res + (ta[i] + tb[i]) * m;
+
+        if (squaring && ta[i] != tb[i])
+            _fmpz_vec_scalar_addmul_si(r, tmp + i * 2 * m, reslen[i], 2);
+        else
+            _fmpz_vec_add(r, r, tmp + i * 2 * m, reslen[i]);
+    }
+
+    _fmpz_vec_clear(tmp, num_tasks * 2 * m);
+    flint_free(ta);
+    flint_free(tb);
+    flint_free(reslen);
+}
+
+/* The magnitudes are given in SoA form (see arb_soa.h). */
 static void
 _mag_vec_get_fmpz_2exp_blocks(fmpz * coeffs,
     double * dblcoeffs, fmpz * exps, slong * blocks, const fmpz_t scale,
-    arb_srcptr x, mag_srcptr xm, slong len)
+    const uint32_t * xman, const slong * xexp, slong len)
 {
     fmpz_t top, bot, t, b, v, block_top, block_bot;
     slong i, j, s, block, bits, maxheight;
     int in_zero;
-    mag_srcptr cur;
 
     fmpz_init(top);
     fmpz_init(bot);
@@ -111,15 +288,13 @@ _mag_vec_get_fmpz_2exp_blocks(fmpz * coeffs,
 
     for (i = 0; i < len; i++)
     {
-        cur = (x == NULL) ? (xm + i) : arb_radref(x + i);
-
-        /* Skip (must be zero, since we assume there are no Infs/NaNs). */
-        if (mag_is_special(cur))
+        /* Skip zeros. */
+        if (xman[i] == 0)
             continue;
 
         /* Bottom and top exponent of current number */
         bits = MAG_BITS;
-        fmpz_set(top, MAG_EXPREF(cur));
+        fmpz_set_si(top, xexp[i]);
         fmpz_submul_ui(top, scale, i);
         fmpz_sub_ui(bot, top, bits);
 
@@ -168,9 +343,7 @@ _mag_vec_get_fmpz_2exp_blocks(fmpz * coeffs,
     {
         for (j = blocks[i]; j < blocks[i + 1]; j++)
         {
-            cur = (x == NULL) ? (xm + j) : arb_radref(x + j);
-
-            if (mag_is_special(cur))
+            if (xman[j] == 0)
             {
                 fmpz_zero(coeffs + j);
                 dblcoeffs[j] = 0.0;
@@ -180,13 +353,13 @@ _mag_vec_get_fmpz_2exp_blocks(fmpz * coeffs,
                 mp_limb_t man;
                 double c;
 
-                man = MAG_MAN(cur);
+                man = xman[j];
 
                 /* TODO: only write and use doubles when block is short? */
 
                 /* Divide by 2^(scale * j) */
-                fmpz_mul_ui(t, scale, j);
-                fmpz_sub(t, MAG_EXPREF(cur), t);
+                fmpz_set_si(t, xexp[j]);
+                fmpz_submul_ui(t, scale, j);
 
                 fmpz_sub_ui(t, t, MAG_BITS); /* bottom exponent */
                 s = _fmpz_sub_small(t, exps + i);
@@ -378,10 +551,7 @@ _arb_poly_addmullow_rad(arb_ptr z, fmpz * zz,
             }
             else
             {
-                if (xl >= yl)
-                    _fmpz_poly_mullow(zz, xz + xp, xl, yz + yp, yl, bn);
-                else
-                    _fmpz_poly_mullow(zz, yz + yp, yl, xz + xp, xl, bn);
+                _fmpz_poly_mullow_threaded(zz, xz + xp, xl, yz + yp, yl, bn, 0);
 
                 for (k = 0; k < bn; k++)
                 {
@@ -419,7 +589,7 @@ _arb_poly_addmullow_block(arb_ptr z, fmpz * zz,
             bn = FLINT_MIN(2 * xl - 1, n - 2 * xp);
             xl = FLINT_MIN(xl, bn);
 
-            _fmpz_poly_sqrlow(zz, xz + xp, xl, bn);
+            _fmpz_poly_mullow_threaded(zz, xz + xp, xl, xz + xp, xl, bn, 1);
             _fmpz_add2_fast(zexp, xexps + i, xexps + i, 0);
 
             for (k = 0; k < bn; k++)
@@ -440,10 +610,7 @@ _arb_poly_addmullow_block(arb_ptr z, fmpz * zz,
             xl = FLINT_MIN(xl, bn);
             yl = FLINT_MIN(yl, bn);
 
-            if (xl >= yl)
-                _fmpz_poly_mullow(zz, xz + xp, xl, yz + yp, yl, bn);
-            else
-                _fmpz_poly_mullow(zz, yz + yp, yl, xz + xp, xl, bn);
+            _fmpz_poly_mullow_threaded(zz, xz + xp, xl, yz + yp, yl, bn, 0);
 
            _fmpz_add2_fast(zexp, xexps + i, yexps + j, squaring);
 
@@ -499,6 +666,14 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, slong xlen,
     xlen = FLINT_MAX(xmlen, xrlen);
     ylen = FLINT_MAX(ymlen, yrlen);
 
+    /* The error propagation needs word-size exponents */
+    if ((xrlen != 0 || yrlen != 0) &&
+        (!_arb_vec_is_lagom(x, xlen) || (!squaring && !_arb_vec_is_lagom(y, ylen))))
+    {
+        _arb_poly_mullow_classical(z, x, xlen, y, ylen, n, prec);
+        return;
+    }
+
     /* Start with the zero polynomial */
     _arb_vec_zero(z, n);
 
@@ -525,10 +700,25 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, slong xlen,
                            = (xm*ym) + (xm*yr + xr*(ym + yr))  */
     if (xrlen != 0 || yrlen != 0)
     {
-        mag_ptr tmp;
+        uint32_t *xmman, *xrman, *ymman, *yrman;
+        slong *xmexp, *xrexp, *ymexp, *yrexp;
         double *xdbl, *ydbl;
 
-        tmp = _mag_vec_init(FLINT_MAX(xlen, ylen));
+        /* Bounds for the midpoints and radii in SoA form. */
+        xmman = flint_malloc(sizeof(uint32_t) * (2 * xlen + 2 * ylen));
+        xrman = xmman + xlen;
+        ymman = xrman + xlen;
+        yrman = ymman + ylen;
+        xmexp = flint_malloc(sizeof(slong) * (2 * xlen + 2 * ylen));
+        xrexp = xmexp + xlen;
+        ymexp = xrexp + xlen;
+        yrexp = ymexp + ylen;
+
+        _arb_soa_rad_set_arb_mid(xmman, xmexp, x, xlen);
+        _arb_soa_rad_set_arb_rad(xrman, xrexp, x, xlen);
+        _arb_soa_rad_set_arb_mid(ymman, ymexp, y, ylen);
+        _arb_soa_rad_set_arb_rad(yrman, yrexp, y, ylen);
+
         xdbl = flint_malloc(sizeof(double) * xlen);
         ydbl = flint_malloc(sizeof(double) * ylen);
 
@@ -536,53 +726,44 @@ _arb_poly_mullow_block(arb_ptr z, arb_srcptr x, slong xlen,
                        = (xm*ym) + xr*(2 xm + xr)    */
         if (squaring)
         {
-            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
+            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, xrman, xrexp, xrlen);
 
             for (i = 0; i < xlen; i++)
-            {
-                arf_get_mag(tmp + i, arb_midref(x + i));
-                mag_mul_2exp_si(tmp + i, tmp + i, 1);
-                mag_add(tmp + i, tmp + i, arb_radref(x + i));
-            }
+                xmexp[i] += (xmman[i] != 0);
 
-            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, xlen);
+            _arb_soa_rad_add(ymman, ymexp, xmman, xmexp, xrman, xrexp, xlen);
+
+            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, ymman, ymexp, xlen);
             _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, xlen, n);
         }
         else if (yrlen == 0)
         {
             /* xr * |ym| */
-            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
-
-            for (i = 0; i < ymlen; i++)
-                arf_get_mag(tmp + i, arb_midref(y + i));
-
-            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, ymlen);
+            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, xrman, xrexp, xrlen);
+            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, ymman, ymexp, ymlen);
             _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ymlen, n);
         }
         else
         {
             /* |xm| * yr */
-            for (i = 0; i < xmlen; i++)
-                arf_get_mag(tmp + i, arb_midref(x + i));
-
-            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, NULL, tmp, xmlen);
-            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, y, NULL, yrlen);
+            _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, xmman, xmexp, xmlen);
+            _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, yrman, yrexp, yrlen);
             _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xmlen, yz, ydbl, ye, yblocks, yrlen, n);
 
             /* xr*(|ym| + yr) */
             if (xrlen != 0)
             {
-                _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, x, NULL, xrlen);
+                _mag_vec_get_fmpz_2exp_blocks(xz, xdbl, xe, xblocks, scale, xrman, xrexp, xrlen);
 
-                for (i = 0; i < ylen; i++)
-                    arb_get_mag(tmp + i, y + i);
+                _arb_soa_rad_add(ymman, ymexp, ymman, ymexp, yrman, yrexp, ylen);
 
-                _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, NULL, tmp, ylen);
+                _mag_vec_get_fmpz_2exp_blocks(yz, ydbl, ye, yblocks, scale, ymman, ymexp, ylen);
                 _arb_poly_addmullow_rad(z, zz, xz, xdbl, xe, xblocks, xrlen, yz, ydbl, ye, yblocks, ylen, n);
             }
         }
 
-        _mag_vec_clear(tmp, FLINT_MAX(xlen, ylen));
+        flint_free(xmman);
+        flint_free(xmexp);
         flint_free(xdbl);
         flint_free(ydbl);
     }
@@ -0,0 +1,65 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_poly.h"
+
+void
+arb_poly_multipoint_init(arb_poly_multipoint_t mp,
+    arb_srcptr xs, slong n, slong prec)
+{
+    mp->tree = _arb_poly_tree_alloc(n);
+    _arb_poly_tree_build(mp->tree, xs, n, prec);
+    mp->weights = NULL;
+    mp->len = n;
+    mp->prec = prec;
+}
+
+void
+arb_poly_multipoint_clear(arb_poly_multipoint_t mp)
+{
+    _arb_poly_tree_free(mp->tree, mp->len);
+
+    if (mp->weights != NULL)
+        _arb_vec_clear(mp->weights, mp->len);
+}
+
+void
+arb_poly_multipoint_precompute_weights(arb_poly_multipoint_t mp)
+{
+    if (mp->weights == NULL)
+    {
+        mp->weights = _arb_vec_init(mp->len);
+        _arb_poly_interpolation_weights(mp->weights, mp->tree, mp->len, mp->prec);
+    }
+}
+
+slong
+arb_poly_multipoint_allocated_bytes(const arb_poly_multipoint_t mp)
+{
+    slong i, height, len, size;
+
+    len = mp->len;
+    size = 0;
+
+    if (len != 0)
+    {
+        height = FLINT_CLOG2(len);
+        size += (height + 1) * sizeof(arb_ptr);
+
+        for (i = 0; i <= height; i++)
+            size += _arb_vec_allocated_bytes(mp->tree[i], len + (len >> i) + 1);
+    }
+
+    if (mp->weights != NULL)
+        size += _arb_vec_allocated_bytes(mp->weights, len);
+
+    return size;
+}
@@ -0,0 +1,75 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_poly.h"
+
+void
+arb_poly_multipoint_evaluate(arb_ptr ys, const arb_poly_multipoint_t mp,
+    const arb_poly_t poly, slong prec)
+{
+    _arb_poly_evaluate_vec_fast_precomp(ys, poly->coeffs, poly->length,
+        mp->tree, mp->len, prec);
+}
+
+typedef struct
+{
+    arb_ptr ys;
+    const arb_poly_multipoint_struct * mp;
+    const arb_poly_struct * polys;
+    slong num;
+    slong num_chunks;
+    slong prec;
+}
+work_t;
+
+static void
+worker(slong j, void * arg)
+{
+    work_t * work = (work_t *) arg;
+    slong i, i1, i2;
+
+    i1 = (j * work->num) / work->num_chunks;
+    i2 = ((j + 1) * work->num) / work->num_chunks;
+
+    for (i = i1; i < i2; i++)
+        arb_poly_multipoint_evaluate(work->ys + i * work->mp->len, work->mp,
+            work->polys + i, work->prec);
+}
+
+void
+arb_poly_multipoint_evaluate_vec(arb_ptr ys, const arb_poly_multipoint_t mp,
+    const arb_poly_struct * polys, slong num, slong prec)
+{
+    slong i, num_threads;
+
+    num_threads = flint_get_num_threads();
+
+    /* with enough polynomials, it is better to give each thread its own
+       polynomials than to split each tree level between threads */
+    if (num_threads > 1 && num >= num_threads && mp->len > 1)
+    {
+        work_t work;
+
+        work.ys = ys;
+        work.mp = mp;
+        work.polys = polys;
+        work.num = num;
+        work.num_chunks = num_threads;
+        work.prec = prec;
+
+        flint_parallel_do(worker, &work, num_threads, -1, FLINT_PARALLEL_STRIDED);
+    }
+    else
+    {
+        for (i = 0; i < num; i++)
+            arb_poly_multipoint_evaluate(ys + i * mp->len, mp, polys + i, prec);
+    }
+}
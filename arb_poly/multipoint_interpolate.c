@@ -0,0 +1,33 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_poly.h"
+
+void
+arb_poly_multipoint_interpolate(arb_poly_t poly, arb_poly_multipoint_t mp,
+    arb_srcptr ys, slong prec)
+{
+    slong n = mp->len;
+
+    if (n == 0)
+    {
+        arb_poly_zero(poly);
+    }
+    else
+    {
+        arb_poly_multipoint_precompute_weights(mp);
+        arb_poly_fit_length(poly, n);
+        _arb_poly_set_length(poly, n);
+        _arb_poly_interpolate_fast_precomp(poly->coeffs, ys, mp->tree,
+            mp->weights, n, prec);
+        _arb_poly_normalise(poly);
+    }
+}
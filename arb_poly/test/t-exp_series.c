@@ -141,6 +141,8 @@ int main()
             arb_poly_newton_exp_cutoff = 5 + n_randint(state, 50);
         }
 
+        arb_use_arena = n_randint(state, 2);
+
         if (n_randint(state, 100) == 0)
         {
             m = 1 + n_randint(state, 100);
@@ -190,6 +192,8 @@ int main()
         arb_poly_clear(c);
     }
 
+    arb_use_arena = 0;
+
     flint_randclear(state);
     flint_cleanup();
     flint_printf("PASS\n");
@@ -0,0 +1,95 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_poly.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("mullow_threaded....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 20 * arb_test_multiplier(); iter++)
+    {
+        arb_poly_t a, b, c, d;
+        slong len, n, prec, bits, num_threads;
+        int squaring;
+
+        squaring = n_randint(state, 2);
+
+        if (n_randint(state, 4) == 0)
+        {
+            /* the shortest split product, with so many threads
+               that the highest pieces lie beyond the truncation */
+            len = n = 256;
+            prec = 4000 + n_randint(state, 1000);
+            bits = 4000 + n_randint(state, 1000);
+            num_threads = 150 + n_randint(state, 100);
+        }
+        else
+        {
+            len = 256 + n_randint(state, 1000);
+            n = 1 + n_randint(state, 2 * len);
+            prec = 2 + n_randint(state, 3000);
+            bits = 2 + n_randint(state, 3000);
+            num_threads = 2 + n_randint(state, 7);
+        }
+
+        arb_poly_init(a);
+        arb_poly_init(b);
+        arb_poly_init(c);
+        arb_poly_init(d);
+
+        arb_poly_randtest(a, state, len, bits, 5);
+        arb_poly_randtest(b, state, len - n_randint(state, len / 2), bits, 5);
+
+        if (squaring)
+            arb_poly_set(b, a);
+
+        flint_set_num_threads(1);
+        if (squaring)
+            arb_poly_mullow(c, a, a, n, prec);
+        else
+            arb_poly_mullow(c, a, b, n, prec);
+
+        flint_set_num_threads(num_threads);
+        if (squaring)
+            arb_poly_mullow(d, a, a, n, prec);
+        else
+            arb_poly_mullow(d, a, b, n, prec);
+
+        if (!arb_poly_equal(c, d))
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("len = %wd, n = %wd, prec = %wd, squaring = %d, threads = %wd\n\n",
+                len, n, prec, squaring, num_threads);
+            flint_printf("a = "); arb_poly_printd(a, 15); flint_printf("\n\n");
+            flint_printf("b = "); arb_poly_printd(b, 15); flint_printf("\n\n");
+            flint_printf("c = "); arb_poly_printd(c, 15); flint_printf("\n\n");
+            flint_printf("d = "); arb_poly_printd(d, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        arb_poly_clear(a);
+        arb_poly_clear(b);
+        arb_poly_clear(c);
+        arb_poly_clear(d);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_poly.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("multipoint....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 1000 * arb_test_multiplier(); iter++)
+    {
+        arb_poly_multipoint_t mp;
+        arb_poly_struct * polys;
+        arb_poly_t g, h;
+        arb_ptr x, y, z;
+        slong i, j, n, num, prec;
+
+        n = n_randint(state, 40);
+        num = 1 + n_randint(state, 5);
+        prec = 2 + n_randint(state, 200);
+
+        if (n_randint(state, 10) == 0)
+            flint_set_num_threads(1 + n_randint(state, 4));
+        else
+            flint_set_num_threads(1);
+
+        polys = flint_malloc(sizeof(arb_poly_struct) * num);
+        for (j = 0; j < num; j++)
+        {
+            arb_poly_init(polys + j);
+            arb_poly_randtest(polys + j, state, n_randint(state, 50), 1 + n_randint(state, 200), 5);
+        }
+
+        arb_poly_init(g);
+        arb_poly_init(h);
+        x = _arb_vec_init(n);
+        y = _arb_vec_init(n * num);
+        z = _arb_vec_init(n);
+
+        for (i = 0; i < n; i++)
+            arb_randtest(x + i, state, 1 + n_randint(state, 200), 3);
+
+        arb_poly_multipoint_init(mp, x, n, prec);
+
+        if (n != 0 && arb_poly_multipoint_allocated_bytes(mp) <= 0)
+        {
+            flint_printf("FAIL (allocated_bytes)\n\n");
+            flint_abort();
+        }
+
+        arb_poly_multipoint_evaluate_vec(y, mp, polys, num, prec);
+
+        for (j = 0; j < num; j++)
+        {
+            arb_poly_evaluate_vec_fast(z, polys + j, x, n, prec);
+
+            for (i = 0; i < n; i++)
+            {
+                if (!arb_equal(y + j * n + i, z + i))
+                {
+                    flint_printf("FAIL (evaluation)\n\n");
+                    flint_printf("n = %wd, j = %wd, i = %wd\n\n", n, j, i);
+                    flint_printf("y = "); arb_printd(y + j * n + i, 15); flint_printf("\n\n");
+                    flint_printf("z = "); arb_printd(z + i, 15); flint_printf("\n\n");
+                    flint_abort();
+                }
+            }
+        }
+
+        arb_poly_multipoint_interpolate(g, mp, y, prec);
+        arb_poly_interpolate_fast(h, x, y, n, prec);
+
+        if (!arb_poly_equal(g, h))
+        {
+            flint_printf("FAIL (interpolation)\n\n");
+            flint_printf("g = "); arb_poly_printd(g, 15); flint_printf("\n\n");
+            flint_printf("h = "); arb_poly_printd(h, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        /* interpolating the values of a short polynomial recovers it */
+        if (n != 0 && polys[0].length <= n && !arb_poly_contains(g, polys + 0))
+        {
+            flint_printf("FAIL (containment)\n\n");
+            flint_printf("f = "); arb_poly_printd(polys + 0, 15); flint_printf("\n\n");
+            flint_printf("g = "); arb_poly_printd(g, 15); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        arb_poly_multipoint_clear(mp);
+
+        for (j = 0; j < num; j++)
+            arb_poly_clear(polys + j);
+        flint_free(polys);
+
+        arb_poly_clear(g);
+        arb_poly_clear(h);
+        _arb_vec_clear(x, n);
+        _arb_vec_clear(y, n * num);
+        _arb_vec_clear(z, n);
+    }
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ARB_SOA_H
+#define ARB_SOA_H
+
+#ifdef ARB_SOA_INLINES_C
+#define ARB_SOA_INLINE
+#else
+#define ARB_SOA_INLINE static __inline__
+#endif
+
+#include <stdint.h>
+#include "arb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Vectors of balls stored as separate arrays of midpoints, radius
+  mantissas and radius exponents. A radius mantissa is either zero
+  (in which case the exponent is zero) or has exactly MAG_BITS bits.
+  All radius exponents are lagom, which means that the radius kernels
+  can work with word-size exponents and fixed-width integers only.
+*/
+
+typedef struct
+{
+    arf_ptr mid;
+    uint32_t * rad_man;
+    slong * rad_exp;
+    slong length;
+    slong alloc;
+}
+arb_soa_struct;
+
+typedef arb_soa_struct arb_soa_t[1];
+
+#define arb_soa_midref(x, i) ((x)->mid + (i))
+
+void arb_soa_init(arb_soa_t x);
+void arb_soa_clear(arb_soa_t x);
+void arb_soa_fit_length(arb_soa_t x, slong len);
+
+int arb_soa_set_vec(arb_soa_t x, arb_srcptr v, slong len);
+void arb_soa_get_vec(arb_ptr v, const arb_soa_t x);
+
+/* conversions of single radii; the input is assumed to be lagom */
+
+ARB_SOA_INLINE void
+_arb_soa_rad_set_mag(uint32_t * man, slong * exp, const mag_t x)
+{
+    *man = MAG_MAN(x);
+    *exp = (MAG_MAN(x) == 0) ? 0 : MAG_EXP(x);
+}
+
+ARB_SOA_INLINE void
+_arb_soa_rad_set_arf(uint32_t * man, slong * exp, const arf_t x)
+{
+    mag_t t;
+    mag_fast_init_set_arf(t, x);
+    _arb_soa_rad_set_mag(man, exp, t);
+}
+
+ARB_SOA_INLINE void
+_arb_soa_rad_get_mag(mag_t x, uint32_t man, slong exp)
+{
+    if (man == 0)
+    {
+        mag_zero(x);
+    }
+    else
+    {
+        _fmpz_demote(MAG_EXPREF(x));
+        if (exp >= MAG_MIN_LAGOM_EXP && exp <= MAG_MAX_LAGOM_EXP)
+            MAG_EXP(x) = exp;
+        else
+            fmpz_set_si(MAG_EXPREF(x), exp);
+        MAG_MAN(x) = man;
+    }
+}
+
+int _arb_soa_rad_set_arb_rad(uint32_t * man, slong * exp, arb_srcptr x, slong len);
+int _arb_soa_rad_set_arb_mid(uint32_t * man, slong * exp, arb_srcptr x, slong len);
+
+/* radius kernels */
+
+void _arb_soa_rad_add(uint32_t * zman, slong * zexp,
+    const uint32_t * xman, const slong * xexp,
+    const uint32_t * yman, const slong * yexp, slong len);
+
+void _arb_soa_rad_mul(uint32_t * zman, slong * zexp,
+    const uint32_t * xman, const slong * xexp,
+    const uint32_t * yman, const slong * yexp, slong len);
+
+void _arb_soa_rad_dot(mag_t res,
+    const uint32_t * xman, const slong * xexp,
+    const uint32_t * yman, const slong * yexp, slong len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,24 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+void
+arb_soa_get_vec(arb_ptr v, const arb_soa_t x)
+{
+    slong i;
+
+    for (i = 0; i < x->length; i++)
+    {
+        arf_set(arb_midref(v + i), x->mid + i);
+        _arb_soa_rad_get_mag(arb_radref(v + i), x->rad_man[i], x->rad_exp[i]);
+    }
+}
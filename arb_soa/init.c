@@ -0,0 +1,60 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+void
+arb_soa_init(arb_soa_t x)
+{
+    x->mid = NULL;
+    x->rad_man = NULL;
+    x->rad_exp = NULL;
+    x->length = 0;
+    x->alloc = 0;
+}
+
+void
+arb_soa_clear(arb_soa_t x)
+{
+    slong i;
+
+    for (i = 0; i < x->alloc; i++)
+        arf_clear(x->mid + i);
+
+    flint_free(x->mid);
+    flint_free(x->rad_man);
+    flint_free(x->rad_exp);
+}
+
+void
+arb_soa_fit_length(arb_soa_t x, slong len)
+{
+    slong i;
+
+    if (len > x->alloc)
+    {
+        if (len < 2 * x->alloc)
+            len = 2 * x->alloc;
+
+        x->mid = flint_realloc(x->mid, len * sizeof(arf_struct));
+        x->rad_man = flint_realloc(x->rad_man, len * sizeof(uint32_t));
+        x->rad_exp = flint_realloc(x->rad_exp, len * sizeof(slong));
+
+        for (i = x->alloc; i < len; i++)
+        {
+            arf_init(x->mid + i);
+            x->rad_man[i] = 0;
+            x->rad_exp[i] = 0;
+        }
+
+        x->alloc = len;
+    }
+}
@@ -0,0 +1,45 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+/* The loop body is branch-free so that the compiler can vectorize it;
+   zero inputs are masked out instead of being special-cased. */
+void
+_arb_soa_rad_add(uint32_t * zman, slong * zexp,
+    const uint32_t * xman, const slong * xexp,
+    const uint32_t * yman, const slong * yexp, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+    {
+        uint32_t a, b, m, c;
+        slong e, sa, sb;
+
+        a = xman[i];
+        b = yman[i];
+
+        e = (a == 0) ? yexp[i] : ((b == 0) ? xexp[i] : FLINT_MAX(xexp[i], yexp[i]));
+        sa = (a == 0) ? 0 : FLINT_MIN(e - xexp[i], 31);
+        sb = (b == 0) ? 0 : FLINT_MIN(e - yexp[i], 31);
+
+        /* round up the operand that gets shifted */
+        m = ((a >> sa) + (sa != 0)) + ((b >> sb) + (sb != 0));
+
+        /* m has MAG_BITS or MAG_BITS + 1 bits, and is not all ones */
+        c = m >> MAG_BITS;
+        m = (m >> c) + (c & m);
+
+        zman[i] = m;
+        zexp[i] = (m == 0) ? 0 : e + (slong) c;
+    }
+}
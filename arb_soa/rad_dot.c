@@ -0,0 +1,61 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+void
+_arb_soa_rad_dot(mag_t res,
+    const uint32_t * xman, const slong * xexp,
+    const uint32_t * yman, const slong * yexp, slong len)
+{
+    slong i, emax, e, g;
+    uint64_t s;
+
+    /* exponent of the largest product */
+    emax = WORD_MIN;
+    for (i = 0; i < len; i++)
+    {
+        e = (xman[i] == 0 || yman[i] == 0) ? WORD_MIN : xexp[i] + yexp[i];
+        emax = FLINT_MAX(emax, e);
+    }
+
+    if (emax == WORD_MIN)
+    {
+        mag_zero(res);
+        return;
+    }
+
+    /* leave room for len terms, each smaller than 2^(2 MAG_BITS - g) + 1 */
+    g = FLINT_BIT_COUNT(len);
+
+    s = 0;
+    for (i = 0; i < len; i++)
+    {
+        uint64_t p;
+        slong shift;
+
+        p = (uint64_t) xman[i] * (uint64_t) yman[i];
+        shift = (p == 0) ? 63 : FLINT_MIN(emax - xexp[i] - yexp[i] + g, 63);
+        s += (p >> shift) + (p != 0);
+    }
+
+    e = emax - 2 * MAG_BITS + g;
+
+#if FLINT_BITS != 64
+    while ((s >> (FLINT_BITS - 1)) != 0)
+    {
+        s = (s >> 1) + 1;
+        e++;
+    }
+#endif
+
+    mag_set_ui_2exp_si(res, s, e);
+}
@@ -0,0 +1,36 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+void
+_arb_soa_rad_mul(uint32_t * zman, slong * zexp,
+    const uint32_t * xman, const slong * xexp,
+    const uint32_t * yman, const slong * yexp, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+    {
+        uint64_t p;
+        uint32_t m, c, d;
+
+        /* p has 2 MAG_BITS - 1 or 2 MAG_BITS bits, or is zero */
+        p = (uint64_t) xman[i] * (uint64_t) yman[i];
+        c = p >> (2 * MAG_BITS - 1);
+        m = (uint32_t) (p >> (MAG_BITS - 1 + c)) + 1;
+        d = m >> MAG_BITS;
+        m = (m >> d) + (d & m);
+
+        zman[i] = (p == 0) ? 0 : m;
+        zexp[i] = (p == 0) ? 0 : xexp[i] + yexp[i] - 1 + (slong) (c + d);
+    }
+}
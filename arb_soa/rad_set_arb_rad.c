@@ -0,0 +1,37 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+int
+_arb_soa_rad_set_arb_rad(uint32_t * man, slong * exp, arb_srcptr x, slong len)
+{
+    slong i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (mag_is_zero(arb_radref(x + i)))
+        {
+            man[i] = 0;
+            exp[i] = 0;
+        }
+        else if (MAG_IS_LAGOM(arb_radref(x + i)))
+        {
+            _arb_soa_rad_set_mag(man + i, exp + i, arb_radref(x + i));
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
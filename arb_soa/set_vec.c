@@ -0,0 +1,32 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+int
+arb_soa_set_vec(arb_soa_t x, arb_srcptr v, slong len)
+{
+    slong i;
+
+    arb_soa_fit_length(x, len);
+
+    if (!_arb_soa_rad_set_arb_rad(x->rad_man, x->rad_exp, v, len))
+    {
+        x->length = 0;
+        return 0;
+    }
+
+    for (i = 0; i < len; i++)
+        arf_set(x->mid + i, arb_midref(v + i));
+
+    x->length = len;
+    return 1;
+}
@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("rad_add....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000 * arb_test_multiplier(); iter++)
+    {
+        uint32_t *xman, *yman, *zman;
+        slong *xexp, *yexp, *zexp;
+        mag_ptr x, y;
+        mag_t z;
+        arf_t t, u, v;
+        slong i, len;
+        int aliasing;
+
+        len = n_randint(state, 20);
+        aliasing = n_randint(state, 2);
+
+        xman = flint_malloc(sizeof(uint32_t) * (len + 1));
+        yman = flint_malloc(sizeof(uint32_t) * (len + 1));
+        zman = flint_malloc(sizeof(uint32_t) * (len + 1));
+        xexp = flint_malloc(sizeof(slong) * (len + 1));
+        yexp = flint_malloc(sizeof(slong) * (len + 1));
+        zexp = flint_malloc(sizeof(slong) * (len + 1));
+        x = _mag_vec_init(len);
+        y = _mag_vec_init(len);
+        mag_init(z);
+        arf_init(t);
+        arf_init(u);
+        arf_init(v);
+
+        for (i = 0; i < len; i++)
+        {
+            mag_randtest(x + i, state, 1 + n_randint(state, 10));
+            mag_randtest(y + i, state, 1 + n_randint(state, 10));
+            _arb_soa_rad_set_mag(xman + i, xexp + i, x + i);
+            _arb_soa_rad_set_mag(yman + i, yexp + i, y + i);
+        }
+
+        if (aliasing)
+        {
+            _arb_soa_rad_add(xman, xexp, xman, xexp, yman, yexp, len);
+            for (i = 0; i < len; i++)
+            {
+                zman[i] = xman[i];
+                zexp[i] = xexp[i];
+            }
+        }
+        else
+        {
+            _arb_soa_rad_add(zman, zexp, xman, xexp, yman, yexp, len);
+        }
+
+        for (i = 0; i < len; i++)
+        {
+            _arb_soa_rad_get_mag(z, zman[i], zexp[i]);
+
+            if (zman[i] != 0 && FLINT_BIT_COUNT(zman[i]) != MAG_BITS)
+            {
+                flint_printf("FAIL (normalization)\n\n");
+                flint_abort();
+            }
+
+            arf_set_mag(t, x + i);
+            arf_set_mag(u, y + i);
+            arf_add(t, t, u, ARF_PREC_EXACT, ARF_RND_DOWN);
+
+            /* v = t (1 + 2^-26) */
+            arf_mul_2exp_si(v, t, -26);
+            arf_add(v, v, t, ARF_PREC_EXACT, ARF_RND_DOWN);
+            arf_set_mag(u, z);
+
+            if (arf_cmp(u, t) < 0 || arf_cmp(u, v) > 0)
+            {
+                flint_printf("FAIL\n\n");
+                flint_printf("x = "); mag_printd(x + i, 10); flint_printf("\n\n");
+                flint_printf("y = "); mag_printd(y + i, 10); flint_printf("\n\n");
+                flint_printf("z = "); mag_printd(z, 10); flint_printf("\n\n");
+                flint_abort();
+            }
+        }
+
+        flint_free(xman);
+        flint_free(yman);
+        flint_free(zman);
+        flint_free(xexp);
+        flint_free(yexp);
+        flint_free(zexp);
+        _mag_vec_clear(x, len);
+        _mag_vec_clear(y, len);
+        mag_clear(z);
+        arf_clear(t);
+        arf_clear(u);
+        arf_clear(v);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("rad_dot....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000 * arb_test_multiplier(); iter++)
+    {
+        uint32_t *xman, *yman;
+        slong *xexp, *yexp;
+        mag_ptr x, y;
+        mag_t z;
+        arf_t s, t, u, v;
+        slong i, len;
+
+        len = n_randint(state, 100);
+
+        xman = flint_malloc(sizeof(uint32_t) * (len + 1));
+        yman = flint_malloc(sizeof(uint32_t) * (len + 1));
+        xexp = flint_malloc(sizeof(slong) * (len + 1));
+        yexp = flint_malloc(sizeof(slong) * (len + 1));
+        x = _mag_vec_init(len);
+        y = _mag_vec_init(len);
+        mag_init(z);
+        arf_init(s);
+        arf_init(t);
+        arf_init(u);
+        arf_init(v);
+
+        for (i = 0; i < len; i++)
+        {
+            mag_randtest(x + i, state, 1 + n_randint(state, 10));
+            mag_randtest(y + i, state, 1 + n_randint(state, 10));
+            _arb_soa_rad_set_mag(xman + i, xexp + i, x + i);
+            _arb_soa_rad_set_mag(yman + i, yexp + i, y + i);
+        }
+
+        _arb_soa_rad_dot(z, xman, xexp, yman, yexp, len);
+
+        arf_zero(s);
+        for (i = 0; i < len; i++)
+        {
+            arf_set_mag(t, x + i);
+            arf_set_mag(u, y + i);
+            arf_addmul(s, t, u, ARF_PREC_EXACT, ARF_RND_DOWN);
+        }
+
+        /* v = s (1 + 2^-26) */
+        arf_mul_2exp_si(v, s, -26);
+        arf_add(v, v, s, ARF_PREC_EXACT, ARF_RND_DOWN);
+        arf_set_mag(u, z);
+
+        if (arf_cmp(u, s) < 0 || arf_cmp(u, v) > 0)
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("len = %wd\n\n", len);
+            flint_printf("s = "); arf_printd(s, 10); flint_printf("\n\n");
+            flint_printf("z = "); mag_printd(z, 10); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        flint_free(xman);
+        flint_free(yman);
+        flint_free(xexp);
+        flint_free(yexp);
+        _mag_vec_clear(x, len);
+        _mag_vec_clear(y, len);
+        mag_clear(z);
+        arf_clear(s);
+        arf_clear(t);
+        arf_clear(u);
+        arf_clear(v);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
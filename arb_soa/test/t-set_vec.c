@@ -0,0 +1,105 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arb_soa.h"
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("set_vec....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    for (iter = 0; iter < 10000 * arb_test_multiplier(); iter++)
+    {
+        arb_soa_t x;
+        arb_ptr v, w;
+        slong i, len;
+        int lagom, success;
+
+        len = n_randint(state, 20);
+        v = _arb_vec_init(len);
+        w = _arb_vec_init(len);
+        arb_soa_init(x);
+
+        /* fill with garbage first to test reuse */
+        if (n_randint(state, 2))
+        {
+            arb_soa_fit_length(x, n_randint(state, 30));
+            for (i = 0; i < len; i++)
+                arb_randtest(v + i, state, 1 + n_randint(state, 200), 10);
+            arb_soa_set_vec(x, v, len);
+        }
+
+        lagom = 1;
+        for (i = 0; i < len; i++)
+        {
+            if (n_randint(state, 10) == 0)
+                arb_randtest_special(v + i, state, 1 + n_randint(state, 200), 1 + n_randint(state, 100));
+            else
+                arb_randtest(v + i, state, 1 + n_randint(state, 200), 10);
+
+            if (!mag_is_zero(arb_radref(v + i)) && !MAG_IS_LAGOM(arb_radref(v + i)))
+                lagom = 0;
+        }
+
+        success = arb_soa_set_vec(x, v, len);
+
+        if (success != lagom)
+        {
+            flint_printf("FAIL (lagom)\n\n");
+            flint_abort();
+        }
+
+        if (success)
+        {
+            if (x->length != len)
+            {
+                flint_printf("FAIL (length)\n\n");
+                flint_abort();
+            }
+
+            for (i = 0; i < len; i++)
+            {
+                if (x->rad_man[i] == 0 && x->rad_exp[i] != 0)
+                {
+                    flint_printf("FAIL (zero radius)\n\n");
+                    flint_abort();
+                }
+            }
+
+            arb_soa_get_vec(w, x);
+
+            for (i = 0; i < len; i++)
+            {
+                if (!arb_equal(v + i, w + i) && !arf_is_nan(arb_midref(v + i)))
+                {
+                    flint_printf("FAIL (roundtrip)\n\n");
+                    flint_printf("v = "); arb_printd(v + i, 30); flint_printf("\n\n");
+                    flint_printf("w = "); arb_printd(w + i, 30); flint_printf("\n\n");
+                    flint_abort();
+                }
+            }
+        }
+
+        _arb_vec_clear(v, len);
+        _arb_vec_clear(w, len);
+        arb_soa_clear(x);
+    }
+
+    flint_randclear(state);
+    flint_cleanup();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -169,10 +169,25 @@ typedef arf_struct arf_t[1];
 typedef arf_struct * arf_ptr;
 typedef const arf_struct * arf_srcptr;
 
+ARB_DLL extern int arf_use_limb_cache;
+
+/* Allocation hook used by arenas (arb_arena_t). If set, _arf_promote
+   first asks the hook for a mantissa; the hook returns NULL or a pointer
+   to at least *n limbs, setting *n to the capacity. Such mantissas are
+   marked by a negative ARF_PTR_ALLOC (minus the capacity) and are never
+   freed or reallocated by arf functions. */
+extern TLS_PREFIX mp_ptr (* _arf_arena_alloc)(const arf_struct * x, mp_size_t * n);
+
 void _arf_promote(arf_t x, mp_size_t n);
 
 void _arf_demote(arf_t x);
 
+void _arf_grow(arf_t x, mp_size_t n);
+
+void arf_limb_cache_stats(ulong * hits, ulong * misses, slong * bytes);
+
+void arf_limb_cache_clear(void);
+
 
 /* Warning: does not set size! -- also doesn't demote exponent. */
 #define ARF_DEMOTE(x)                 \
@@ -217,10 +232,7 @@ void _arf_demote(arf_t x);
             }                                               \
             else if (ARF_PTR_ALLOC(x) < (__xn))             \
             {                                               \
-                ARF_PTR_D(x) = (mp_ptr)                     \
-                        flint_realloc(ARF_PTR_D(x),         \
-                        (xn) * sizeof(mp_limb_t));          \
-                ARF_PTR_ALLOC(x) = (__xn);                  \
+                _arf_grow(x, __xn);                         \
             }                                               \
             xptr = ARF_PTR_D(x);                            \
         }                                                   \
@@ -1295,7 +1307,7 @@ arf_allocated_bytes(const arf_t x)
 {
     slong size = fmpz_allocated_bytes(ARF_EXPREF(x));
 
-    if (ARF_HAS_PTR(x))
+    if (ARF_HAS_PTR(x) && ARF_PTR_ALLOC(x) > 0)
         size += ARF_PTR_ALLOC(x) * sizeof(mp_limb_t);
 
     return size;
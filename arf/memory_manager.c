@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2014 Fredrik Johansson
+    Copyright (C) 2014, 2022 Fredrik Johansson
 
     This file is part of Arb.
 
@@ -9,58 +9,241 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <pthread.h>
 #include "arf.h"
 
-#define ARF_USE_CACHE 0
+/*
+  Limb cache. Blocks are sorted into size classes; class c holds blocks
+  of at least ARF_CACHE_MIN_LIMBS << c limbs (the exact allocation is
+  stored in the first limb while the block sits in the cache). Each thread
+  keeps a bounded stack of blocks per class. When a stack overflows, half
+  of it is moved to a shared depot (or freed if the depot is full), and
+  when a stack runs empty it is refilled from the depot. This way, blocks
+  released by a different thread than the one that allocated them find
+  their way back into circulation instead of accumulating.
+
+  Blocks are plain flint_malloc blocks, so they can be reallocated and
+  freed normally after leaving the cache.
+*/
+
+#define ARF_CACHE_CLASSES 5
+#define ARF_CACHE_MIN_LIMBS 4
+#define ARF_MAX_CACHE_LIMBS (ARF_CACHE_MIN_LIMBS << (ARF_CACHE_CLASSES - 1))
+#define ARF_CACHE_THREAD_BLOCKS 64
+#define ARF_CACHE_BATCH (ARF_CACHE_THREAD_BLOCKS / 2)
+#define ARF_CACHE_DEPOT_BLOCKS 1024
 
-#define ARF_MAX_CACHE_LIMBS 64
+int arf_use_limb_cache = 0;
 
-FLINT_TLS_PREFIX mp_ptr * arf_free_arr = NULL;
-FLINT_TLS_PREFIX ulong arf_free_num = 0;
-FLINT_TLS_PREFIX ulong arf_free_alloc = 0;
+TLS_PREFIX mp_ptr (* _arf_arena_alloc)(const arf_struct * x, mp_size_t * n) = NULL;
+
+FLINT_TLS_PREFIX mp_ptr arf_cache_arr[ARF_CACHE_CLASSES][ARF_CACHE_THREAD_BLOCKS];
+FLINT_TLS_PREFIX slong arf_cache_num[ARF_CACHE_CLASSES];
+FLINT_TLS_PREFIX slong arf_cache_bytes = 0;
+FLINT_TLS_PREFIX ulong arf_cache_hits = 0;
+FLINT_TLS_PREFIX ulong arf_cache_misses = 0;
 FLINT_TLS_PREFIX int arf_have_registered_cleanup = 0;
 
+static pthread_mutex_t arf_depot_lock = PTHREAD_MUTEX_INITIALIZER;
+static mp_ptr * arf_depot_arr[ARF_CACHE_CLASSES];
+static slong arf_depot_num[ARF_CACHE_CLASSES];
+static slong arf_depot_bytes = 0;
+static int arf_depot_have_registered_cleanup = 0;
+
+/* smallest class whose blocks can hold n limbs, 2 < n <= max */
+#define ARF_CACHE_CLASS_CEIL(n) \
+    (FLINT_MAX(FLINT_BIT_COUNT((n) - 1), 2) - 2)
+
+/* largest class whose minimum size is at most n, min <= n <= max */
+#define ARF_CACHE_CLASS_FLOOR(n) \
+    (FLINT_BIT_COUNT(n) - 3)
+
+/* assumes that the depot lock is held */
+static void
+_arf_depot_clear(void)
+{
+    slong c, i;
+
+    for (c = 0; c < ARF_CACHE_CLASSES; c++)
+    {
+        for (i = 0; i < arf_depot_num[c]; i++)
+            flint_free(arf_depot_arr[c][i]);
+
+        flint_free(arf_depot_arr[c]);
+        arf_depot_arr[c] = NULL;
+        arf_depot_num[c] = 0;
+    }
+
+    arf_depot_bytes = 0;
+}
+
+static void
+_arf_depot_cleanup(void)
+{
+    pthread_mutex_lock(&arf_depot_lock);
+    _arf_depot_clear();
+    arf_depot_have_registered_cleanup = 0;
+    pthread_mutex_unlock(&arf_depot_lock);
+}
+
+static void
+_arf_cache_free(void)
+{
+    slong c, i;
+
+    for (c = 0; c < ARF_CACHE_CLASSES; c++)
+    {
+        for (i = 0; i < arf_cache_num[c]; i++)
+            flint_free(arf_cache_arr[c][i]);
+
+        arf_cache_num[c] = 0;
+    }
+
+    arf_cache_bytes = 0;
+}
+
 void _arf_cleanup(void)
 {
-    slong i;
-    for (i = 0; i < arf_free_num; i++)
-        flint_free(arf_free_arr[i]);
+    _arf_cache_free();
+    arf_have_registered_cleanup = 0;
+}
 
-    flint_free(arf_free_arr);
+void
+arf_limb_cache_clear(void)
+{
+    _arf_cache_free();
 
-    arf_free_arr = NULL;
-    arf_free_num = 0;
-    arf_free_alloc = 0;
+    pthread_mutex_lock(&arf_depot_lock);
+    _arf_depot_clear();
+    pthread_mutex_unlock(&arf_depot_lock);
 }
 
 void
-_arf_promote(arf_t x, mp_size_t n)
+arf_limb_cache_stats(ulong * hits, ulong * misses, slong * bytes)
 {
-    if (ARF_USE_CACHE && n <= ARF_MAX_CACHE_LIMBS && arf_free_num != 0)
+    if (hits != NULL)
+        *hits = arf_cache_hits;
+
+    if (misses != NULL)
+        *misses = arf_cache_misses;
+
+    if (bytes != NULL)
     {
-        mp_ptr ptr;
-        mp_size_t alloc;
+        pthread_mutex_lock(&arf_depot_lock);
+        *bytes = arf_cache_bytes + arf_depot_bytes;
+        pthread_mutex_unlock(&arf_depot_lock);
+    }
+}
+
+/* move ARF_CACHE_BATCH blocks from the thread stack to the depot */
+static void
+_arf_cache_flush(int c)
+{
+    slong i, n;
+    mp_ptr ptr;
 
-        ptr = arf_free_arr[--arf_free_num];
-        alloc = ptr[0];
+    pthread_mutex_lock(&arf_depot_lock);
 
-        if (alloc >= n)
+    if (arf_depot_arr[c] == NULL)
+    {
+        if (!arf_depot_have_registered_cleanup)
         {
-            ARF_PTR_ALLOC(x) = ptr[0];
-            ARF_PTR_D(x) = ptr;
+            flint_register_cleanup_function(_arf_depot_cleanup);
+            arf_depot_have_registered_cleanup = 1;
+        }
+
+        arf_depot_arr[c] = flint_malloc(ARF_CACHE_DEPOT_BLOCKS * sizeof(mp_ptr));
+    }
+
+    for (i = 0; i < ARF_CACHE_BATCH; i++)
+    {
+        ptr = arf_cache_arr[c][--arf_cache_num[c]];
+        n = ptr[0] * sizeof(mp_limb_t);
+        arf_cache_bytes -= n;
+
+        if (arf_depot_num[c] < ARF_CACHE_DEPOT_BLOCKS)
+        {
+            arf_depot_arr[c][arf_depot_num[c]++] = ptr;
+            arf_depot_bytes += n;
         }
         else
         {
-            ptr = flint_realloc(ptr, n * sizeof(mp_limb_t));
-            ARF_PTR_ALLOC(x) = n;
+            flint_free(ptr);
+        }
+    }
+
+    pthread_mutex_unlock(&arf_depot_lock);
+}
+
+/* move up to ARF_CACHE_BATCH blocks from the depot to the thread stack */
+static void
+_arf_cache_refill(int c)
+{
+    slong i, n;
+    mp_ptr ptr;
+
+    pthread_mutex_lock(&arf_depot_lock);
+
+    n = FLINT_MIN(arf_depot_num[c], ARF_CACHE_BATCH);
+
+    for (i = 0; i < n; i++)
+    {
+        ptr = arf_depot_arr[c][--arf_depot_num[c]];
+        arf_depot_bytes -= ptr[0] * sizeof(mp_limb_t);
+        arf_cache_bytes += ptr[0] * sizeof(mp_limb_t);
+        arf_cache_arr[c][arf_cache_num[c]++] = ptr;
+    }
+
+    pthread_mutex_unlock(&arf_depot_lock);
+}
+
+void
+_arf_promote(arf_t x, mp_size_t n)
+{
+    if (_arf_arena_alloc != NULL)
+    {
+        mp_ptr ptr;
+        mp_size_t alloc = n;
+
+        ptr = _arf_arena_alloc(x, &alloc);
+
+        if (ptr != NULL)
+        {
+            ARF_PTR_ALLOC(x) = -alloc;
             ARF_PTR_D(x) = ptr;
+            return;
         }
     }
-    else
+
+    if (arf_use_limb_cache && n <= ARF_MAX_CACHE_LIMBS)
     {
-        ARF_PTR_ALLOC(x) = n;
-        ARF_PTR_D(x) = flint_malloc(n * sizeof(mp_limb_t));
+        int c;
+        mp_ptr ptr;
+
+        c = ARF_CACHE_CLASS_CEIL(n);
+
+        if (arf_cache_num[c] == 0)
+            _arf_cache_refill(c);
+
+        if (arf_cache_num[c] != 0)
+        {
+            ptr = arf_cache_arr[c][--arf_cache_num[c]];
+            arf_cache_bytes -= ptr[0] * sizeof(mp_limb_t);
+            arf_cache_hits++;
+
+            ARF_PTR_ALLOC(x) = ptr[0];
+            ARF_PTR_D(x) = ptr;
+            return;
+        }
+
+        arf_cache_misses++;
+
+        /* allocate the full class size so that the block can be reused */
+        n = ARF_CACHE_MIN_LIMBS << c;
     }
+
+    ARF_PTR_ALLOC(x) = n;
+    ARF_PTR_D(x) = flint_malloc(n * sizeof(mp_limb_t));
 }
 
 void
@@ -72,23 +255,29 @@ _arf_demote(arf_t x)
     alloc = ARF_PTR_ALLOC(x);
     ptr = ARF_PTR_D(x);
 
-    if (ARF_USE_CACHE && alloc <= ARF_MAX_CACHE_LIMBS)
+    /* owned by an arena */
+    if (alloc < 0)
+        return;
+
+    if (arf_use_limb_cache && alloc >= ARF_CACHE_MIN_LIMBS
+        && alloc <= ARF_MAX_CACHE_LIMBS)
     {
-        if (arf_free_num == arf_free_alloc)
+        int c;
+
+        if (!arf_have_registered_cleanup)
         {
-            if (!arf_have_registered_cleanup)
-            {
-                flint_register_cleanup_function(_arf_cleanup);
-                arf_have_registered_cleanup = 1;
-            }
-
-            arf_free_alloc = FLINT_MAX(64, arf_free_alloc * 2);
-            arf_free_arr = flint_realloc(arf_free_arr,
-                arf_free_alloc * sizeof(mp_ptr));
+            flint_register_cleanup_function(_arf_cleanup);
+            arf_have_registered_cleanup = 1;
         }
 
+        c = ARF_CACHE_CLASS_FLOOR(alloc);
+
+        if (arf_cache_num[c] == ARF_CACHE_THREAD_BLOCKS)
+            _arf_cache_flush(c);
+
         ptr[0] = alloc;
-        arf_free_arr[arf_free_num++] = ptr;
+        arf_cache_arr[c][arf_cache_num[c]++] = ptr;
+        arf_cache_bytes += alloc * sizeof(mp_limb_t);
     }
     else
     {
@@ -96,3 +285,28 @@ _arf_demote(arf_t x)
     }
 }
 
+void
+_arf_grow(arf_t x, mp_size_t n)
+{
+    mp_size_t alloc = ARF_PTR_ALLOC(x);
+
+    if (alloc < 0)
+    {
+        mp_ptr ptr;
+
+        if (-alloc >= n)
+            return;
+
+        /* move out of the arena storage, preserving the contents
+           like flint_realloc */
+        ptr = ARF_PTR_D(x);
+        _arf_promote(x, n);
+        flint_mpn_copyi(ARF_PTR_D(x), ptr, -alloc);
+    }
+    else
+    {
+        ARF_PTR_D(x) = (mp_ptr) flint_realloc(ARF_PTR_D(x),
+            n * sizeof(mp_limb_t));
+        ARF_PTR_ALLOC(x) = n;
+    }
+}
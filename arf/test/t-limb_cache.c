@@ -0,0 +1,143 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "arf.h"
+
+typedef struct
+{
+    arf_ptr v;
+    slong len;
+}
+work_t;
+
+/* releases the blocks in a different thread than where they were allocated */
+static void
+clear_worker(slong i, void * arg)
+{
+    work_t * work = (work_t *) arg;
+    arf_clear(work->v + i);
+}
+
+int main()
+{
+    slong iter;
+    flint_rand_t state;
+
+    flint_printf("limb_cache....");
+    fflush(stdout);
+
+    flint_randinit(state);
+
+    /* results must not depend on the cache */
+    for (iter = 0; iter < 10000 * arb_test_multiplier(); iter++)
+    {
+        arf_t x, y, z1, z2;
+        slong prec;
+        arf_rnd_t rnd;
+
+        arf_init(x);
+        arf_init(y);
+        arf_init(z1);
+        arf_init(z2);
+
+        prec = 2 + n_randint(state, 80 * FLINT_BITS);
+        rnd = n_randint(state, 5);
+
+        arf_randtest(x, state, 2 + n_randint(state, 80 * FLINT_BITS), 10);
+        arf_randtest(y, state, 2 + n_randint(state, 80 * FLINT_BITS), 10);
+
+        arf_use_limb_cache = 0;
+        arf_mul(z1, x, y, prec, rnd);
+        arf_add(z1, z1, x, prec, rnd);
+
+        arf_use_limb_cache = n_randint(state, 8) != 0;
+        arf_set_round(z2, z1, 2 + n_randint(state, 3 * FLINT_BITS), rnd);
+        arf_mul(z2, x, y, prec, rnd);
+        arf_add(z2, z2, x, prec, rnd);
+
+        if (!arf_equal(z1, z2))
+        {
+            flint_printf("FAIL\n\n");
+            flint_printf("x = "); arf_print(x); flint_printf("\n\n");
+            flint_printf("y = "); arf_print(y); flint_printf("\n\n");
+            flint_printf("z1 = "); arf_print(z1); flint_printf("\n\n");
+            flint_printf("z2 = "); arf_print(z2); flint_printf("\n\n");
+            flint_abort();
+        }
+
+        arf_clear(x);
+        arf_clear(y);
+        arf_clear(z1);
+        arf_clear(z2);
+    }
+
+    /* cross-thread release */
+    for (iter = 0; iter < 20 * arb_test_multiplier(); iter++)
+    {
+        work_t work;
+        ulong hits, misses, hits2, misses2;
+        slong i, bytes;
+
+        arf_use_limb_cache = 1;
+        flint_set_num_threads(1 + n_randint(state, 4));
+
+        work.len = n_randint(state, 3000);
+        work.v = flint_malloc(sizeof(arf_struct) * work.len);
+
+        arf_limb_cache_stats(&hits, &misses, NULL);
+
+        for (i = 0; i < work.len; i++)
+        {
+            arf_init(work.v + i);
+            arf_randtest(work.v + i, state, 2 + n_randint(state, 40 * FLINT_BITS), 10);
+        }
+
+        flint_parallel_do(clear_worker, &work, work.len, -1, FLINT_PARALLEL_STRIDED);
+
+        arf_limb_cache_stats(&hits2, &misses2, &bytes);
+
+        if (hits2 < hits || misses2 < misses || bytes < 0)
+        {
+            flint_printf("FAIL (stats)\n\n");
+            flint_printf("%wu %wu %wu %wu %wd\n\n", hits, misses, hits2, misses2, bytes);
+            flint_abort();
+        }
+
+        /* reuse whatever came back through the depot */
+        for (i = 0; i < work.len; i++)
+        {
+            arf_init(work.v + i);
+            arf_randtest(work.v + i, state, 2 + n_randint(state, 40 * FLINT_BITS), 10);
+        }
+
+        for (i = 0; i < work.len; i++)
+            arf_clear(work.v + i);
+
+        flint_free(work.v);
+
+        arf_limb_cache_clear();
+        arf_limb_cache_stats(NULL, NULL, &bytes);
+
+        if (bytes != 0)
+        {
+            flint_printf("FAIL (clear)\n\n");
+            flint_printf("%wd\n\n", bytes);
+            flint_abort();
+        }
+    }
+
+    arf_use_limb_cache = 0;
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}
@@ -28,8 +28,24 @@ extern slong TLS_PREFIX bernoulli_cache_num;
 
 extern TLS_PREFIX fmpq * bernoulli_cache;
 
+extern TLS_PREFIX slong bernoulli_cache_generation;
+
+ARB_DLL extern int bernoulli_use_shared_cache;
+ARB_DLL extern slong bernoulli_shared_cache_max_bytes;
+ARB_DLL extern slong bernoulli_shared_generation;
+
 void bernoulli_cache_compute(slong n);
 
+void bernoulli_shared_cache_clear(void);
+
+/* bernoulli_shared_generation is written by other threads */
+#define _BERNOULLI_SHARED_GENERATION() \
+    _ARB_SHARED_LOAD_SI(&bernoulli_shared_generation)
+
+/* true if B_n can be read from bernoulli_cache */
+#define BERNOULLI_IS_CACHED(n) \
+    ((n) < bernoulli_cache_num && bernoulli_cache_generation == _BERNOULLI_SHARED_GENERATION())
+
 /*
 Crude bound for the bits in d(n) = denom(B_n).
 By von Staudt-Clausen, d(n) = prod_{p-1 | n} p
@@ -98,7 +114,7 @@ void bernoulli_fmpq_vec_no_cache(fmpq * res, ulong a, slong num);
 #define BERNOULLI_ENSURE_CACHED(n) \
   do { \
     slong __n = (n); \
-    if (__n >= bernoulli_cache_num) \
+    if (!BERNOULLI_IS_CACHED(__n)) \
         bernoulli_cache_compute(__n + 1); \
   } while (0); \
 
@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2012 Fredrik Johansson
+    Copyright (C) 2012, 2022 Fredrik Johansson
 
     This file is part of Arb.
 
@@ -9,59 +9,289 @@
     (at your option) any later version.  See <http://www.gnu.org/licenses/>.
 */
 
+#include <string.h>
+#include <pthread.h>
 #include "bernoulli.h"
+#include "arb_cache.h"
 
 TLS_PREFIX slong bernoulli_cache_num = 0;
 
 TLS_PREFIX fmpq * bernoulli_cache = NULL;
 
-void
-bernoulli_cleanup(void)
+TLS_PREFIX slong bernoulli_cache_generation = 0;
+
+/*
+  The thread-local array bernoulli_cache is either owned by the thread
+  (own_array set) or is a view of a snapshot of the shared cache.
+  In an owned array, the entries before own_start are shallow copies
+  of entries of the shared cache and the remaining entries are owned.
+*/
+static TLS_PREFIX int bernoulli_cache_own_array = 0;
+static TLS_PREFIX slong bernoulli_cache_own_start = 0;
+static TLS_PREFIX int bernoulli_cleanup_registered = 0;
+
+int bernoulli_use_shared_cache = 0;
+slong bernoulli_shared_cache_max_bytes = 0;
+slong bernoulli_shared_generation = 0;
+
+/*
+  The shared cache is a list of immutable snapshots. A new snapshot
+  takes shallow copies of the entries of the previous one and computes
+  the new entries, so that arrays still being read by other threads
+  remain valid. Replaced snapshot arrays are only freed together with
+  the entries by bernoulli_shared_cache_clear, which is called when the
+  last thread holding a reference to the shared state drops it (see
+  arb/shared_state.c). The generation counter is incremented with a
+  release store so that readers in other threads see the clear.
+*/
+typedef struct _bernoulli_snapshot
+{
+    fmpq * entries;
+    slong num;
+    struct _bernoulli_snapshot * prev;
+}
+bernoulli_snapshot;
+
+static bernoulli_snapshot * shared_head = NULL;
+static pthread_mutex_t shared_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Releases the thread-local table without touching shared entries. */
+static void
+_bernoulli_cache_release(void)
 {
     slong i;
 
-    for (i = 0; i < bernoulli_cache_num; i++)
-        fmpq_clear(bernoulli_cache + i);
+    if (bernoulli_cache_own_array)
+    {
+        for (i = bernoulli_cache_own_start; i < bernoulli_cache_num; i++)
+            fmpq_clear(bernoulli_cache + i);
+
+        flint_free(bernoulli_cache);
+    }
 
-    flint_free(bernoulli_cache);
     bernoulli_cache = NULL;
     bernoulli_cache_num = 0;
+    bernoulli_cache_own_array = 0;
+    bernoulli_cache_own_start = 0;
 }
 
 void
-bernoulli_cache_compute(slong n)
+bernoulli_cleanup(void)
 {
-    slong old_num = bernoulli_cache_num;
+    _bernoulli_cache_release();
+    bernoulli_cleanup_registered = 0;
+}
+
+void
+bernoulli_shared_cache_clear(void)
+{
+    bernoulli_snapshot * s, * prev;
+    slong i;
+
+    pthread_mutex_lock(&shared_lock);
 
-    if (old_num < n)
+    s = shared_head;
+
+    /* the newest snapshot owns all entries */
+    if (s != NULL)
     {
-        slong i, new_num;
+        for (i = 0; i < s->num; i++)
+            fmpq_clear(s->entries + i);
+    }
 
-        if (old_num == 0)
-        {
-            flint_register_cleanup_function(bernoulli_cleanup);
-        }
+    for ( ; s != NULL; s = prev)
+    {
+        prev = s->prev;
+        flint_free(s->entries);
+        flint_free(s);
+    }
 
-        if (n <= 128)
-            new_num = FLINT_MAX(old_num + 32, n);
-        else
-            new_num = FLINT_MAX(old_num + 128, n);
+    /* the shared lock is held, so only readers run concurrently */
+    _ARB_SHARED_STORE_PTR(&shared_head, NULL);
+    _ARB_SHARED_STORE_SI(&bernoulli_shared_generation,
+        bernoulli_shared_generation + 1);
+
+    pthread_mutex_unlock(&shared_lock);
+}
+
+/* Computes entries old_num, ..., new_num - 1 (initialised) of res without
+   modifying the previous entries. */
+static void
+_bernoulli_cache_fill(fmpq * res, slong old_num, slong new_num)
+{
+    slong i;
 
-        bernoulli_cache = flint_realloc(bernoulli_cache, new_num * sizeof(fmpq));
+    /* warm start from the cache file, if loaded */
+    old_num = _arb_cache_bernoulli_load(res, old_num, new_num);
+
+    if (old_num >= new_num)
+        return;
+
+    if (new_num <= 128)
+    {
+        /* todo: use recursion, but only compute new entries */
+        fmpq * tmp = _fmpq_vec_init(new_num);
+        arith_bernoulli_number_vec(tmp, new_num);
         for (i = old_num; i < new_num; i++)
-            fmpq_init(bernoulli_cache + i);
+            fmpq_swap(res + i, tmp + i);
+        _fmpq_vec_clear(tmp, new_num);
+    }
+    else
+    {
+        bernoulli_fmpq_vec_no_cache(res + old_num, old_num, new_num - old_num);
+    }
+}
+
+static slong
+_bernoulli_cache_new_num(slong old_num, slong n)
+{
+    if (n <= 128)
+        return FLINT_MAX(old_num + 32, n);
+    else
+        return FLINT_MAX(old_num + 128, n);
+}
+
+/* Rough estimate of the memory used by B_0, ..., B_{n-1}. */
+static double
+_bernoulli_cache_bytes(slong n)
+{
+    double bits;
 
-        if (new_num <= 128)
+    if (n < 16)
+        return n * sizeof(fmpq);
+
+    /* half the entries are zero; the sizes grow roughly linearly */
+    bits = arith_bernoulli_number_size(n) + bernoulli_denom_size(n);
+
+    return n * (double) sizeof(fmpq) + 0.25 * n * FLINT_MAX(bits, 0) / 8;
+}
+
+/* Extends the owned thread-local table to new_num entries. */
+static void
+_bernoulli_cache_extend_owned(slong new_num)
+{
+    slong i;
+
+    if (!bernoulli_cleanup_registered)
+    {
+        flint_register_cleanup_function(bernoulli_cleanup);
+        bernoulli_cleanup_registered = 1;
+    }
+
+    bernoulli_cache = flint_realloc(bernoulli_cache, new_num * sizeof(fmpq));
+    for (i = bernoulli_cache_num; i < new_num; i++)
+        fmpq_init(bernoulli_cache + i);
+
+    _bernoulli_cache_fill(bernoulli_cache, bernoulli_cache_num, new_num);
+
+    bernoulli_cache_num = new_num;
+}
+
+static void
+_bernoulli_cache_compute_local(slong n)
+{
+    if (!bernoulli_cache_own_array)
+    {
+        _bernoulli_cache_release();
+        bernoulli_cache_own_array = 1;
+    }
+
+    _bernoulli_cache_extend_owned(_bernoulli_cache_new_num(bernoulli_cache_num, n));
+}
+
+static void
+_bernoulli_cache_compute_shared(slong n)
+{
+    bernoulli_snapshot * s, * t;
+    slong old_num, new_num, i;
+
+    /* keeps the shared cache alive until this thread calls flint_cleanup */
+    _arb_shared_state_hold();
+
+    s = _ARB_SHARED_LOAD_PTR(&shared_head);
+
+    if (s == NULL || s->num < n)
+    {
+        if (bernoulli_shared_cache_max_bytes > 0 &&
+            _bernoulli_cache_bytes(n) > bernoulli_shared_cache_max_bytes)
         {
-            /* todo: use recursion, but only compute new entries */
-            arith_bernoulli_number_vec(bernoulli_cache, new_num);
+            /* Too large for the shared cache: extend a thread-private
+               table on top of the shared entries, freed by
+               flint_cleanup. */
+            if (!bernoulli_cache_own_array)
+            {
+                old_num = (s == NULL) ? 0 : s->num;
+                _bernoulli_cache_release();
+                bernoulli_cache = flint_malloc(FLINT_MAX(old_num, 1) * sizeof(fmpq));
+                if (old_num != 0)
+                    memcpy(bernoulli_cache, s->entries, old_num * sizeof(fmpq));
+                bernoulli_cache_num = old_num;
+                bernoulli_cache_own_start = old_num;
+                bernoulli_cache_own_array = 1;
+            }
+
+            _bernoulli_cache_extend_owned(n);
+            return;
         }
-        else
+
+        _arb_shared_state_register(bernoulli_shared_cache_clear);
+
+        pthread_mutex_lock(&shared_lock);
+
+        /* another thread may have published in the meantime */
+        s = shared_head;
+
+        if (s == NULL || s->num < n)
         {
-            bernoulli_fmpq_vec_no_cache(bernoulli_cache + old_num, old_num, new_num - old_num);
+            old_num = (s == NULL) ? 0 : s->num;
+            /* grow geometrically so that the replaced snapshot arrays
+               take up at most a few times the space of the current one */
+            new_num = _bernoulli_cache_new_num(old_num, n);
+            new_num = FLINT_MAX(new_num, old_num + old_num / 4);
+
+            t = flint_malloc(sizeof(bernoulli_snapshot));
+            t->entries = flint_malloc(new_num * sizeof(fmpq));
+            if (old_num != 0)
+                memcpy(t->entries, s->entries, old_num * sizeof(fmpq));
+            for (i = old_num; i < new_num; i++)
+                fmpq_init(t->entries + i);
+
+            _bernoulli_cache_fill(t->entries, old_num, new_num);
+
+            t->num = new_num;
+            t->prev = s;
+
+            _ARB_SHARED_STORE_PTR(&shared_head, t);
+            s = t;
         }
 
-        bernoulli_cache_num = new_num;
+        pthread_mutex_unlock(&shared_lock);
     }
+
+    _bernoulli_cache_release();
+    bernoulli_cache = s->entries;
+    bernoulli_cache_num = s->num;
 }
 
+void
+bernoulli_cache_compute(slong n)
+{
+    slong generation = _BERNOULLI_SHARED_GENERATION();
+
+    /* the shared cache has been cleared; drop references to it */
+    if (bernoulli_cache_generation != generation)
+    {
+        if (!bernoulli_cache_own_array || bernoulli_cache_own_start != 0)
+            _bernoulli_cache_release();
+
+        bernoulli_cache_generation = generation;
+    }
+
+    if (bernoulli_cache_num < n)
+    {
+        if (bernoulli_use_shared_cache)
+            _bernoulli_cache_compute_shared(n);
+        else
+            _bernoulli_cache_compute_local(n);
+    }
+}
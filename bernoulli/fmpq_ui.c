@@ -14,7 +14,8 @@
 void
 _bernoulli_fmpq_ui(fmpz_t num, fmpz_t den, ulong n)
 {
-    if (n < (ulong) bernoulli_cache_num)
+    if (n < (ulong) bernoulli_cache_num &&
+        bernoulli_cache_generation == _BERNOULLI_SHARED_GENERATION())
     {
         fmpz_set(num, fmpq_numref(bernoulli_cache + n));
         fmpz_set(den, fmpq_denref(bernoulli_cache + n));
@@ -0,0 +1,100 @@
+/*
+    Copyright (C) 2022 Fredrik Johansson
+
+    This file is part of Arb.
+
+    Arb is free software: you can redistribute it and/or modify it under
+    the terms of the GNU Lesser General Public License (LGPL) as published
+    by the Free Software Foundation; either version 2.1 of the License, or
+    (at your option) any later version.  See <http://www.gnu.org/licenses/>.
+*/
+
+#include "bernoulli.h"
+
+typedef struct
+{
+    slong * n;
+    int * fail;
+}
+work_t;
+
+static void
+worker(slong i, void * _work)
+{
+    work_t * work = (work_t *) _work;
+    slong n = work->n[i];
+    fmpq_t t;
+
+    BERNOULLI_ENSURE_CACHED(n);
+
+    fmpq_init(t);
+    arith_bernoulli_number(t, n);
+
+    if (!fmpq_equal(t, bernoulli_cache + n))
+        work->fail[i] = 1;
+
+    fmpq_clear(t);
+}
+
+int main()
+{
+    slong iter, i, num;
+    flint_rand_t state;
+
+    flint_printf("shared_cache....");
+    fflush(stdout);
+    flint_randinit(state);
+
+    bernoulli_use_shared_cache = 1;
+
+    for (iter = 0; iter < 100 * arb_test_multiplier(); iter++)
+    {
+        work_t work;
+        slong * n;
+        int * fail;
+
+        flint_set_num_threads(1 + n_randint(state, 8));
+
+        if (n_randint(state, 4) == 0)
+            bernoulli_shared_cache_clear();
+
+        /* sometimes force requests into thread-private tables */
+        if (n_randint(state, 3) == 0)
+            bernoulli_shared_cache_max_bytes = 1 + n_randint(state, 50000);
+        else
+            bernoulli_shared_cache_max_bytes = 0;
+
+        num = 1 + n_randint(state, 32);
+        n = flint_malloc(sizeof(slong) * num);
+        fail = flint_calloc(num, sizeof(int));
+
+        for (i = 0; i < num; i++)
+            n[i] = n_randint(state, 1 + n_randint(state, 1000));
+
+        work.n = n;
+        work.fail = fail;
+
+        flint_parallel_do(worker, &work, num, -1, FLINT_PARALLEL_DYNAMIC);
+
+        for (i = 0; i < num; i++)
+        {
+            if (fail[i])
+            {
+                flint_printf("FAIL\n\n");
+                flint_printf("n = %wd\n\n", n[i]);
+                flint_abort();
+            }
+        }
+
+        flint_free(n);
+        flint_free(fail);
+    }
+
+    bernoulli_use_shared_cache = 0;
+    bernoulli_shared_cache_max_bytes = 0;
+
+    flint_randclear(state);
+    flint_cleanup_master();
+    flint_printf("PASS\n");
+    return EXIT_SUCCESS;
+}